@@ -1,240 +1,1166 @@
-#pragma once
-
-#include <type_traits>
-
-#include "CoreMinimal.h"
-
-
-/**
- * 
- */
-template<typename ObjectType>
-class TOptionalPtr
-{
-#define METHOD_ASSERTS() \
-	static_assert(std::is_base_of<member_type_of_t<FuncType>, std::remove_cv_t<ObjectType>>::value,\
-		"Object type of the used member is not base type of the wrapped object.");\
-	static_assert(!std::is_const<ObjectType>::value || is_const_method<FuncType>::value,\
-		"Cannot call non-const method on const object.");
-
-#define FIELD_ASSERTS() \
-	static_assert(std::is_base_of<member_type_of_t<FieldType>, std::remove_cv_t<ObjectType>>::value,\
-		"Object type of the used member is not base type of the wrapped object.");
-
-template<typename FieldType> 
-using result_of_field_t = std::remove_pointer_t<std::remove_reference_t<std::result_of_t<FieldType(ObjectType*)>>>;
-
-template<typename FuncType, typename... Args>
-using result_of_method_t = std::remove_pointer_t<std::result_of_t<FuncType(ObjectType*, Args...)>>;
-
-//https://stackoverflow.com/questions/30407754/how-to-test-if-a-method-is-const
-template<typename FuncType>
-struct is_const_method;
-
-template<typename FuncObjectType, typename ReturnType, typename... Args>
-struct is_const_method<ReturnType(FuncObjectType::*)(Args...)>{
-	static constexpr bool value = false;
-};
-
-template<typename FuncObjectType, typename ReturnType, typename... Args>
-struct is_const_method<ReturnType(FuncObjectType::*)(Args...) const>{
-	static constexpr bool value = true;
-};
-//END
-
-template<typename MemberType>
-struct member_type_of
-{
-	using type = MemberType;
-};
-
-template<typename FuncObjectType, typename ReturnType, typename... Args>
-struct member_type_of<ReturnType(FuncObjectType::*)(Args...)>
-{
-	using type = FuncObjectType;
-};
-	
-template<typename FuncObjectType, typename ReturnType, typename... Args>
-struct member_type_of<ReturnType(FuncObjectType::*)(Args...) const>
-{
-	using type = FuncObjectType;
-};
-
-template<typename FieldObjectType, typename ReturnType>
-struct member_type_of<ReturnType(FieldObjectType::*)>
-{
-	using type = FieldObjectType;
-};
-
-template<typename MemberType>
-using member_type_of_t = typename member_type_of<MemberType>::type;
-
-public:
-	TOptionalPtr(ObjectType* obj) : m_obj{obj}
-	{
-		static_assert(!std::is_pointer<std::remove_pointer_t<decltype(obj)>>::value,
-			"Argument of the Of function can be only single pointer.");
-	}
-
-	/**  
-	 * @return false if wrapped object is nullptr or not valid, true otherwise  
-	 */
-	bool IsSet() const
-	{
-		return IsValidObj(m_obj);
-	}
-
-	/**
-	 * @brief Applies given member function to the wrapped object and returns result wrapped in TOptionalPtr
-	 * @tparam Args types of arguments provided to the member function (auto-deduced)
-	 * @tparam FuncType type of member function (auto-deduced)
-	 * @tparam ReturnType type of return object (auto-deduced)
-	 * @param func member function to apply on the wrapped object
-	 * @param args arguments provided to the member function
-	 * @return result of the member function wrapped in TOptionalPtr
-	 */
-	template<typename... Args, typename FuncType, typename = std::enable_if_t<std::is_member_function_pointer<FuncType>::value>,
-		typename ReturnType = result_of_method_t<FuncType, Args...>>
-	TOptionalPtr<ReturnType> Map(FuncType&& func, Args&&... args)
-	{
-		METHOD_ASSERTS()
-		
-		return IsSet() ?
-			TOptionalPtr<ReturnType>((m_obj->*func)(std::forward<Args>(args)...)) :
-			TOptionalPtr<ReturnType>(nullptr);
-	}
-
-	/**
-	 * @brief Applies given member field to the wrapped object and returns result wrapped in TOptionalPtr
-	 * @tparam FieldType type of member field (auto-deduced)
-	 * @tparam ReturnType type of return object (auto-deduced)
-	 * @param field member field value of which should be retrieved from the wrapped object
-	 * @return result of the member field wrapped in TOptionalPtr
-	 */
-	template<typename FieldType, typename = std::enable_if_t<std::is_member_object_pointer<FieldType>::value>,
-		typename ReturnType = result_of_field_t<FieldType>>
-	TOptionalPtr<ReturnType> Map(FieldType&& field)
-	{
-		FIELD_ASSERTS()
-		
-		return IsSet() ?
-			TOptionalPtr<ReturnType>(m_obj->*field) :
-			TOptionalPtr<ReturnType>(nullptr);
-	}
-
-	/**
-	 * @param return_obj object to return in case the wrapped one is not valid
-	 * @return wrapped object in case of being valid, return_obj otherwise
-	 */
-	TOptionalPtr<ObjectType> OrElse(ObjectType* return_obj)
-	{
-		return IsSet() ?
-				TOptionalPtr<ObjectType>(m_obj) :
-				TOptionalPtr<ObjectType>(return_obj);
-	}
-
-	/**
-	 * @brief Applies given member function to the wrapped object and returns the result if valid, default_value otherwise
-	 * @tparam Args types of arguments provided to the member function (auto-deduced)
-	 * @tparam FuncType type of member function (auto-deduced)
-	 * @tparam ReturnType type of return object (auto-deduced)
-	 * @param default_value value to return if result from member function is not valid
-	 * @param func member function to apply on the wrapped object
-	 * @param args arguments provided to the member function
-	 * @return result of the member function if valid, default_value otherwise
-	 */
-	template<typename... Args, typename FuncType, typename = std::enable_if_t<std::is_member_function_pointer<FuncType>::value>,
-		typename ReturnType = result_of_method_t<FuncType, Args...>>
-	ReturnType MapToValue(const ReturnType& default_value, FuncType&& func, Args&&... args)
-	{
-		METHOD_ASSERTS()
-		
-		return IsSet() ?
-				(m_obj->*func)(std::forward<Args>(args)...) :
-				default_value;
-	}
-
-	/**
-	 * @brief Applies given member field to the wrapped object and returns the result if valid, default_value otherwise
-	 * @tparam FieldType type of member field (auto-deduced)
-	 * @tparam ReturnType type of return object (auto-deduced)
-	 * @param field member field value of which should be retrieved from the wrapped object
-	 * @return result of the member field if valid, default_value otherwise
-	 */
-	template<typename FieldType, typename = std::enable_if_t<std::is_member_object_pointer<FieldType>::value>,
-		typename ReturnType = result_of_field_t<FieldType>>
-	ReturnType MapToValue(const ReturnType& default_value, FieldType&& field)
-	{
-		FIELD_ASSERTS()
-
-		return IsSet() ?
-				m_obj->*field :
-				default_value;
-	}
-
-	/**
-	 * @brief Applies given static function with the wrapped object as first argument and returns result wrapped in TOptionalPtr
-	 * @tparam Args types of arguments provided to the static function (auto-deduced)
-	 * @tparam FuncType type of static function (auto-deduced)
-	 * @tparam ReturnType type of return object (auto-deduced)
-	 * @param func static function to apply with the wrapped object as first argument
-	 * @param args other arguments provided to the static function, following the wrapped object
-	 * @return result of the static function wrapped in TOptionalPtr
-	 */
-	template<typename... Args, typename FuncType, typename ReturnType = result_of_method_t<FuncType, Args...>>
-	TOptionalPtr<ReturnType> MapStatic(FuncType&& func, Args&&... args)
-	{
-		return IsSet() ?
-				TOptionalPtr<ReturnType>(func(m_obj, std::forward<Args>(args)...)) :
-				TOptionalPtr<ReturnType>(nullptr);
-	}
-
-	/**
-	 * @brief Apply given member function to the wrapped object
-	 * @tparam Args types of arguments provided to the member function (auto-deduced)
-	 * @tparam FuncType type of member function (auto-deduced)
-	 * @param func member function to apply on the wrapped object
-	 * @param args arguments provided to the member function
-	 */
-	template<typename... Args, typename FuncType>
-	void IfPresent(FuncType&& func, Args&&... args)
-	{
-		METHOD_ASSERTS()
-		
-		if (IsSet())
-			(m_obj->*func)(std::forward<Args>(args)...);
-	}
-
-	/**
-	 * @return wrapped object 
-	 */
-	ObjectType* Get()
-	{
-		return m_obj;
-	}
-
-	/**
-	 * @param return_value value to return if wrapped object not valid
-	 * @return wrapped object if valid, return_value otherwise
-	 */
-	ObjectType* GetOrElse(const ObjectType* return_value)
-	{
-		return IsSet() ?
-				m_obj :
-				return_value;
-	}
-
-private:
-	ObjectType* m_obj;
-	
-	template<typename Type = ObjectType/*has to exist to compile on PS4*/, typename = std::enable_if_t<!std::is_base_of<UObject, std::remove_cv_t<Type>>::value>>
-	FORCEINLINE static bool IsValidObj(const Type* obj)
-	{
-		return obj != nullptr;
-	}
-
-	FORCEINLINE static bool IsValidObj(const UObject* obj)
-	{
-		return IsValid(obj);
-	}
-};
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+
+#include "CoreMinimal.h"
+#include "OptionalPtrName.h"
+#include "OptionalPtrSeqLock.h"
+#include "OptionalPtrStats.h"
+#include "Runtime/Launch/Resources/Version.h"
+#include "Templates/Atomic.h"
+
+
+/**
+ * Key of a map lookup with its hash calculated only once, so it can be used for any number of MapFind calls
+ */
+template<typename KeyType>
+class TOptionalPtrHashedKey
+{
+public:
+	explicit TOptionalPtrHashedKey(const KeyType& key) : m_key{key}, m_hash{GetTypeHash(key)} {}
+
+	const KeyType& GetKey() const
+	{
+		return m_key;
+	}
+
+	uint32 GetHash() const
+	{
+		return m_hash;
+	}
+
+private:
+	KeyType m_key;
+	uint32 m_hash;
+};
+
+struct FOptionalPtrDefaultPolicy;
+
+template<typename ObjectType, typename PolicyType = FOptionalPtrDefaultPolicy>
+class TOptionalPtr;
+
+/**
+ * Validity policy of TOptionalPtr, UObjects are checked by IsValid and other objects for nullptr
+ */
+struct FOptionalPtrDefaultPolicy
+{
+	/** Policy of the objects the wrapped one maps to */
+	using NextPolicy = FOptionalPtrDefaultPolicy;
+
+	template<typename Type = UObject/*has to exist to compile on PS4*/, typename = std::enable_if_t<!std::is_base_of<UObject, std::remove_cv_t<Type>>::value>>
+	FORCEINLINE static bool IsValidObj(const Type* obj)
+	{
+		return obj != nullptr;
+	}
+
+	FORCEINLINE static bool IsValidObj(const UObject* obj)
+	{
+		return IsValid(obj);
+	}
+};
+
+/**
+ * Validity policy of objects already validated when resolved from a weak pointer, only nullptr is left to check
+ * @tparam BasePolicy policy of the objects the wrapped one maps to
+ */
+template<typename BasePolicy = FOptionalPtrDefaultPolicy>
+struct TOptionalPtrResolvedPolicy
+{
+	using NextPolicy = BasePolicy;
+
+	FORCEINLINE static bool IsValidObj(const void* obj)
+	{
+		return obj != nullptr;
+	}
+};
+
+/**
+ * Validity policy of chains keeping index of their step, so GetResult can tell which one failed
+ * @tparam BasePolicy policy validating the objects
+ */
+template<typename BasePolicy = FOptionalPtrDefaultPolicy>
+struct TOptionalPtrStepPolicy
+{
+	using NextPolicy = TOptionalPtrStepPolicy<typename BasePolicy::NextPolicy>;
+
+	template<typename Type>
+	FORCEINLINE static bool IsValidObj(const Type* obj)
+	{
+		return BasePolicy::IsValidObj(obj);
+	}
+};
+
+/**
+ * Whether chains of the policy keep index of their step
+ */
+template<typename PolicyType>
+struct TOptionalPtrTracksSteps : std::false_type {};
+
+template<typename BasePolicy>
+struct TOptionalPtrTracksSteps<TOptionalPtrStepPolicy<BasePolicy>> : std::true_type {};
+
+template<typename BasePolicy>
+struct TOptionalPtrTracksSteps<TOptionalPtrResolvedPolicy<BasePolicy>> : TOptionalPtrTracksSteps<BasePolicy> {};
+
+/**
+ * Index of the step which returned the object wrapped by TOptionalPtr, empty unless tracked so other chains stay as big as the pointer
+ */
+template<bool bTracked>
+class TOptionalPtrStep
+{
+public:
+	/** Steps past the maximum are counted as the maximum */
+	static constexpr uint8 MaxStep = 255;
+
+	explicit TOptionalPtrStep(uint8 step) : m_step{step} {}
+
+	uint8 GetStep() const
+	{
+		return m_step;
+	}
+
+	uint8 GetNextStep() const
+	{
+		return m_step < MaxStep ? m_step + 1 : MaxStep;
+	}
+
+private:
+	uint8 m_step;
+};
+
+template<>
+class TOptionalPtrStep<false>
+{
+public:
+	explicit TOptionalPtrStep(uint8) {}
+
+	uint8 GetStep() const
+	{
+		return 0;
+	}
+
+	uint8 GetNextStep() const
+	{
+		return 0;
+	}
+};
+
+/**
+ * Resolves pointer-like types to raw pointers, Map continues through any member returning a type it's specialized for.
+ * Specializations provide ObjectType, bValidated (whether the resolved object is already validated), bBorrowed (whether
+ * the pointer owns the object, so it has to be returned by reference) and Resolve.
+ */
+template<typename PointerType>
+struct TOptionalPtrResolver;
+
+template<typename Type>
+struct TOptionalPtrResolver<Type*>
+{
+	using ObjectType = Type;
+	static constexpr bool bValidated = false;
+	static constexpr bool bBorrowed = false;
+
+	FORCEINLINE static Type* Resolve(Type* ptr)
+	{
+		return ptr;
+	}
+};
+
+#if ENGINE_MAJOR_VERSION >= 5
+//handles of editor builds are resolved lazily and each access is tracked, so the raw pointer is carried forward instead
+template<typename Type>
+struct TOptionalPtrResolver<TObjectPtr<Type>>
+{
+	using ObjectType = Type;
+	static constexpr bool bValidated = false;
+	static constexpr bool bBorrowed = false;
+
+	FORCEINLINE static Type* Resolve(const TObjectPtr<Type>& ptr)
+	{
+		return ptr.Get();
+	}
+};
+#endif
+
+//Get checks the serial number and pending kill, so the result doesn't need IsValid
+template<typename Type, typename WeakPtrBase>
+struct TOptionalPtrResolver<TWeakObjectPtr<Type, WeakPtrBase>>
+{
+	using ObjectType = Type;
+	static constexpr bool bValidated = true;
+	static constexpr bool bBorrowed = false;
+
+	FORCEINLINE static Type* Resolve(const TWeakObjectPtr<Type, WeakPtrBase>& ptr)
+	{
+		return ptr.Get();
+	}
+};
+
+//the pinned pointer is released right away, the object has to be kept alive by its other owners for the rest of the chain
+template<typename Type, ESPMode Mode>
+struct TOptionalPtrResolver<TWeakPtr<Type, Mode>>
+{
+	using ObjectType = Type;
+	static constexpr bool bValidated = true;
+	static constexpr bool bBorrowed = false;
+
+	FORCEINLINE static Type* Resolve(const TWeakPtr<Type, Mode>& ptr)
+	{
+		return ptr.Pin().Get();
+	}
+};
+
+template<typename Type>
+struct TOptionalPtrResolver<std::weak_ptr<Type>>
+{
+	using ObjectType = Type;
+	static constexpr bool bValidated = true;
+	static constexpr bool bBorrowed = false;
+
+	FORCEINLINE static Type* Resolve(const std::weak_ptr<Type>& ptr)
+	{
+		return ptr.lock().get();
+	}
+};
+
+//owning pointers are only borrowed, the object stays owned by the member the chain went through
+template<typename Type, ESPMode Mode>
+struct TOptionalPtrResolver<TSharedPtr<Type, Mode>>
+{
+	using ObjectType = Type;
+	static constexpr bool bValidated = false;
+	static constexpr bool bBorrowed = true;
+
+	FORCEINLINE static Type* Resolve(const TSharedPtr<Type, Mode>& ptr)
+	{
+		return ptr.Get();
+	}
+};
+
+template<typename Type, ESPMode Mode>
+struct TOptionalPtrResolver<TSharedRef<Type, Mode>>
+{
+	using ObjectType = Type;
+	static constexpr bool bValidated = false;
+	static constexpr bool bBorrowed = true;
+
+	FORCEINLINE static Type* Resolve(const TSharedRef<Type, Mode>& ptr)
+	{
+		return &ptr.Get();
+	}
+};
+
+template<typename Type, typename Deleter>
+struct TOptionalPtrResolver<TUniquePtr<Type, Deleter>>
+{
+	using ObjectType = Type;
+	static constexpr bool bValidated = false;
+	static constexpr bool bBorrowed = true;
+
+	FORCEINLINE static Type* Resolve(const TUniquePtr<Type, Deleter>& ptr)
+	{
+		return ptr.Get();
+	}
+};
+
+template<typename Type>
+struct TOptionalPtrResolver<std::shared_ptr<Type>>
+{
+	using ObjectType = Type;
+	static constexpr bool bValidated = false;
+	static constexpr bool bBorrowed = true;
+
+	FORCEINLINE static Type* Resolve(const std::shared_ptr<Type>& ptr)
+	{
+		return ptr.get();
+	}
+};
+
+template<typename Type, typename Deleter>
+struct TOptionalPtrResolver<std::unique_ptr<Type, Deleter>>
+{
+	using ObjectType = Type;
+	static constexpr bool bValidated = false;
+	static constexpr bool bBorrowed = true;
+
+	FORCEINLINE static Type* Resolve(const std::unique_ptr<Type, Deleter>& ptr)
+	{
+		return ptr.get();
+	}
+};
+
+//atomic links are loaded with acquire ordering by Map, Load is used by the Map steps with explicit ordering
+template<typename Type>
+struct TOptionalPtrResolver<std::atomic<Type*>>
+{
+	using ObjectType = Type;
+	static constexpr bool bValidated = false;
+	static constexpr bool bBorrowed = true;
+
+	FORCEINLINE static Type* Resolve(const std::atomic<Type*>& ptr)
+	{
+		return ptr.load(std::memory_order_acquire);
+	}
+
+	FORCEINLINE static Type* Load(const std::atomic<Type*>& ptr, std::memory_order order)
+	{
+		return ptr.load(order);
+	}
+};
+
+//TAtomic loads only relaxed or sequentially consistent, the stronger one stands in for acquire and consume
+template<typename Type>
+struct TOptionalPtrResolver<TAtomic<Type*>>
+{
+	using ObjectType = Type;
+	static constexpr bool bValidated = false;
+	static constexpr bool bBorrowed = true;
+
+	FORCEINLINE static Type* Resolve(const TAtomic<Type*>& ptr)
+	{
+		return ptr.Load();
+	}
+
+	FORCEINLINE static Type* Load(const TAtomic<Type*>& ptr, std::memory_order order)
+	{
+		return ptr.Load(order == std::memory_order_relaxed ? EMemoryOrder::Relaxed : EMemoryOrder::SequentiallyConsistent);
+	}
+};
+
+/**
+ * @brief Resolves the weak pointer once and wraps the result, which is not validated again
+ * @param ptr weak pointer to resolve
+ * @return resolved object wrapped in TOptionalPtr
+ */
+template<typename PointerType, typename Resolver = TOptionalPtrResolver<PointerType>, typename = std::enable_if_t<Resolver::bValidated>>
+TOptionalPtr<typename Resolver::ObjectType, TOptionalPtrResolvedPolicy<>> MakeOptionalPtr(const PointerType& ptr
+	OPTIONAL_PTR_STATS_ONLY(, const FOptionalPtrSourceLocation& location = FOptionalPtrSourceLocation::current()))
+{
+	return TOptionalPtr<typename Resolver::ObjectType, TOptionalPtrResolvedPolicy<>>(Resolver::Resolve(ptr) OPTIONAL_PTR_STATS_ONLY(, location));
+}
+
+/**
+ * @brief Wraps the object for chains started by the helpers built on TOptionalPtr, which OPTIONAL_PTR_STATS doesn't count as call sites
+ * @param obj object the chain starts with
+ * @return object wrapped in TOptionalPtr
+ */
+template<typename ObjectType, typename PolicyType = FOptionalPtrDefaultPolicy>
+FORCEINLINE TOptionalPtr<ObjectType, PolicyType> MakeUncountedOptionalPtr(ObjectType* obj)
+{
+	return TOptionalPtr<ObjectType, PolicyType>(obj, 0 OPTIONAL_PTR_STATS_ONLY(, nullptr));
+}
+
+/**
+ * Result of TOptionalPtr chain returned by GetResult, either the valid object or index of the step the chain failed at.
+ * The failed step is stored in place of the pointer, tagged by its lowest bit, so the result is as big as the pointer.
+ * Objects without the lowest bit free, i.e. aligned to 1 byte, store the failed step in a side field instead.
+ */
+template<typename ObjectType, bool bPacked = (alignof(ObjectType) > 1)>
+class TOptionalResult
+{
+	template<typename, typename>
+	friend class TOptionalPtr;
+
+public:
+	/**
+	 * @return true if the chain succeeded, false otherwise
+	 */
+	bool IsSet() const
+	{
+		return (m_value & FailureTag) == 0;
+	}
+
+	/**
+	 * @return resulting object if the chain succeeded, nullptr otherwise
+	 */
+	ObjectType* Get() const
+	{
+		//all the bits are cleared for failure, none for success
+		return reinterpret_cast<ObjectType*>(m_value & ((m_value & FailureTag) - 1));
+	}
+
+	/**
+	 * @return index of the step which didn't return valid object, 0 for the object the chain started with,
+	 * INDEX_NONE if the chain succeeded
+	 */
+	int32 GetFailedStep() const
+	{
+		return IsSet() ? INDEX_NONE : static_cast<int32>(m_value >> 1);
+	}
+
+private:
+	static constexpr UPTRINT FailureTag = 1;
+
+	UPTRINT m_value;
+
+	explicit TOptionalResult(ObjectType* obj) : m_value{reinterpret_cast<UPTRINT>(obj)} {}
+
+	explicit TOptionalResult(uint8 failed_step) : m_value{static_cast<UPTRINT>(failed_step) << 1 | FailureTag} {}
+};
+
+template<typename ObjectType>
+class TOptionalResult<ObjectType, false>
+{
+	template<typename, typename>
+	friend class TOptionalPtr;
+
+public:
+	bool IsSet() const
+	{
+		return m_failed_step == INDEX_NONE;
+	}
+
+	ObjectType* Get() const
+	{
+		return m_obj;
+	}
+
+	int32 GetFailedStep() const
+	{
+		return m_failed_step;
+	}
+
+private:
+	ObjectType* m_obj;
+	int16 m_failed_step;
+
+	explicit TOptionalResult(ObjectType* obj) : m_obj{obj}, m_failed_step{INDEX_NONE} {}
+
+	explicit TOptionalResult(uint8 failed_step) : m_obj{nullptr}, m_failed_step{failed_step} {}
+};
+
+/**
+ * 
+ */
+template<typename ObjectType, typename PolicyType>
+class TOptionalPtr : private TOptionalPtrStep<OPTIONAL_PTR_STATS || TOptionalPtrTracksSteps<PolicyType>::value>
+{
+	template<typename, typename>
+	friend class TOptionalPtr;
+	template<typename>
+	friend class TOptionalPtrAncestorCache;
+	template<typename Type, typename Policy>
+	friend TOptionalPtr<Type, Policy> MakeUncountedOptionalPtr(Type* obj);
+
+#define METHOD_ASSERTS() \
+	static_assert(std::is_base_of<member_type_of_t<FuncType>, std::remove_cv_t<ObjectType>>::value,\
+		"Object type of the used member is not base type of the wrapped object.");\
+	static_assert(!std::is_const<ObjectType>::value || is_const_method<FuncType>::value,\
+		"Cannot call non-const method on const object.");
+
+#define FIELD_ASSERTS() \
+	static_assert(std::is_base_of<member_type_of_t<FieldType>, std::remove_cv_t<ObjectType>>::value,\
+		"Object type of the used member is not base type of the wrapped object.");
+
+template<typename FieldType> 
+using result_of_field_t = std::remove_pointer_t<std::remove_reference_t<std::result_of_t<FieldType(ObjectType*)>>>;
+
+template<typename FuncType, typename... Args>
+using result_of_method_t = std::remove_pointer_t<std::result_of_t<FuncType(ObjectType*, Args...)>>;
+
+//https://stackoverflow.com/questions/30407754/how-to-test-if-a-method-is-const
+template<typename FuncType>
+struct is_const_method;
+
+template<typename FuncObjectType, typename ReturnType, typename... Args>
+struct is_const_method<ReturnType(FuncObjectType::*)(Args...)>{
+	static constexpr bool value = false;
+};
+
+template<typename FuncObjectType, typename ReturnType, typename... Args>
+struct is_const_method<ReturnType(FuncObjectType::*)(Args...) const>{
+	static constexpr bool value = true;
+};
+//END
+
+template<typename MemberType>
+struct member_type_of
+{
+	using type = MemberType;
+};
+
+template<typename FuncObjectType, typename ReturnType, typename... Args>
+struct member_type_of<ReturnType(FuncObjectType::*)(Args...)>
+{
+	using type = FuncObjectType;
+};
+	
+template<typename FuncObjectType, typename ReturnType, typename... Args>
+struct member_type_of<ReturnType(FuncObjectType::*)(Args...) const>
+{
+	using type = FuncObjectType;
+};
+
+template<typename FieldObjectType, typename ReturnType>
+struct member_type_of<ReturnType(FieldObjectType::*)>
+{
+	using type = FieldObjectType;
+};
+
+template<typename MemberType>
+using member_type_of_t = typename member_type_of<MemberType>::type;
+
+template<typename LinkType, typename = void>
+struct result_of_link
+{
+	using type = result_of_field_t<LinkType>;
+};
+
+template<typename LinkType>
+struct result_of_link<LinkType, std::enable_if_t<std::is_member_function_pointer<LinkType>::value>>
+{
+	using type = result_of_method_t<LinkType>;
+};
+
+template<typename LinkObjectType, typename FuncType, std::enable_if_t<std::is_member_function_pointer<FuncType>::value, int> = 0>
+FORCEINLINE static decltype(auto) InvokeLink(LinkObjectType* obj, FuncType link)
+{
+	return (obj->*link)();
+}
+
+template<typename LinkObjectType, typename FieldType, std::enable_if_t<std::is_member_object_pointer<FieldType>::value, int> = 0>
+FORCEINLINE static decltype(auto) InvokeLink(LinkObjectType* obj, FieldType link)
+{
+	return obj->*link;
+}
+
+//elements of containers of pointers are returned as they are, elements of containers of values by their address
+template<typename ElementType>
+FORCEINLINE static ElementType* ElementPtr(ElementType* element)
+{
+	return element;
+}
+
+template<typename ElementType>
+FORCEINLINE static ElementType* ElementPtr(ElementType& element)
+{
+	return &element;
+}
+
+template<typename ContainerMemberType>
+using result_of_container_t = std::remove_reference_t<decltype(InvokeLink(std::declval<ObjectType*>(), std::declval<ContainerMemberType>()))>;
+
+template<typename ContainerType>
+using result_of_index_t = std::remove_pointer_t<decltype(ElementPtr(std::declval<ContainerType&>()[0]))>;
+
+template<typename ContainerType, typename KeyType>
+using result_of_find_t = std::remove_pointer_t<decltype(ElementPtr(*std::declval<ContainerType&>().Find(std::declval<const KeyType&>())))>;
+
+//objects returned by all operations but the resolving Map are validated by the next policy
+using NextPolicy = typename PolicyType::NextPolicy;
+
+template<typename ResultType>
+using resolver_of_t = TOptionalPtrResolver<std::decay_t<ResultType>>;
+
+//objects resolved from weak pointers are already validated
+template<typename ResultType>
+using policy_of_t = std::conditional_t<resolver_of_t<ResultType>::bValidated,
+	TOptionalPtrResolvedPolicy<NextPolicy>, NextPolicy>;
+
+template<typename FuncType, typename... Args>
+using map_result_of_method_t = std::result_of_t<FuncType(ObjectType*, Args...)>;
+
+template<typename FieldType>
+using map_result_of_field_t = std::result_of_t<FieldType(ObjectType*)>;
+
+template<typename... Types>
+struct are_trivially_copyable : std::true_type {};
+
+template<typename Type, typename... Types>
+struct are_trivially_copyable<Type, Types...> :
+	std::integral_constant<bool, std::is_trivially_copyable<Type>::value && are_trivially_copyable<Types...>::value> {};
+
+//only resolvers of atomic pointers can load with explicit ordering
+template<typename FieldType>
+using atomic_result_of_field_t = std::remove_pointer_t<decltype(resolver_of_t<map_result_of_field_t<FieldType>>::Load(
+	std::declval<map_result_of_field_t<FieldType>>(), std::memory_order_relaxed))>;
+
+//walking a const object has to keep the constness for all the following links
+template<typename LinkType>
+using result_of_link_t = std::conditional_t<std::is_const<ObjectType>::value,
+	const typename result_of_link<LinkType>::type, typename result_of_link<LinkType>::type>;
+
+public:
+	/** Maximum number of links followed by Walk and FindAncestor if not specified otherwise */
+	static constexpr uint32 DefaultMaxWalkDepth = 1024;
+
+	/**
+	 * @param obj object the chain starts with
+	 * @param location call site of the chain, only with OPTIONAL_PTR_STATS (auto-captured)
+	 */
+	TOptionalPtr(ObjectType* obj OPTIONAL_PTR_STATS_ONLY(, const FOptionalPtrSourceLocation& location = FOptionalPtrSourceLocation::current())) :
+		FStep{0}, m_obj{obj} OPTIONAL_PTR_STATS_ONLY(, m_stats{FOptionalPtrStats::StartChain(location)})
+	{
+		static_assert(!std::is_pointer<std::remove_pointer_t<decltype(obj)>>::value,
+			"Argument of the Of function can be only single pointer.");
+	}
+
+	/**
+	 * @brief Resolves the weak pointer once, use MakeOptionalPtr to skip validating the result again
+	 * @param ptr weak pointer to resolve, e.g. TWeakObjectPtr
+	 * @param location call site of the chain, only with OPTIONAL_PTR_STATS (auto-captured)
+	 */
+	template<typename PointerType, typename Resolver = TOptionalPtrResolver<PointerType>,
+		typename = std::enable_if_t<Resolver::bValidated && std::is_convertible<typename Resolver::ObjectType*, ObjectType*>::value>>
+	TOptionalPtr(const PointerType& ptr OPTIONAL_PTR_STATS_ONLY(, const FOptionalPtrSourceLocation& location = FOptionalPtrSourceLocation::current())) :
+		FStep{0}, m_obj{Resolver::Resolve(ptr)} OPTIONAL_PTR_STATS_ONLY(, m_stats{FOptionalPtrStats::StartChain(location)}) {}
+
+	/**  
+	 * @return false if wrapped object is nullptr or not valid, true otherwise  
+	 */
+	bool IsSet() const
+	{
+#if OPTIONAL_PTR_STATS
+		const bool is_set = PolicyType::IsValidObj(m_obj);
+		if (!is_set)
+		{
+			AddFailure();
+		}
+		return is_set;
+#else
+		return PolicyType::IsValidObj(m_obj);
+#endif
+	}
+
+	/**
+	 * @brief Applies given member function to the wrapped object and returns result wrapped in TOptionalPtr.
+	 * Weak pointers returned by the member function are resolved once and not validated again,
+	 * shared and unique pointers returned by reference are borrowed without copying them.
+	 * @tparam Args types of arguments provided to the member function (auto-deduced)
+	 * @tparam FuncType type of member function (auto-deduced)
+	 * @tparam ReturnType type of return object (auto-deduced)
+	 * @param func member function to apply on the wrapped object
+	 * @param args arguments provided to the member function
+	 * @return result of the member function wrapped in TOptionalPtr
+	 */
+	template<typename... Args, typename FuncType, typename = std::enable_if_t<std::is_member_function_pointer<FuncType>::value>,
+		typename ReturnType = typename resolver_of_t<map_result_of_method_t<FuncType, Args...>>::ObjectType,
+		typename ReturnPolicy = policy_of_t<map_result_of_method_t<FuncType, Args...>>>
+	TOptionalPtr<ReturnType, ReturnPolicy> Map(FuncType&& func, Args&&... args)
+	{
+		METHOD_ASSERTS()
+		static_assert(!resolver_of_t<map_result_of_method_t<FuncType, Args...>>::bBorrowed ||
+			std::is_lvalue_reference<map_result_of_method_t<FuncType, Args...>>::value,
+			"Owning pointer has to be returned by reference, the borrowed object could be destroyed with the returned copy otherwise.");
+		
+		return IsSet() ?
+			NextStep<ReturnType, ReturnPolicy>(resolver_of_t<map_result_of_method_t<FuncType, Args...>>::Resolve(
+				(m_obj->*func)(std::forward<Args>(args)...))) :
+			FailedStep<ReturnType, ReturnPolicy>();
+	}
+
+	/**
+	 * @brief Applies given member field to the wrapped object and returns result wrapped in TOptionalPtr.
+	 * Weak pointer fields are resolved once and not validated again, shared and unique pointer fields are borrowed without copying them.
+	 * @tparam FieldType type of member field (auto-deduced)
+	 * @tparam ReturnType type of return object (auto-deduced)
+	 * @param field member field value of which should be retrieved from the wrapped object
+	 * @return result of the member field wrapped in TOptionalPtr
+	 */
+	template<typename FieldType, typename = std::enable_if_t<std::is_member_object_pointer<FieldType>::value>,
+		typename ReturnType = typename resolver_of_t<map_result_of_field_t<FieldType>>::ObjectType,
+		typename ReturnPolicy = policy_of_t<map_result_of_field_t<FieldType>>>
+	TOptionalPtr<ReturnType, ReturnPolicy> Map(FieldType&& field)
+	{
+		FIELD_ASSERTS()
+		
+		return IsSet() ?
+			NextStep<ReturnType, ReturnPolicy>(resolver_of_t<map_result_of_field_t<FieldType>>::Resolve(m_obj->*field)) :
+			FailedStep<ReturnType, ReturnPolicy>();
+	}
+
+	/**
+	 * @brief Loads given atomic pointer field of the wrapped object with acquire ordering, the same as Map does, and returns result
+	 * wrapped in TOptionalPtr. Fields of the loaded object written before the pointer was stored with release ordering are visible.
+	 * @tparam FieldType type of member field, std::atomic or TAtomic of pointer (auto-deduced)
+	 * @tparam ReturnType type of return object (auto-deduced)
+	 * @param field member field to load from the wrapped object
+	 * @return loaded object wrapped in TOptionalPtr
+	 */
+	template<typename FieldType, typename = std::enable_if_t<std::is_member_object_pointer<FieldType>::value>,
+		typename ReturnType = atomic_result_of_field_t<FieldType>>
+	TOptionalPtr<ReturnType, NextPolicy> MapAcquire(FieldType&& field)
+	{
+		FIELD_ASSERTS()
+
+		return MapAtomic<ReturnType>(field, std::memory_order_acquire);
+	}
+
+	/**
+	 * @brief Loads given atomic pointer field of the wrapped object with relaxed ordering and returns result wrapped in TOptionalPtr.
+	 * Only the pointer is guaranteed to be up to date, e.g. for chains comparing the objects without reading them.
+	 * @tparam FieldType type of member field, std::atomic or TAtomic of pointer (auto-deduced)
+	 * @tparam ReturnType type of return object (auto-deduced)
+	 * @param field member field to load from the wrapped object
+	 * @return loaded object wrapped in TOptionalPtr
+	 */
+	template<typename FieldType, typename = std::enable_if_t<std::is_member_object_pointer<FieldType>::value>,
+		typename ReturnType = atomic_result_of_field_t<FieldType>>
+	TOptionalPtr<ReturnType, NextPolicy> MapRelaxed(FieldType&& field)
+	{
+		FIELD_ASSERTS()
+
+		return MapAtomic<ReturnType>(field, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Loads given atomic pointer field of the wrapped object with consume ordering and returns result wrapped in TOptionalPtr.
+	 * Only fields read through the loaded object are guaranteed to be visible, which needs no barrier on weakly ordered CPUs.
+	 * Current compilers implement consume as acquire, so it's never slower than MapAcquire but not faster yet either.
+	 * @tparam FieldType type of member field, std::atomic or TAtomic of pointer (auto-deduced)
+	 * @tparam ReturnType type of return object (auto-deduced)
+	 * @param field member field to load from the wrapped object
+	 * @return loaded object wrapped in TOptionalPtr
+	 */
+	template<typename FieldType, typename = std::enable_if_t<std::is_member_object_pointer<FieldType>::value>,
+		typename ReturnType = atomic_result_of_field_t<FieldType>>
+	TOptionalPtr<ReturnType, NextPolicy> MapConsume(FieldType&& field)
+	{
+		FIELD_ASSERTS()
+
+		return MapAtomic<ReturnType>(field, std::memory_order_consume);
+	}
+
+	/**
+	 * @param return_obj object to return in case the wrapped one is not valid
+	 * @return wrapped object in case of being valid, return_obj otherwise
+	 */
+	TOptionalPtr<ObjectType, NextPolicy> OrElse(ObjectType* return_obj)
+	{
+		return IsSet() ?
+				TOptionalPtr<ObjectType, NextPolicy>(m_obj, this->GetStep() OPTIONAL_PTR_STATS_ONLY(, m_stats)) :
+				TOptionalPtr<ObjectType, NextPolicy>(return_obj, this->GetStep() OPTIONAL_PTR_STATS_ONLY(, m_stats));
+	}
+
+	/**
+	 * @brief Applies given member function to the wrapped object and returns the result if valid, default_value otherwise
+	 * @tparam Args types of arguments provided to the member function (auto-deduced)
+	 * @tparam FuncType type of member function (auto-deduced)
+	 * @tparam ReturnType type of return object (auto-deduced)
+	 * @param default_value value to return if result from member function is not valid
+	 * @param func member function to apply on the wrapped object
+	 * @param args arguments provided to the member function
+	 * @return result of the member function if valid, default_value otherwise
+	 */
+	template<typename... Args, typename FuncType, typename = std::enable_if_t<std::is_member_function_pointer<FuncType>::value>,
+		typename ReturnType = result_of_method_t<FuncType, Args...>>
+	ReturnType MapToValue(const ReturnType& default_value, FuncType&& func, Args&&... args)
+	{
+		METHOD_ASSERTS()
+		
+		return IsSet() ?
+				(m_obj->*func)(std::forward<Args>(args)...) :
+				default_value;
+	}
+
+	/**
+	 * @brief Applies given member field to the wrapped object and returns the result if valid, default_value otherwise
+	 * @tparam FieldType type of member field (auto-deduced)
+	 * @tparam ReturnType type of return object (auto-deduced)
+	 * @param field member field value of which should be retrieved from the wrapped object
+	 * @return result of the member field if valid, default_value otherwise
+	 */
+	template<typename FieldType, typename = std::enable_if_t<std::is_member_object_pointer<FieldType>::value>,
+		typename ReturnType = result_of_field_t<FieldType>>
+	ReturnType MapToValue(const ReturnType& default_value, FieldType&& field)
+	{
+		FIELD_ASSERTS()
+
+		return IsSet() ?
+				m_obj->*field :
+				default_value;
+	}
+
+	/**
+	 * @brief Reads given member fields of the wrapped object consistently, retrying the read if a write of them started meanwhile.
+	 * The writer has to write the fields inside FOptionalPtrSeqLockWriteScope of the lock field.
+	 * @tparam LockType type of member field of FOptionalPtrSeqLock (auto-deduced)
+	 * @tparam FieldTypes types of member fields, trivially copyable (auto-deduced)
+	 * @param seq_lock sequence lock field guarding the fields
+	 * @param fields member fields values of which should be retrieved from the wrapped object
+	 * @return values of the fields in the order of the fields if the wrapped object is valid, unset otherwise
+	 */
+	template<typename LockType, typename... FieldTypes, typename = std::enable_if_t<std::is_member_object_pointer<std::decay_t<LockType>>::value>>
+	TOptional<std::tuple<std::decay_t<map_result_of_field_t<std::decay_t<FieldTypes>>>...>> MapSnapshot(LockType&& seq_lock, FieldTypes&&... fields)
+	{
+		using ValuesType = std::tuple<std::decay_t<map_result_of_field_t<std::decay_t<FieldTypes>>>...>;
+		static_assert(std::is_same<std::decay_t<map_result_of_field_t<std::decay_t<LockType>>>, FOptionalPtrSeqLock>::value,
+			"First member of the snapshot has to be sequence lock.");
+		static_assert(are_trivially_copyable<std::decay_t<map_result_of_field_t<std::decay_t<FieldTypes>>>...>::value,
+			"Fields can be torn while they are copied, so they have to be trivially copyable.");
+
+		if (!IsSet())
+			return TOptional<ValuesType>();
+
+		const FOptionalPtrSeqLock& lock = m_obj->*seq_lock;
+		for (;;)
+		{
+			const uint32 sequence = lock.BeginRead();
+			const ValuesType values{m_obj->*fields...};
+			if (LIKELY(lock.EndRead(sequence)))
+				return TOptional<ValuesType>(values);
+		}
+	}
+
+	/**
+	 * @brief Applies given static function with the wrapped object as first argument and returns result wrapped in TOptionalPtr
+	 * @tparam Args types of arguments provided to the static function (auto-deduced)
+	 * @tparam FuncType type of static function (auto-deduced)
+	 * @tparam ReturnType type of return object (auto-deduced)
+	 * @param func static function to apply with the wrapped object as first argument
+	 * @param args other arguments provided to the static function, following the wrapped object
+	 * @return result of the static function wrapped in TOptionalPtr
+	 */
+	template<typename... Args, typename FuncType, typename ReturnType = result_of_method_t<FuncType, Args...>>
+	TOptionalPtr<ReturnType, NextPolicy> MapStatic(FuncType&& func, Args&&... args)
+	{
+		return IsSet() ?
+				NextStep<ReturnType, NextPolicy>(func(m_obj, std::forward<Args>(args)...)) :
+				FailedStep<ReturnType, NextPolicy>();
+	}
+
+	/**
+	 * @brief Apply given member function to the wrapped object
+	 * @tparam Args types of arguments provided to the member function (auto-deduced)
+	 * @tparam FuncType type of member function (auto-deduced)
+	 * @param func member function to apply on the wrapped object
+	 * @param args arguments provided to the member function
+	 */
+	template<typename... Args, typename FuncType>
+	void IfPresent(FuncType&& func, Args&&... args)
+	{
+		METHOD_ASSERTS()
+		
+		if (IsSet())
+			(m_obj->*func)(std::forward<Args>(args)...);
+	}
+
+	/**
+	 * @brief Records call of given member function on the wrapped object, executed once the buffer is flushed
+	 * @tparam BufferType type of the buffer, e.g. FOptionalPtrCommandBuffer from OptionalPtrCommandBuffer.h (auto-deduced)
+	 * @tparam Args types of arguments provided to the member function (auto-deduced)
+	 * @tparam FuncType type of member function (auto-deduced)
+	 * @param buffer buffer recording the call, the wrapped object is validated again when the buffer is flushed
+	 * @param func member function to apply on the wrapped object
+	 * @param args arguments provided to the member function, copied into the buffer
+	 */
+	template<typename BufferType, typename... Args, typename FuncType>
+	void IfPresentDeferred(BufferType& buffer, FuncType&& func, Args&&... args)
+	{
+		METHOD_ASSERTS()
+
+		if (IsSet())
+			buffer.Add(m_obj, func, std::forward<Args>(args)...);
+	}
+
+	/**
+	 * @brief Retrieves element of the given array member of the wrapped object, checking the index is in bounds
+	 * @tparam MemberType type of member field or member function returning the array by reference (auto-deduced)
+	 * @tparam ReturnType type of the array element, pointed to type for arrays of pointers (auto-deduced)
+	 * @param member member field or member function returning the array, e.g. &UInventory::Items
+	 * @param index index of the element
+	 * @return element of the array (pointer to it for arrays of values) wrapped in TOptionalPtr, empty optional if the index is out of bounds
+	 */
+	template<typename MemberType, typename = std::enable_if_t<std::is_member_pointer<std::decay_t<MemberType>>::value>,
+		typename ReturnType = result_of_index_t<result_of_container_t<std::decay_t<MemberType>>>>
+	TOptionalPtr<ReturnType, NextPolicy> MapAt(MemberType&& member, int32 index)
+	{
+		if (!IsSet())
+			return FailedStep<ReturnType, NextPolicy>();
+
+		decltype(auto) container = InvokeLink(m_obj, member);
+		static_assert(std::is_lvalue_reference<decltype(container)>::value || std::is_pointer<std::decay_t<decltype(container[0])>>::value,
+			"Array of values has to be returned by reference, pointer to its element would be dangling otherwise.");
+
+		return NextStep<ReturnType, NextPolicy>(container.IsValidIndex(index) ? ElementPtr(container[index]) : nullptr);
+	}
+
+	/**
+	 * @brief Finds value with the given key in the map member of the wrapped object
+	 * @tparam MemberType type of member field or member function returning the map by reference (auto-deduced)
+	 * @tparam KeyType type of the key (auto-deduced)
+	 * @tparam ReturnType type of the map value, pointed to type for maps of pointers (auto-deduced)
+	 * @param member member field or member function returning the map, e.g. &UGameDatabase::Entries
+	 * @param key key of the value, hashed on each call
+	 * @return found value (pointer to it for maps of values) wrapped in TOptionalPtr, empty optional if not found
+	 */
+	template<typename MemberType, typename KeyType, typename = std::enable_if_t<std::is_member_pointer<std::decay_t<MemberType>>::value>,
+		typename ReturnType = result_of_find_t<result_of_container_t<std::decay_t<MemberType>>, KeyType>>
+	TOptionalPtr<ReturnType, NextPolicy> MapFind(MemberType&& member, const KeyType& key)
+	{
+		if (!IsSet())
+			return FailedStep<ReturnType, NextPolicy>();
+
+		decltype(auto) container = InvokeLink(m_obj, member);
+		const auto value = container.Find(key);
+		static_assert(std::is_lvalue_reference<decltype(container)>::value || std::is_pointer<std::decay_t<decltype(*value)>>::value,
+			"Map of values has to be returned by reference, pointer to its value would be dangling otherwise.");
+
+		return NextStep<ReturnType, NextPolicy>(value != nullptr ? ElementPtr(*value) : nullptr);
+	}
+
+	/**
+	 * @brief Finds value with the given key in the map member of the wrapped object, reusing the precomputed hash of the key
+	 * @tparam MemberType type of member field or member function returning the map by reference (auto-deduced)
+	 * @tparam KeyType type of the key (auto-deduced)
+	 * @tparam ReturnType type of the map value, pointed to type for maps of pointers (auto-deduced)
+	 * @param member member field or member function returning the map, e.g. &UGameDatabase::Entries
+	 * @param key key of the value with its hash
+	 * @return found value (pointer to it for maps of values) wrapped in TOptionalPtr, empty optional if not found
+	 */
+	template<typename MemberType, typename KeyType, typename = std::enable_if_t<std::is_member_pointer<std::decay_t<MemberType>>::value>,
+		typename ReturnType = result_of_find_t<result_of_container_t<std::decay_t<MemberType>>, KeyType>>
+	TOptionalPtr<ReturnType, NextPolicy> MapFind(MemberType&& member, const TOptionalPtrHashedKey<KeyType>& key)
+	{
+		if (!IsSet())
+			return FailedStep<ReturnType, NextPolicy>();
+
+		decltype(auto) container = InvokeLink(m_obj, member);
+		const auto value = container.FindByHash(key.GetHash(), key.GetKey());
+		static_assert(std::is_lvalue_reference<decltype(container)>::value || std::is_pointer<std::decay_t<decltype(*value)>>::value,
+			"Map of values has to be returned by reference, pointer to its value would be dangling otherwise.");
+
+		return NextStep<ReturnType, NextPolicy>(value != nullptr ? ElementPtr(*value) : nullptr);
+	}
+
+	/**
+	 * @brief Finds value with the literal name key in the map member of the wrapped object, the key costs an integer compare
+	 * @tparam NameHash compile-time hash of the name, e.g. MapFind<"Health"_h>(&UGameDatabase::Entries)
+	 * @tparam MemberType type of member field or member function returning the map keyed by FOptionalPtrName by reference (auto-deduced)
+	 * @tparam ReturnType type of the map value, pointed to type for maps of pointers (auto-deduced)
+	 * @param member member field or member function returning the map, e.g. &UGameDatabase::Entries
+	 * @return found value (pointer to it for maps of values) wrapped in TOptionalPtr, empty optional if not found
+	 */
+	template<uint64 NameHash, typename MemberType, typename = std::enable_if_t<std::is_member_pointer<std::decay_t<MemberType>>::value>,
+		typename ReturnType = result_of_find_t<result_of_container_t<std::decay_t<MemberType>>, FOptionalPtrName>>
+	TOptionalPtr<ReturnType, NextPolicy> MapFind(MemberType&& member)
+	{
+		using ContainerType = decltype(InvokeLink(m_obj, member));
+		using ValueType = std::decay_t<decltype(*std::declval<ContainerType&>().Find(std::declval<const FOptionalPtrName&>()))>;
+		static_assert(std::is_lvalue_reference<ContainerType>::value || std::is_pointer<ValueType>::value,
+			"Map of values has to be returned by reference, pointer to its value would be dangling otherwise.");
+
+		if (!IsSet())
+			return FailedStep<ReturnType, NextPolicy>();
+
+		//name which is not interned can't be a key of any map
+		const FOptionalPtrName key = FOptionalPtrName::FromHash<NameHash>();
+		if (key.IsNone())
+			return NextStep<ReturnType, NextPolicy>(nullptr);
+
+		decltype(auto) container = InvokeLink(m_obj, member);
+		const auto value = container.Find(key);
+		return NextStep<ReturnType, NextPolicy>(value != nullptr ? ElementPtr(*value) : nullptr);
+	}
+
+	/**
+	 * @brief Loads the soft reference returned by given member asynchronously, the chain is continued by the returned future
+	 * @tparam MemberType type of member field or member function returning TSoftObjectPtr or TSoftClassPtr (auto-deduced)
+	 * @tparam LoaderType type of the loader, e.g. TOptionalPtrAsyncLoader<> from OptionalPtrFuture.h (auto-deduced)
+	 * @tparam ReturnType type of the future of the loaded asset (auto-deduced)
+	 * @param member member field or member function returning the soft reference, e.g. &AWeapon::Mesh
+	 * @param loader loader of the asset, has to outlive the chain
+	 * @return future of the loaded asset, ready right away if the asset is already loaded or the wrapped object is not valid
+	 */
+	template<typename MemberType, typename LoaderType, typename = std::enable_if_t<std::is_member_pointer<std::decay_t<MemberType>>::value>,
+		typename ReturnType = decltype(std::declval<LoaderType&>().Load(InvokeLink(std::declval<ObjectType*>(), std::declval<std::decay_t<MemberType>>())))>
+	ReturnType MapAsync(MemberType&& member, LoaderType& loader)
+	{
+		return IsSet() ?
+			loader.Load(InvokeLink(m_obj, member)) :
+			ReturnType(nullptr);
+	}
+
+	/**
+	 * @brief Follows given link from the wrapped object until an object satisfying the predicate is found, validating each hop
+	 * by the policy of the chain. The link is followed only once the predicate rejects the current object, and the next hop
+	 * is prefetched before it's validated.
+	 * @tparam FuncType type of member function or field returning the next object (auto-deduced)
+	 * @tparam PredicateType type of predicate taking pointer to the current object (auto-deduced)
+	 * @tparam ReturnType type of object the link points to (auto-deduced)
+	 * @param link member function or field returning the next object, e.g. &UObject::GetOuter
+	 * @param predicate returns true for the object the walk should stop at
+	 * @param max_depth maximum number of links followed before the walk gives up
+	 * @return first object satisfying the predicate (the wrapped object included) wrapped in TOptionalPtr,
+	 * empty optional if the chain ends with invalid object or max_depth is reached
+	 */
+	template<typename FuncType, typename PredicateType, typename = std::enable_if_t<std::is_member_pointer<std::decay_t<FuncType>>::value>,
+		typename ReturnType = result_of_link_t<std::decay_t<FuncType>>>
+	TOptionalPtr<ReturnType, NextPolicy> Walk(FuncType&& link, PredicateType&& predicate, uint32 max_depth = DefaultMaxWalkDepth)
+	{
+		static_assert(std::is_base_of<member_type_of_t<std::decay_t<FuncType>>, std::remove_cv_t<ReturnType>>::value,
+			"Link has to return object of the same type it is a member of.");
+		static_assert(std::is_convertible<ObjectType*, ReturnType*>::value,
+			"Wrapped object has to be convertible to the type returned by the link.");
+
+		if (!IsSet())
+			return FailedStep<ReturnType, NextPolicy>();
+
+		//hops are returned by the links the same way Map would return them, so they are validated by the next policy
+		ReturnType* current = m_obj;
+		for (uint32 depth = 0; !predicate(current); ++depth)
+		{
+			if (depth == max_depth)
+				return NextStep<ReturnType, NextPolicy>(nullptr);
+
+			current = InvokeLink(current, link);
+			FPlatformMisc::Prefetch(current);
+			if (!NextPolicy::IsValidObj(current))
+				return NextStep<ReturnType, NextPolicy>(nullptr);
+		}
+
+		return NextStep<ReturnType, NextPolicy>(current);
+	}
+
+	/**
+	 * @brief Follows given link from the wrapped object until an object of type AncestorType is found. The wrapped object itself is not considered.
+	 * @tparam AncestorType type of the ancestor to find, has to be UObject or polymorphic type
+	 * @tparam FuncType type of member function or field returning the next object (auto-deduced)
+	 * @param link member function or field returning the next object, e.g. &AActor::GetAttachParentActor
+	 * @param max_depth maximum number of links followed before the search gives up
+	 * @return closest ancestor of type AncestorType wrapped in TOptionalPtr, empty optional if not found
+	 */
+	template<typename AncestorType, typename FuncType, typename = std::enable_if_t<std::is_member_pointer<std::decay_t<FuncType>>::value>,
+		typename ReturnType = std::conditional_t<std::is_const<ObjectType>::value, const AncestorType, AncestorType>>
+	TOptionalPtr<ReturnType, NextPolicy> FindAncestor(FuncType&& link, uint32 max_depth = DefaultMaxWalkDepth)
+	{
+		if (!IsSet())
+			return FailedStep<ReturnType, NextPolicy>();
+		if (max_depth == 0)
+			return NextStep<ReturnType, NextPolicy>(nullptr);
+
+		ReturnType* ancestor = nullptr;
+		//the walk is part of this chain, so it's not counted as a chain of its own
+		MakeUncountedOptionalPtr<result_of_link_t<std::decay_t<FuncType>>, NextPolicy>(InvokeLink(m_obj, link))
+			.Walk(link, [&ancestor](auto* obj)
+			{
+				ancestor = CastObj<ReturnType>(obj);
+				return ancestor != nullptr;
+			}, max_depth - 1);
+
+		return NextStep<ReturnType, NextPolicy>(ancestor);
+	}
+
+	/**
+	 * @brief Finds the closest outer of type AncestorType, the same as GetTypedOuter but validating each outer
+	 * @tparam AncestorType type of the outer to find
+	 * @param max_depth maximum number of outers followed before the search gives up
+	 * @return closest outer of type AncestorType wrapped in TOptionalPtr, empty optional if not found
+	 */
+	template<typename AncestorType, typename Type = ObjectType, typename = std::enable_if_t<std::is_base_of<UObject, std::remove_cv_t<Type>>::value>,
+		typename ReturnType = std::conditional_t<std::is_const<ObjectType>::value, const AncestorType, AncestorType>>
+	TOptionalPtr<ReturnType, NextPolicy> FindAncestor(uint32 max_depth = DefaultMaxWalkDepth)
+	{
+		return FindAncestor<AncestorType>(&UObject::GetOuter, max_depth);
+	}
+
+	/**
+	 * @return wrapped object 
+	 */
+	ObjectType* Get()
+	{
+#if OPTIONAL_PTR_STATS
+		if (!PolicyType::IsValidObj(m_obj))
+		{
+			AddFailure();
+		}
+#endif
+		return m_obj;
+	}
+
+	/**
+	 * @return wrapped object if valid, index of the step which didn't return valid object otherwise
+	 */
+	TOptionalResult<ObjectType> GetResult() const
+	{
+		static_assert(TOptionalPtrTracksSteps<PolicyType>::value, "Only chains started with TOptionalPtrStepPolicy keep index of their step.");
+
+		return IsSet() ?
+			TOptionalResult<ObjectType>(m_obj) :
+			TOptionalResult<ObjectType>(this->GetStep());
+	}
+
+	/**
+	 * @param return_value value to return if wrapped object not valid
+	 * @return wrapped object if valid, return_value otherwise
+	 */
+	ObjectType* GetOrElse(ObjectType* return_value)
+	{
+		return IsSet() ?
+				m_obj :
+				return_value;
+	}
+
+private:
+	//index of the step which returned the wrapped object, failed steps keep it so GetResult can tell which one failed
+	using FStep = TOptionalPtrStep<OPTIONAL_PTR_STATS || TOptionalPtrTracksSteps<PolicyType>::value>;
+
+	ObjectType* m_obj;
+#if OPTIONAL_PTR_STATS
+	//counters of the call site the chain started at, cleared once the failure is counted so it's counted only once
+	mutable FOptionalPtrStatsCounters* m_stats;
+
+	TOptionalPtr(ObjectType* obj, uint8 step, FOptionalPtrStatsCounters* stats) : FStep{step}, m_obj{obj}, m_stats{stats} {}
+
+	FORCEINLINE void AddFailure() const
+	{
+		if (m_stats != nullptr)
+		{
+			m_stats->AddFailure(this->GetStep());
+			m_stats = nullptr;
+		}
+	}
+#else
+	TOptionalPtr(ObjectType* obj, uint8 step) : FStep{step}, m_obj{obj} {}
+#endif
+
+	template<typename ReturnType, typename ReturnPolicy>
+	FORCEINLINE TOptionalPtr<ReturnType, ReturnPolicy> NextStep(ReturnType* obj) const
+	{
+#if OPTIONAL_PTR_STATS
+		if (m_stats != nullptr)
+		{
+			FOptionalPtrStatsCounters::Increment(m_stats->NumSteps);
+		}
+#endif
+		return TOptionalPtr<ReturnType, ReturnPolicy>(obj, this->GetNextStep() OPTIONAL_PTR_STATS_ONLY(, m_stats));
+	}
+
+	template<typename ReturnType, typename ReturnPolicy>
+	FORCEINLINE TOptionalPtr<ReturnType, ReturnPolicy> FailedStep() const
+	{
+		//steps which don't check the object by IsSet, e.g. Walk, fail here
+		OPTIONAL_PTR_STATS_ONLY(AddFailure();)
+		return TOptionalPtr<ReturnType, ReturnPolicy>(nullptr, this->GetStep() OPTIONAL_PTR_STATS_ONLY(, nullptr));
+	}
+
+	template<typename ReturnType, typename FieldType>
+	FORCEINLINE TOptionalPtr<ReturnType, NextPolicy> MapAtomic(FieldType field, std::memory_order order)
+	{
+		return IsSet() ?
+			NextStep<ReturnType, NextPolicy>(resolver_of_t<map_result_of_field_t<FieldType>>::Load(m_obj->*field, order)) :
+			FailedStep<ReturnType, NextPolicy>();
+	}
+	
+	//objects TOptionalPtrAncestorCache walks through, validated the same way as by chains with the default policy
+	template<typename Type>
+	FORCEINLINE static bool IsValidObj(const Type* obj)
+	{
+		return FOptionalPtrDefaultPolicy::IsValidObj(obj);
+	}
+
+	template<typename CastType, typename Type, std::enable_if_t<std::is_base_of<UObject, std::remove_cv_t<Type>>::value, int> = 0>
+	FORCEINLINE static CastType* CastObj(Type* obj)
+	{
+		return Cast<std::remove_cv_t<CastType>>(obj);
+	}
+
+	template<typename CastType, typename Type, std::enable_if_t<!std::is_base_of<UObject, std::remove_cv_t<Type>>::value, int> = 0>
+	FORCEINLINE static CastType* CastObj(Type* obj)
+	{
+		return dynamic_cast<CastType*>(obj);
+	}
+};
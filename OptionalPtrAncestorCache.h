@@ -0,0 +1,377 @@
+#pragma once
+
+#include <type_traits>
+
+#include "CoreMinimal.h"
+#include "OptionalPtr.h"
+
+
+/**
+ * Memoizes TOptionalPtr::FindAncestor queries over a self-referential link (outers, attach parents, ...).
+ * Results are cached per (object, ancestor type) and resolving an object also caches the result for all the objects
+ * walked through on the way (path compression), so repeated lookups amortize to O(1).
+ * The cache doesn't observe the linked objects, Invalidate has to be called for the object whose link changes or which
+ * is destroyed, which invalidates only the entries resolved through it. The invalidated objects are remembered within
+ * the memory budget too, once there are too many of them all the entries are invalidated at once instead.
+ * One cache should always be used with the same link.
+ */
+template<typename NodeType>
+class TOptionalPtrAncestorCache
+{
+	struct FKey
+	{
+		const NodeType* Object;
+		const void* TypeKey;
+
+		bool operator==(const FKey& rhs) const
+		{
+			return Object == rhs.Object && TypeKey == rhs.TypeKey;
+		}
+
+		friend uint32 GetTypeHash(const FKey& key)
+		{
+			return HashCombine(GetTypeHash(key.Object), GetTypeHash(key.TypeKey));
+		}
+	};
+
+	struct FEntry
+	{
+		FKey Key;
+		void* Ancestor;
+		const NodeType* AncestorNode;
+		/** Object the link returned, its entry has to be valid for this one to be, unless bTerminal */
+		const NodeType* Parent;
+		/** Whether the walk stopped at Parent, i.e. it's the ancestor or not valid */
+		bool bTerminal;
+		uint32 Generation;
+		/** Number of the invalidated objects when the entry was added or validated last */
+		uint32 Stamp;
+		int32 Prev;
+		int32 Next;
+	};
+
+	using FOptionalPtrType = TOptionalPtr<NodeType>;
+
+public:
+	/** Approximate number of bytes one cached entry takes including its index */
+	static constexpr SIZE_T BytesPerEntry = sizeof(FEntry) + sizeof(FKey) + sizeof(int32) + 2 * sizeof(void*);
+
+	/** Approximate number of bytes one remembered invalidated object takes */
+	static constexpr SIZE_T BytesPerInvalidation = sizeof(const NodeType*) + sizeof(uint32) + sizeof(int32) + 2 * sizeof(void*);
+
+	/** Part of the memory budget taken by the invalidated objects, an eighth */
+	static constexpr SIZE_T InvalidationBudgetDivisor = 8;
+
+	/** Maximum number of objects a lookup walks through for its result to be cached */
+	static constexpr int32 MaxCompressedPath = 64;
+
+	/**
+	 * @param memory_budget maximum number of bytes the cache can take, least recently used entries are evicted when exceeded
+	 */
+	explicit TOptionalPtrAncestorCache(SIZE_T memory_budget = 1024 * 1024)
+		: m_max_invalidated{FMath::Max<int32>(1, static_cast<int32>(memory_budget / InvalidationBudgetDivisor / BytesPerInvalidation))}
+	{
+		const SIZE_T invalidation_budget = m_max_invalidated * BytesPerInvalidation;
+		m_capacity = FMath::Max<int32>(1, static_cast<int32>((memory_budget - FMath::Min(memory_budget, invalidation_budget)) / BytesPerEntry));
+		m_entries.Reserve(m_capacity);
+		m_invalidated.Reserve(m_max_invalidated);
+	}
+
+	/**
+	 * @brief Finds the closest ancestor of type AncestorType reachable by the link, the object itself is not considered
+	 * @tparam AncestorType type of the ancestor to find, has to be UObject or polymorphic type
+	 * @tparam FuncType type of member function or field returning the next object (auto-deduced)
+	 * @param obj object to start from
+	 * @param link member function or field returning the next object, has to be the same for all lookups
+	 * @param max_depth maximum number of links followed by a lookup which misses the cache
+	 * @return closest ancestor of type AncestorType wrapped in TOptionalPtr, empty optional if not found
+	 */
+	template<typename AncestorType, typename FuncType, typename = std::enable_if_t<std::is_member_pointer<std::decay_t<FuncType>>::value>>
+	TOptionalPtr<AncestorType> FindAncestor(NodeType* obj, FuncType&& link, uint32 max_depth = TOptionalPtr<NodeType>::DefaultMaxWalkDepth)
+	{
+		if (!FOptionalPtrType::IsValidObj(obj))
+			return MakeUncountedOptionalPtr<AncestorType>(nullptr);
+
+		const void* type_key = GetTypeKey<AncestorType>();
+		if (FEntry* entry = FindEntry(FKey{obj, type_key}))
+		{
+			return MakeUncountedOptionalPtr(static_cast<AncestorType*>(entry->Ancestor));
+		}
+
+		NodeType* path[MaxCompressedPath];
+		int32 path_num = 0;
+		AncestorType* ancestor = nullptr;
+		const NodeType* ancestor_node = nullptr;
+		bool resolved = false;
+		bool terminal = true;
+		bool cacheable = true;
+
+		NodeType* current = FOptionalPtrType::InvokeLink(obj, link);
+		for (uint32 depth = 1; depth <= max_depth; ++depth)
+		{
+			if (!FOptionalPtrType::IsValidObj(current) || (ancestor = FOptionalPtrType::template CastObj<AncestorType>(current)) != nullptr)
+			{
+				ancestor_node = ancestor != nullptr ? current : nullptr;
+				resolved = true;
+				break;
+			}
+
+			if (const FEntry* entry = FindEntry(FKey{current, type_key}))
+			{
+				ancestor = static_cast<AncestorType*>(entry->Ancestor);
+				ancestor_node = entry->AncestorNode;
+				resolved = true;
+				terminal = false;
+				break;
+			}
+
+			//entries depend on the entries of the objects after them, so a path too long to cache whole isn't cached at all
+			if (path_num < MaxCompressedPath)
+			{
+				path[path_num++] = current;
+			}
+			else
+			{
+				cacheable = false;
+			}
+			current = FOptionalPtrType::InvokeLink(current, link);
+		}
+
+		//lookup cut by max_depth is not cached, otherwise the result would depend on the object resolved first
+		if (resolved && cacheable)
+		{
+			//each entry depends on the next object on the path, the last one on the object the walk stopped at
+			for (int32 i = path_num - 1; i >= -1; --i)
+			{
+				NodeType* const node = i >= 0 ? path[i] : obj;
+				const bool last = i == path_num - 1;
+				AddEntry(FEntry{FKey{node, type_key}, ancestor, ancestor_node, last ? current : path[i + 1], last && terminal});
+			}
+		}
+
+		return MakeUncountedOptionalPtr(ancestor);
+	}
+
+	/**
+	 * @brief Finds the closest outer of type AncestorType
+	 * @tparam AncestorType type of the outer to find
+	 * @param obj object to start from
+	 * @return closest outer of type AncestorType wrapped in TOptionalPtr, empty optional if not found
+	 */
+	template<typename AncestorType, typename Type = NodeType, typename = std::enable_if_t<std::is_same<UObject, Type>::value>>
+	TOptionalPtr<AncestorType> FindAncestor(NodeType* obj)
+	{
+		return FindAncestor<AncestorType>(obj, &UObject::GetOuter);
+	}
+
+	/**
+	 * @brief Invalidates the cached entries resolved through the object, has to be called whenever its link changes or it's destroyed.
+	 * The entries are revalidated lazily, each by checking the entries of the objects on its path once. When more objects
+	 * than fit into the memory budget are invalidated, all the entries are invalidated instead.
+	 * @param obj object whose link changed or which was destroyed
+	 */
+	void Invalidate(const NodeType* obj)
+	{
+		if (m_invalidated.Num() >= m_max_invalidated && !m_invalidated.Contains(obj))
+		{
+			Invalidate();
+			return;
+		}
+
+		m_invalidated.Add(obj, TakeStamp());
+	}
+
+	/**
+	 * @brief Invalidates all the cached entries, e.g. when many links change at once
+	 */
+	void Invalidate()
+	{
+		++m_generation;
+		m_invalidated.Reset();
+		//entries validated before are of the previous generation, they must not be skipped as validated
+		TakeStamp();
+	}
+
+	/**
+	 * @brief Removes all the cached entries
+	 */
+	void Empty()
+	{
+		m_entries.Reset();
+		m_index.Reset();
+		m_invalidated.Reset();
+		m_head = INDEX_NONE;
+		m_tail = INDEX_NONE;
+	}
+
+	/**
+	 * @return number of cached entries, including the invalidated ones not overwritten yet
+	 */
+	int32 Num() const
+	{
+		return m_entries.Num();
+	}
+
+	/**
+	 * @return maximum number of cached entries fitting into the memory budget
+	 */
+	int32 GetCapacity() const
+	{
+		return m_capacity;
+	}
+
+	/**
+	 * @return maximum number of invalidated objects remembered before all the entries are invalidated at once
+	 */
+	int32 GetInvalidatedCapacity() const
+	{
+		return m_max_invalidated;
+	}
+
+private:
+	TArray<FEntry> m_entries;
+	TMap<FKey, int32> m_index;
+	int32 m_capacity;
+	int32 m_head = INDEX_NONE;
+	int32 m_tail = INDEX_NONE;
+	uint32 m_generation = 0;
+	//objects invalidated since the last Invalidate of all the entries, by the stamp of their invalidation
+	TMap<const NodeType*, uint32> m_invalidated;
+	int32 m_max_invalidated;
+	uint32 m_stamp = 0;
+	//whether any entry was stamped with the current stamp, otherwise the next invalidation can reuse it
+	bool m_stamp_used = false;
+
+	uint32 TakeStamp()
+	{
+		//objects invalidated between lookups share the stamp, nothing was validated since it was taken
+		if (m_stamp_used)
+		{
+			++m_stamp;
+			m_stamp_used = false;
+		}
+		return m_stamp;
+	}
+
+	FEntry* FindEntry(const FKey& key)
+	{
+		const int32* index = m_index.Find(key);
+		if (index == nullptr)
+			return nullptr;
+
+		FEntry& entry = m_entries[*index];
+		if (!IsValidEntry(entry))
+			return nullptr;
+
+		Unlink(*index);
+		LinkAsHead(*index);
+		return &entry;
+	}
+
+	bool IsValidEntry(FEntry& entry)
+	{
+		//entries are stamped once validated, so only the first lookup after an invalidation checks the path
+		for (FEntry* current = &entry; current->Stamp != m_stamp; )
+		{
+			if (current->Generation != m_generation || IsInvalidatedSince(current->Key.Object, current->Stamp) ||
+				IsInvalidatedSince(current->AncestorNode, current->Stamp))
+				return false;
+			if (current->bTerminal)
+				break;
+
+			current = FindParentEntry(*current);
+			if (current == nullptr)
+				return false;
+		}
+
+		//the whole path is valid, stamping all of it spares the lookups sharing the path from checking it again
+		for (FEntry* current = &entry; current != nullptr && current->Stamp != m_stamp; )
+		{
+			current->Stamp = m_stamp;
+			current = current->bTerminal ? nullptr : FindParentEntry(*current);
+		}
+		m_stamp_used = true;
+		return true;
+	}
+
+	FEntry* FindParentEntry(const FEntry& entry)
+	{
+		const int32* parent_index = m_index.Find(FKey{entry.Parent, entry.Key.TypeKey});
+		return parent_index != nullptr ? &m_entries[*parent_index] : nullptr;
+	}
+
+	bool IsInvalidatedSince(const NodeType* obj, uint32 stamp) const
+	{
+		const uint32* invalidated = obj != nullptr ? m_invalidated.Find(obj) : nullptr;
+		return invalidated != nullptr && *invalidated > stamp;
+	}
+
+	void AddEntry(FEntry&& new_entry)
+	{
+		const FKey& key = new_entry.Key;
+		int32 index;
+		if (const int32* existing_index = m_index.Find(key))
+		{
+			index = *existing_index;
+			Unlink(index);
+		}
+		else if (m_entries.Num() < m_capacity)
+		{
+			index = m_entries.AddUninitialized(1);
+			m_index.Add(key, index);
+		}
+		else
+		{
+			index = m_tail;
+			Unlink(index);
+			m_index.Remove(m_entries[index].Key);
+			m_index.Add(key, index);
+		}
+
+		new_entry.Generation = m_generation;
+		new_entry.Stamp = m_stamp;
+		m_stamp_used = true;
+		m_entries[index] = new_entry;
+		LinkAsHead(index);
+	}
+
+	void Unlink(int32 index)
+	{
+		FEntry& entry = m_entries[index];
+		if (entry.Prev != INDEX_NONE)
+			m_entries[entry.Prev].Next = entry.Next;
+		else
+			m_head = entry.Next;
+
+		if (entry.Next != INDEX_NONE)
+			m_entries[entry.Next].Prev = entry.Prev;
+		else
+			m_tail = entry.Prev;
+	}
+
+	void LinkAsHead(int32 index)
+	{
+		FEntry& entry = m_entries[index];
+		entry.Prev = INDEX_NONE;
+		entry.Next = m_head;
+		if (m_head != INDEX_NONE)
+			m_entries[m_head].Prev = index;
+		m_head = index;
+		if (m_tail == INDEX_NONE)
+			m_tail = index;
+	}
+
+	template<typename Type, std::enable_if_t<std::is_base_of<UObject, Type>::value, int> = 0>
+	FORCEINLINE static const void* GetTypeKey()
+	{
+		return Type::StaticClass();
+	}
+
+	//has to be unique per type, address of a static is enough for non-UObjects
+	template<typename Type, std::enable_if_t<!std::is_base_of<UObject, Type>::value, int> = 0>
+	FORCEINLINE static const void* GetTypeKey()
+	{
+		static const uint8 type_key = 0;
+		return &type_key;
+	}
+};
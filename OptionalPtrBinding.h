@@ -0,0 +1,225 @@
+#pragma once
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "CoreMinimal.h"
+#include "OptionalPtr.h"
+#include "OptionalPtrTry.h"
+
+
+/**
+ * Version of the links of the object, opted into by TOptionalPtrBinding to reuse the hop from the object while the
+ * version stays the same. Objects opt in by exposing uint32 GetOptionalPtrVersion() const, which has to change
+ * whenever any of the links of the object change, or by specializing this struct.
+ * @tparam ObjectType type of the object
+ */
+template<typename ObjectType, typename = void>
+struct TOptionalPtrVersion
+{
+	static constexpr bool bVersioned = false;
+
+	static uint32 GetVersion(const ObjectType* /*obj*/)
+	{
+		return 0;
+	}
+};
+
+template<typename ObjectType>
+struct TOptionalPtrVersion<ObjectType, decltype(void(std::declval<const ObjectType&>().GetOptionalPtrVersion()))>
+{
+	static constexpr bool bVersioned = true;
+
+	static uint32 GetVersion(const ObjectType* obj)
+	{
+		return obj->GetOptionalPtrVersion();
+	}
+};
+
+/**
+ * Chain of links from the root object which remembers the object reached by each hop, created by MakeOptionalPtrBinding.
+ * Update follows the chain again only from the first hop from an object which isn't versioned or whose version
+ * changed, and notifies the subscribers only if the resulting object changed. Objects reached by the reused hops are
+ * only validated, so unversioned objects can't be deleted before their parent changes its version.
+ * @tparam RootType type of the object the chain starts from
+ * @tparam LinkTypes types of member functions without parameters or member fields of the hops
+ */
+template<typename RootType, typename... LinkTypes>
+class TOptionalPtrBinding
+{
+	template<size_t Index, typename = void>
+	struct THop
+	{
+		using ObjectType = RootType;
+	};
+
+	template<size_t Index>
+	struct THop<Index, std::enable_if_t<(Index > 0)>>
+	{
+		using ObjectType = std::remove_pointer_t<decltype(GetValidOptionalPtr(std::declval<TOptionalPtr<typename THop<Index - 1>::ObjectType>>()
+			.Map(std::declval<std::tuple_element_t<Index - 1, std::tuple<LinkTypes...>>>())))>;
+	};
+
+	static constexpr size_t NumHops = sizeof...(LinkTypes);
+	static_assert(NumHops > 0, "Binding needs at least one link.");
+
+public:
+	using ResultType = typename THop<NumHops>::ObjectType;
+	using FSubscriber = TFunction<void(TOptionalPtr<ResultType>)>;
+
+	/**
+	 * @param root object the chain starts from
+	 * @param links member functions or fields of the hops
+	 */
+	TOptionalPtrBinding(RootType* root, LinkTypes... links) : m_links{links...}
+	{
+		m_objects[0] = const_cast<std::remove_cv_t<RootType>*>(root);
+	}
+
+	/**
+	 * @brief Follows the hops whose objects changed and notifies the subscribers if the resulting object changed
+	 * @return true if the resulting object changed, false otherwise
+	 */
+	bool Update()
+	{
+		void* const previous = m_objects[NumHops];
+		UpdateHop(std::integral_constant<size_t, 0>(), m_evaluated);
+		const bool changed = !m_evaluated || previous != m_objects[NumHops];
+		m_evaluated = true;
+		if (changed)
+		{
+			//subscribers can't be added or removed while notified, the array isn't reallocated under the running one
+			m_notifying = true;
+			for (int32 i = 0; i < m_subscribers.Num(); ++i)
+			{
+				if (m_subscribers[i])
+					m_subscribers[i](Get());
+			}
+			m_notifying = false;
+		}
+		return changed;
+	}
+
+	/**
+	 * @brief Changes the object the chain starts from, the next Update follows all the hops
+	 * @param root object the chain starts from
+	 */
+	void SetRoot(RootType* root)
+	{
+		m_objects[0] = const_cast<std::remove_cv_t<RootType>*>(root);
+		m_evaluated = false;
+	}
+
+	/**
+	 * @return object at the end of the chain as of the last Update wrapped in TOptionalPtr
+	 */
+	TOptionalPtr<ResultType> Get() const
+	{
+		return MakeUncountedOptionalPtr(static_cast<ResultType*>(m_objects[NumHops]));
+	}
+
+	/**
+	 * @param subscriber callable receiving the resulting object whenever it changes, can't subscribe or unsubscribe
+	 * @return handle of the subscriber for Unsubscribe, handles of the unsubscribed subscribers are reused
+	 */
+	int32 Subscribe(FSubscriber subscriber)
+	{
+		checkf(!m_notifying, TEXT("Binding can't be subscribed to by its subscriber."));
+		if (m_free_subscribers.Num() > 0)
+		{
+			const int32 handle = m_free_subscribers.Pop();
+			m_subscribers[handle] = MoveTemp(subscriber);
+			return handle;
+		}
+		return m_subscribers.Add(MoveTemp(subscriber));
+	}
+
+	/**
+	 * @param handle handle returned by Subscribe, the subscriber can be unsubscribed only once
+	 */
+	void Unsubscribe(int32 handle)
+	{
+		checkf(!m_notifying, TEXT("Binding can't be unsubscribed from by its subscriber."));
+		checkf(m_subscribers.IsValidIndex(handle) && m_subscribers[handle], TEXT("Subscriber is not subscribed."));
+		m_subscribers[handle] = nullptr;
+		m_free_subscribers.Add(handle);
+	}
+
+	/**
+	 * @return number of hops followed by the last Update, the rest were reused
+	 */
+	int32 GetNumFollowedHops() const
+	{
+		return m_num_followed_hops;
+	}
+
+private:
+	std::tuple<LinkTypes...> m_links;
+	//object reached by each hop, the root first
+	void* m_objects[NumHops + 1] = {};
+	//version of the object each hop started from when it was followed
+	uint32 m_versions[NumHops] = {};
+	bool m_evaluated = false;
+	int32 m_num_followed_hops = 0;
+	TArray<FSubscriber> m_subscribers;
+	//handles of the unsubscribed subscribers, their slots are reused by the next subscribers
+	TArray<int32> m_free_subscribers;
+	bool m_notifying = false;
+
+	FORCEINLINE void UpdateHop(std::integral_constant<size_t, NumHops>, bool /*reuse*/)
+	{
+	}
+
+	template<size_t Index>
+	FORCEINLINE void UpdateHop(std::integral_constant<size_t, Index>, bool reuse)
+	{
+		using ObjectType = typename THop<Index>::ObjectType;
+		using VersionType = TOptionalPtrVersion<std::remove_cv_t<ObjectType>>;
+		using NextType = typename THop<Index + 1>::ObjectType;
+
+		if (Index == 0)
+		{
+			m_num_followed_hops = 0;
+		}
+
+		ObjectType* const obj = static_cast<ObjectType*>(m_objects[Index]);
+		void* const recorded_next = m_objects[Index + 1];
+		//pending kill object keeps its version, so it has to be validated before its hop is reused
+		if (reuse && VersionType::bVersioned && FOptionalPtrDefaultPolicy::IsValidObj(obj) && VersionType::GetVersion(obj) == m_versions[Index])
+		{
+			if (recorded_next != nullptr && !MakeUncountedOptionalPtr(static_cast<NextType*>(recorded_next)).IsSet())
+			{
+				m_objects[Index + 1] = nullptr;
+				reuse = false;
+			}
+		}
+		else
+		{
+			++m_num_followed_hops;
+			if (obj != nullptr)
+			{
+				m_versions[Index] = VersionType::GetVersion(obj);
+			}
+			//Map takes the link by value category, so it gets a copy of the stored one
+			auto link = std::get<Index>(m_links);
+			m_objects[Index + 1] = const_cast<std::remove_cv_t<NextType>*>(GetValidOptionalPtr(MakeUncountedOptionalPtr(obj).Map(MoveTemp(link))));
+			reuse = reuse && m_objects[Index + 1] == recorded_next;
+		}
+		UpdateHop(std::integral_constant<size_t, Index + 1>(), reuse);
+	}
+};
+
+/**
+ * @brief Creates binding of the chain of links from the root object
+ * @tparam RootType type of the object the chain starts from (auto-deduced)
+ * @tparam LinkTypes types of member functions without parameters or member fields of the hops (auto-deduced)
+ * @param root object the chain starts from
+ * @param links member functions or fields of the hops, e.g. &AActor::GetOwner
+ * @return binding which has to be updated to evaluate the chain
+ */
+template<typename RootType, typename... LinkTypes>
+TOptionalPtrBinding<RootType, LinkTypes...> MakeOptionalPtrBinding(RootType* root, LinkTypes... links)
+{
+	return TOptionalPtrBinding<RootType, LinkTypes...>(root, links...);
+}
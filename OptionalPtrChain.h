@@ -0,0 +1,487 @@
+#pragma once
+
+#include <type_traits>
+
+#include "CoreMinimal.h"
+#include "OptionalPtr.h"
+
+//computed goto is a GCC extension supported by Clang too, other compilers fall back to switch dispatch
+#ifndef OPTIONAL_PTR_CHAIN_THREADED_DISPATCH
+	#if defined(__GNUC__) || defined(__clang__)
+		#define OPTIONAL_PTR_CHAIN_THREADED_DISPATCH 1
+	#else
+		#define OPTIONAL_PTR_CHAIN_THREADED_DISPATCH 0
+	#endif
+#endif
+
+
+/**
+ * Operations of the chain bytecode. The operations moving to the next object validate it as well, so a chain needs
+ * only one dispatch per hop, the validations are used on their own only for the root.
+ */
+enum class EOptionalPtrChainOp : uint8
+{
+	/** Loads the pointer stored at Offset of the current object */
+	LoadField,
+	/** Calls the getter stored in Operand through Thunk */
+	CallGetter,
+	/** Jumps to Exit with no result if the current object is null */
+	ValidateNull,
+	/** Jumps to Exit with no result if the current object is not valid UObject */
+	ValidateUObject,
+	/** Casts the current object through Thunk */
+	Cast,
+	/** Loads the element at Offset of the container stored in Operand through Thunk */
+	Index,
+	/** Replaces missing result by Pointer */
+	Default,
+	/** Returns the current object */
+	Return
+};
+
+struct FOptionalPtrChainInstruction
+{
+	EOptionalPtrChainOp Op;
+	/** Whether the resulting object is validated as UObject, otherwise it's only checked for null */
+	bool bValidateUObject = false;
+	/** Offset of the loaded field or index of the accessed element */
+	int32 Offset = 0;
+	/** Offset of the UObject base of the resulting object, UObject doesn't have to be the first base */
+	int32 UObjectOffset = 0;
+	/** Instruction to continue at when the validation fails */
+	int32 Exit = 0;
+	void* (*Thunk)(void* obj, const FOptionalPtrChainInstruction& instruction) = nullptr;
+	UPTRINT Pointer = 0;
+	/** Member pointer the thunk is called with, big enough for member function pointers with multiple inheritance */
+	alignas(void*) uint8 Operand[2 * sizeof(void*)];
+};
+
+/**
+ * Chain compiled into a compact bytecode executed by a threaded interpreter, so a chain known only at run-time
+ * doesn't need an indirect call through TFunction per hop. Usually built by TOptionalPtrChainBuilder,
+ * executing it doesn't allocate.
+ */
+class FOptionalPtrChain
+{
+public:
+	/**
+	 * @brief Executes the chain
+	 * @param root object the chain starts from
+	 * @return object at the end of the chain, nullptr if any hop on the way is not valid and no default is set
+	 */
+	void* Execute(void* root) const
+	{
+		const FOptionalPtrChainInstruction* instructions = m_instructions.GetData();
+		const FOptionalPtrChainInstruction* pc = instructions;
+		void* current = root;
+
+#if OPTIONAL_PTR_CHAIN_THREADED_DISPATCH
+		//has to match the order of EOptionalPtrChainOp
+		static void* const dispatch_table[] = {
+			&&op_load_field, &&op_call_getter, &&op_validate_null, &&op_validate_uobject,
+			&&op_cast, &&op_index, &&op_default, &&op_return
+		};
+	#define OPTIONAL_PTR_CHAIN_DISPATCH() goto *dispatch_table[static_cast<uint8>(pc->Op)]
+	#define OPTIONAL_PTR_CHAIN_OP(Label, Op) Label:
+		OPTIONAL_PTR_CHAIN_DISPATCH();
+#else
+	#define OPTIONAL_PTR_CHAIN_DISPATCH() goto dispatch
+	#define OPTIONAL_PTR_CHAIN_OP(Label, Op) case EOptionalPtrChainOp::Op:
+	dispatch:
+		switch (pc->Op)
+		{
+#endif
+	#define OPTIONAL_PTR_CHAIN_VALIDATE(ValidateUObject) \
+		if (current == nullptr || ((ValidateUObject) && !IsValid(reinterpret_cast<const UObject*>(static_cast<uint8*>(current) + pc->UObjectOffset)))) \
+		{ \
+			current = nullptr; \
+			pc = instructions + pc->Exit; \
+		} \
+		else \
+		{ \
+			++pc; \
+		} \
+		OPTIONAL_PTR_CHAIN_DISPATCH();
+
+		OPTIONAL_PTR_CHAIN_OP(op_load_field, LoadField)
+			current = *reinterpret_cast<void**>(static_cast<uint8*>(current) + pc->Offset);
+			OPTIONAL_PTR_CHAIN_VALIDATE(pc->bValidateUObject)
+
+		OPTIONAL_PTR_CHAIN_OP(op_call_getter, CallGetter)
+			current = pc->Thunk(current, *pc);
+			OPTIONAL_PTR_CHAIN_VALIDATE(pc->bValidateUObject)
+
+		OPTIONAL_PTR_CHAIN_OP(op_validate_null, ValidateNull)
+			OPTIONAL_PTR_CHAIN_VALIDATE(false)
+
+		OPTIONAL_PTR_CHAIN_OP(op_validate_uobject, ValidateUObject)
+			OPTIONAL_PTR_CHAIN_VALIDATE(true)
+
+		OPTIONAL_PTR_CHAIN_OP(op_cast, Cast)
+			current = pc->Thunk(current, *pc);
+			OPTIONAL_PTR_CHAIN_VALIDATE(pc->bValidateUObject)
+
+		OPTIONAL_PTR_CHAIN_OP(op_index, Index)
+			current = pc->Thunk(current, *pc);
+			OPTIONAL_PTR_CHAIN_VALIDATE(pc->bValidateUObject)
+
+		OPTIONAL_PTR_CHAIN_OP(op_default, Default)
+			if (current == nullptr)
+			{
+				current = reinterpret_cast<void*>(pc->Pointer);
+			}
+			++pc;
+			OPTIONAL_PTR_CHAIN_DISPATCH();
+
+		OPTIONAL_PTR_CHAIN_OP(op_return, Return)
+			return current;
+
+#if !OPTIONAL_PTR_CHAIN_THREADED_DISPATCH
+		}
+		return current;
+#endif
+	#undef OPTIONAL_PTR_CHAIN_DISPATCH
+	#undef OPTIONAL_PTR_CHAIN_OP
+	#undef OPTIONAL_PTR_CHAIN_VALIDATE
+	}
+
+	/**
+	 * @brief Appends the instruction, its validation jumps to the first Default or Return once Finish is called
+	 * @param instruction instruction to append
+	 */
+	void Emit(const FOptionalPtrChainInstruction& instruction)
+	{
+		m_instructions.Add(instruction);
+	}
+
+	/**
+	 * @brief Appends Return, optionally preceded by Default, and resolves the jumps of the validations
+	 * @param default_value object returned when any hop is not valid, nullptr for none
+	 */
+	void Finish(void* default_value = nullptr)
+	{
+		const int32 exit_index = m_instructions.Num();
+		if (default_value != nullptr)
+		{
+			FOptionalPtrChainInstruction instruction;
+			instruction.Op = EOptionalPtrChainOp::Default;
+			instruction.Pointer = reinterpret_cast<UPTRINT>(default_value);
+			m_instructions.Add(instruction);
+		}
+
+		FOptionalPtrChainInstruction instruction;
+		instruction.Op = EOptionalPtrChainOp::Return;
+		m_instructions.Add(instruction);
+
+		for (int32 i = 0; i < exit_index; ++i)
+		{
+			m_instructions[i].Exit = exit_index;
+		}
+	}
+
+	/**
+	 * @return number of instructions
+	 */
+	int32 Num() const
+	{
+		return m_instructions.Num();
+	}
+
+	/**
+	 * @param index index of the instruction
+	 * @return instruction at the index
+	 */
+	const FOptionalPtrChainInstruction& operator[](int32 index) const
+	{
+		return m_instructions[index];
+	}
+
+private:
+	TArray<FOptionalPtrChainInstruction> m_instructions;
+};
+
+/**
+ * Compiled chain starting with RootType and ending with ResultType, built by TOptionalPtrChainBuilder
+ */
+template<typename RootType, typename ResultType>
+class TOptionalPtrChain
+{
+public:
+	explicit TOptionalPtrChain(FOptionalPtrChain&& chain) : m_chain{MoveTemp(chain)} {}
+
+	/**
+	 * @brief Executes the chain
+	 * @param root object the chain starts from
+	 * @return object at the end of the chain wrapped in TOptionalPtr, empty optional if any hop on the way is not valid
+	 */
+	FORCEINLINE TOptionalPtr<ResultType> Execute(RootType* root) const
+	{
+		return MakeUncountedOptionalPtr(static_cast<ResultType*>(m_chain.Execute(const_cast<std::remove_cv_t<RootType>*>(root))));
+	}
+
+	/**
+	 * @return untyped bytecode of the chain
+	 */
+	const FOptionalPtrChain& GetBytecode() const
+	{
+		return m_chain;
+	}
+
+private:
+	FOptionalPtrChain m_chain;
+};
+
+/**
+ * Builds TOptionalPtrChain from the same member functions and fields Map accepts. Each step validates the object
+ * it returns, the same way Map does. Only getters without parameters are supported. Pointer-like members supported by
+ * TOptionalPtrResolver, e.g. TObjectPtr, are resolved once per step. Each step copies the instructions added so far,
+ * so one builder can be continued into multiple chains.
+ * @tparam RootType type of the object the chain starts from
+ * @tparam ObjectType type of the object returned by the steps added so far
+ */
+template<typename RootType, typename ObjectType = RootType>
+class TOptionalPtrChainBuilder
+{
+	template<typename, typename>
+	friend class TOptionalPtrChainBuilder;
+
+	template<typename FuncType, typename = std::enable_if_t<std::is_member_function_pointer<FuncType>::value>>
+	FORCEINLINE static decltype(auto) InvokeMember(ObjectType* obj, FuncType func)
+	{
+		return (obj->*func)();
+	}
+
+	template<typename FieldType, std::enable_if_t<std::is_member_object_pointer<FieldType>::value, int> = 0>
+	FORCEINLINE static decltype(auto) InvokeMember(ObjectType* obj, FieldType field)
+	{
+		return (obj->*field);
+	}
+
+	template<typename ElementType>
+	FORCEINLINE static ElementType* ElementPtr(ElementType* element)
+	{
+		return element;
+	}
+
+	template<typename ElementType>
+	FORCEINLINE static ElementType* ElementPtr(ElementType& element)
+	{
+		return &element;
+	}
+
+template<typename FuncType>
+using getter_result_t = decltype((std::declval<ObjectType*>()->*std::declval<FuncType>())());
+
+template<typename FieldType>
+using field_result_t = std::remove_reference_t<decltype(std::declval<ObjectType*>()->*std::declval<FieldType>())>;
+
+template<typename FuncType>
+using result_of_getter_t = typename TOptionalPtrResolver<std::decay_t<getter_result_t<FuncType>>>::ObjectType;
+
+template<typename FieldType>
+using result_of_field_t = typename TOptionalPtrResolver<std::decay_t<field_result_t<FieldType>>>::ObjectType;
+
+template<typename MemberType>
+using result_of_index_t = std::remove_pointer_t<std::remove_reference_t<decltype(
+	std::declval<std::remove_reference_t<decltype(InvokeMember(std::declval<ObjectType*>(), std::declval<MemberType>()))>&>()[0])>>;
+
+public:
+	TOptionalPtrChainBuilder()
+	{
+		FOptionalPtrChainInstruction instruction;
+		SetValidation(instruction);
+		instruction.Op = instruction.bValidateUObject ? EOptionalPtrChainOp::ValidateUObject : EOptionalPtrChainOp::ValidateNull;
+		m_chain.Emit(instruction);
+	}
+
+	/**
+	 * @brief Adds a call of the getter
+	 * @tparam FuncType type of member function without parameters returning pointer or type supported by TOptionalPtrResolver (auto-deduced)
+	 * @param func member function of ObjectType or its base
+	 * @return builder continuing from the result of the getter
+	 */
+	template<typename FuncType, typename = std::enable_if_t<std::is_member_function_pointer<FuncType>::value>,
+		typename ReturnType = result_of_getter_t<FuncType>>
+	TOptionalPtrChainBuilder<RootType, ReturnType> Map(FuncType func) const
+	{
+		static_assert(!TOptionalPtrResolver<std::decay_t<getter_result_t<FuncType>>>::bBorrowed || std::is_lvalue_reference<getter_result_t<FuncType>>::value,
+			"Owning pointer has to be returned by reference, the borrowed object could be destroyed with the returned copy otherwise.");
+		static_assert(sizeof(FuncType) <= sizeof(FOptionalPtrChainInstruction::Operand), "Member function pointer doesn't fit the operand.");
+
+		FOptionalPtrChainInstruction instruction;
+		instruction.Op = EOptionalPtrChainOp::CallGetter;
+		instruction.Thunk = &CallGetter<FuncType>;
+		FMemory::Memcpy(instruction.Operand, &func, sizeof(FuncType));
+		return Continue<ReturnType>(instruction);
+	}
+
+	/**
+	 * @brief Adds a load of the pointer field, pointer-like fields, e.g. TObjectPtr, are resolved the same way a getter would be called
+	 * @tparam FieldType type of member pointer field or field of type supported by TOptionalPtrResolver (auto-deduced)
+	 * @param field field of ObjectType or its base
+	 * @return builder continuing from the value of the field
+	 */
+	//non-type SFINAE parameter keeps the signature distinct from the getter overload
+	template<typename FieldType, std::enable_if_t<std::is_member_object_pointer<FieldType>::value, int> = 0,
+		typename ReturnType = result_of_field_t<FieldType>>
+	TOptionalPtrChainBuilder<RootType, ReturnType> Map(FieldType field) const
+	{
+		FOptionalPtrChainInstruction instruction = FieldInstruction(field, std::is_pointer<field_result_t<FieldType>>());
+		return Continue<ReturnType>(instruction);
+	}
+
+	/**
+	 * @brief Adds a cast to CastType
+	 * @tparam CastType type to cast to, has to be UObject or polymorphic type
+	 * @return builder continuing from the cast object
+	 */
+	template<typename CastType>
+	TOptionalPtrChainBuilder<RootType, CastType> Cast() const
+	{
+		FOptionalPtrChainInstruction instruction;
+		instruction.Op = EOptionalPtrChainOp::Cast;
+		instruction.Thunk = &CastTo<CastType>;
+		return Continue<CastType>(instruction);
+	}
+
+	/**
+	 * @brief Adds a bounds-checked access to the element of the array, elements of arrays of values are continued by address
+	 * @tparam MemberType type of member field or member function without parameters returning the array by reference (auto-deduced)
+	 * @param member array field or getter of ObjectType or its base
+	 * @param index index of the element
+	 * @return builder continuing from the element
+	 */
+	template<typename MemberType, typename = std::enable_if_t<std::is_member_pointer<MemberType>::value>,
+		typename ReturnType = result_of_index_t<MemberType>>
+	TOptionalPtrChainBuilder<RootType, ReturnType> MapAt(MemberType member, int32 index) const
+	{
+		static_assert(sizeof(MemberType) <= sizeof(FOptionalPtrChainInstruction::Operand), "Member pointer doesn't fit the operand.");
+
+		FOptionalPtrChainInstruction instruction;
+		instruction.Op = EOptionalPtrChainOp::Index;
+		instruction.Offset = index;
+		instruction.Thunk = &IndexContainer<MemberType>;
+		FMemory::Memcpy(instruction.Operand, &member, sizeof(MemberType));
+		return Continue<ReturnType>(instruction);
+	}
+
+	/**
+	 * @brief Finishes the chain
+	 * @param default_value object returned when any hop is not valid, nullptr for none
+	 * @return compiled chain
+	 */
+	TOptionalPtrChain<RootType, ObjectType> Build(ObjectType* default_value = nullptr) const
+	{
+		FOptionalPtrChain chain = m_chain;
+		chain.Finish(const_cast<std::remove_cv_t<ObjectType>*>(default_value));
+		return TOptionalPtrChain<RootType, ObjectType>(MoveTemp(chain));
+	}
+
+private:
+	FOptionalPtrChain m_chain;
+
+	//any suitably aligned address works, the member pointers are only offset from it and never dereferenced
+	static constexpr UPTRINT FakeObjectAddress = 0x1000;
+
+	explicit TOptionalPtrChainBuilder(FOptionalPtrChain&& chain) : m_chain{MoveTemp(chain)} {}
+
+	template<typename ReturnType>
+	TOptionalPtrChainBuilder<RootType, ReturnType> Continue(FOptionalPtrChainInstruction& instruction) const
+	{
+		//the builder keeps its instructions, so it can be continued again
+		FOptionalPtrChain chain = m_chain;
+		TOptionalPtrChainBuilder<RootType, ReturnType>::SetValidation(instruction);
+		chain.Emit(instruction);
+		return TOptionalPtrChainBuilder<RootType, ReturnType>(MoveTemp(chain));
+	}
+
+	template<typename Type = ObjectType, typename = std::enable_if_t<std::is_base_of<UObject, std::remove_cv_t<Type>>::value>>
+	static void SetValidation(FOptionalPtrChainInstruction& instruction)
+	{
+		instruction.bValidateUObject = true;
+		instruction.UObjectOffset = static_cast<int32>(
+			reinterpret_cast<UPTRINT>(static_cast<const UObject*>(reinterpret_cast<const Type*>(FakeObjectAddress))) - FakeObjectAddress);
+	}
+
+	template<typename Type = ObjectType, std::enable_if_t<!std::is_base_of<UObject, std::remove_cv_t<Type>>::value, int> = 0>
+	static void SetValidation(FOptionalPtrChainInstruction& instruction)
+	{
+		instruction.bValidateUObject = false;
+	}
+
+	//same as offsetof, which doesn't accept member pointers
+	template<typename FieldType>
+	static int32 GetFieldOffset(FieldType field)
+	{
+		const ObjectType* obj = reinterpret_cast<const ObjectType*>(FakeObjectAddress);
+		return static_cast<int32>(reinterpret_cast<UPTRINT>(&(obj->*field)) - FakeObjectAddress);
+	}
+
+	template<typename FieldType>
+	static FOptionalPtrChainInstruction FieldInstruction(FieldType field, std::true_type /*is_pointer*/)
+	{
+		FOptionalPtrChainInstruction instruction;
+		instruction.Op = EOptionalPtrChainOp::LoadField;
+		instruction.Offset = GetFieldOffset(field);
+		return instruction;
+	}
+
+	template<typename FieldType>
+	static FOptionalPtrChainInstruction FieldInstruction(FieldType field, std::false_type /*is_pointer*/)
+	{
+		static_assert(sizeof(FieldType) <= sizeof(FOptionalPtrChainInstruction::Operand), "Member pointer doesn't fit the operand.");
+
+		FOptionalPtrChainInstruction instruction;
+		instruction.Op = EOptionalPtrChainOp::CallGetter;
+		instruction.Thunk = &ResolveField<FieldType>;
+		FMemory::Memcpy(instruction.Operand, &field, sizeof(FieldType));
+		return instruction;
+	}
+
+	template<typename FuncType>
+	static void* CallGetter(void* obj, const FOptionalPtrChainInstruction& instruction)
+	{
+		FuncType func;
+		FMemory::Memcpy(&func, instruction.Operand, sizeof(FuncType));
+		return const_cast<void*>(static_cast<const void*>(
+			TOptionalPtrResolver<std::decay_t<getter_result_t<FuncType>>>::Resolve((static_cast<ObjectType*>(obj)->*func)())));
+	}
+
+	template<typename FieldType>
+	static void* ResolveField(void* obj, const FOptionalPtrChainInstruction& instruction)
+	{
+		FieldType field;
+		FMemory::Memcpy(&field, instruction.Operand, sizeof(FieldType));
+		return const_cast<void*>(static_cast<const void*>(
+			TOptionalPtrResolver<std::decay_t<field_result_t<FieldType>>>::Resolve(static_cast<ObjectType*>(obj)->*field)));
+	}
+
+	template<typename CastType>
+	static void* CastTo(void* obj, const FOptionalPtrChainInstruction& /*instruction*/)
+	{
+		return const_cast<void*>(static_cast<const void*>(CastObj<CastType>(static_cast<ObjectType*>(obj))));
+	}
+
+	template<typename MemberType>
+	static void* IndexContainer(void* obj, const FOptionalPtrChainInstruction& instruction)
+	{
+		MemberType member;
+		FMemory::Memcpy(&member, instruction.Operand, sizeof(MemberType));
+		decltype(auto) container = InvokeMember(static_cast<ObjectType*>(obj), member);
+		return container.IsValidIndex(instruction.Offset) ?
+			const_cast<void*>(static_cast<const void*>(ElementPtr(container[instruction.Offset]))) :
+			nullptr;
+	}
+
+	template<typename CastType, typename Type = ObjectType, typename = std::enable_if_t<std::is_base_of<UObject, std::remove_cv_t<Type>>::value>>
+	FORCEINLINE static CastType* CastObj(Type* obj)
+	{
+		return ::Cast<std::remove_cv_t<CastType>>(obj);
+	}
+
+	template<typename CastType, typename Type = ObjectType, std::enable_if_t<!std::is_base_of<UObject, std::remove_cv_t<Type>>::value, int> = 0>
+	FORCEINLINE static CastType* CastObj(Type* obj)
+	{
+		return dynamic_cast<CastType*>(obj);
+	}
+};
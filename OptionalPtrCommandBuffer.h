@@ -0,0 +1,270 @@
+#pragma once
+
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "CoreMinimal.h"
+#include "OptionalPtr.h"
+
+
+/**
+ * Order the commands of FOptionalPtrCommandBuffer are executed in, commands recorded for the same object and member
+ * keep the order they were recorded in
+ */
+enum class EOptionalPtrCommandOrder : uint8
+{
+	/** Order of recording */
+	Recorded,
+	/** Address of the object, so the objects are visited in the order they are laid out in memory */
+	Object,
+	/** Member function, so the same code runs for all its objects before the next one */
+	Member
+};
+
+/**
+ * Calls of member functions recorded by TOptionalPtr::IfPresentDeferred and executed later in bulk by Flush.
+ * The commands are bump-allocated in blocks reused after each flush, the arguments are copied into them, so output
+ * parameters have to be passed by pointer. Objects are validated again when the command is executed, so the buffer
+ * has to be flushed before the recorded objects can be deleted, e.g. within the frame for UObjects.
+ */
+class FOptionalPtrCommandBuffer
+{
+	struct FCommand
+	{
+		/** Executes the command if its object is still valid and destroys it, returns true if executed */
+		bool (*Run)(FCommand* command, bool execute);
+	};
+
+	template<typename ObjectType, typename FuncType, typename... ArgTypes>
+	struct TCommand : FCommand
+	{
+		ObjectType* Obj;
+		FuncType Func;
+		std::tuple<ArgTypes...> Args;
+
+		template<typename... InArgTypes>
+		TCommand(ObjectType* obj, FuncType func, InArgTypes&&... args) :
+			FCommand{&RunCommand<TCommand>}, Obj{obj}, Func{func}, Args(std::forward<InArgTypes>(args)...) {}
+	};
+
+	struct FEntry
+	{
+		UPTRINT Object;
+		UPTRINT Member;
+		FCommand* Command;
+	};
+
+public:
+	/** Size of the blocks the commands are allocated in, bigger commands get their own block */
+	static constexpr SIZE_T BlockSize = 64 * 1024;
+
+	FOptionalPtrCommandBuffer() = default;
+	FOptionalPtrCommandBuffer(const FOptionalPtrCommandBuffer&) = delete;
+	FOptionalPtrCommandBuffer& operator=(const FOptionalPtrCommandBuffer&) = delete;
+
+	~FOptionalPtrCommandBuffer()
+	{
+		Reset();
+		for (uint8* block : m_blocks)
+		{
+			FMemory::Free(block);
+		}
+	}
+
+	/**
+	 * @brief Records call of the member function, use TOptionalPtr::IfPresentDeferred to skip objects which are not valid
+	 * @tparam ObjectType type of the object (auto-deduced)
+	 * @tparam FuncType type of member function (auto-deduced)
+	 * @tparam Args types of arguments provided to the member function (auto-deduced)
+	 * @param obj object to call the member function on
+	 * @param func member function to call
+	 * @param args arguments provided to the member function, copied into the buffer
+	 */
+	template<typename ObjectType, typename FuncType, typename... Args>
+	void Add(ObjectType* obj, FuncType func, Args&&... args)
+	{
+		using CommandType = TCommand<ObjectType, FuncType, std::decay_t<Args>...>;
+		static_assert(alignof(CommandType) <= BlockAlignment, "Arguments are aligned more than the blocks of the buffer.");
+
+		CommandType* command = new(Allocate(sizeof(CommandType), alignof(CommandType))) CommandType(obj, func, std::forward<Args>(args)...);
+		m_entries.Add(FEntry{reinterpret_cast<UPTRINT>(obj), MemberKey(func), command});
+	}
+
+	/**
+	 * @brief Executes the recorded commands in the given order, commands recorded during the flush are kept for the next one
+	 * @param order order the commands are executed in
+	 * @return number of executed commands, commands of objects which are not valid anymore are skipped
+	 */
+	int32 Flush(EOptionalPtrCommandOrder order = EOptionalPtrCommandOrder::Object)
+	{
+		if (order == EOptionalPtrCommandOrder::Object)
+		{
+			SortEntries(&FEntry::Object);
+		}
+		else if (order == EOptionalPtrCommandOrder::Member)
+		{
+			SortEntries(&FEntry::Member);
+		}
+
+		TArray<FEntry> entries = MoveTemp(m_entries);
+		m_entries.Reset();
+		int32 num_executed = 0;
+		for (int32 i = 0; i < entries.Num(); ++i)
+		{
+			//sorted commands are scattered over the blocks, so both the command and its object are prefetched ahead
+			if (i + PrefetchDistance < entries.Num())
+			{
+				FPlatformMisc::Prefetch(entries[i + PrefetchDistance].Command);
+				FPlatformMisc::Prefetch(reinterpret_cast<const void*>(entries[i + PrefetchDistance].Object));
+			}
+			num_executed += entries[i].Command->Run(entries[i].Command, true);
+		}
+
+		//blocks can be reused only if no command was recorded in them during the flush
+		if (m_entries.Num() == 0)
+		{
+			entries.Reset();
+			m_entries = MoveTemp(entries);
+			ReleaseBlocks();
+		}
+		return num_executed;
+	}
+
+	/**
+	 * @brief Discards the recorded commands without executing them
+	 */
+	void Reset()
+	{
+		for (const FEntry& entry : m_entries)
+		{
+			entry.Command->Run(entry.Command, false);
+		}
+		m_entries.Reset();
+		ReleaseBlocks();
+	}
+
+	/**
+	 * @return number of recorded commands
+	 */
+	int32 Num() const
+	{
+		return m_entries.Num();
+	}
+
+private:
+	static constexpr SIZE_T BlockAlignment = 64;
+	static constexpr int32 PrefetchDistance = 8;
+	static constexpr uint32 RadixBits = 11;
+	static constexpr UPTRINT RadixMask = (1 << RadixBits) - 1;
+
+	TArray<FEntry> m_entries;
+	//second half of the radix sort
+	TArray<FEntry> m_sorted_entries;
+	//blocks past the used ones are kept for reuse
+	TArray<uint8*> m_blocks;
+	int32 m_used_blocks = 0;
+	SIZE_T m_block_top = 0;
+	//commands bigger than BlockSize, freed once executed
+	TArray<void*> m_large_blocks;
+
+	template<typename CommandType>
+	static bool RunCommand(FCommand* command, bool execute)
+	{
+		CommandType* typed_command = static_cast<CommandType*>(command);
+		const bool executed = execute && FOptionalPtrDefaultPolicy::IsValidObj(typed_command->Obj);
+		if (executed)
+		{
+			InvokeCommand(typed_command, std::make_index_sequence<std::tuple_size<decltype(typed_command->Args)>::value>());
+		}
+		typed_command->~CommandType();
+		return executed;
+	}
+
+	template<typename CommandType, size_t... Indices>
+	FORCEINLINE static void InvokeCommand(CommandType* command, std::index_sequence<Indices...>)
+	{
+		(command->Obj->*command->Func)(MoveTemp(std::get<Indices>(command->Args))...);
+	}
+
+	//stable LSD radix sort, digits which are the same for all the entries, e.g. the top bits of addresses, are skipped
+	void SortEntries(UPTRINT FEntry::* key)
+	{
+		const int32 num = m_entries.Num();
+		if (num < 2)
+			return;
+
+		UPTRINT differing_bits = 0;
+		for (const FEntry& entry : m_entries)
+		{
+			differing_bits |= entry.*key ^ m_entries[0].*key;
+		}
+
+		m_sorted_entries.SetNumUninitialized(num);
+		for (uint32 shift = 0; shift < sizeof(UPTRINT) * 8 && (differing_bits >> shift) != 0; shift += RadixBits)
+		{
+			if (((differing_bits >> shift) & RadixMask) == 0)
+				continue;
+
+			int32 offsets[RadixMask + 2] = {};
+			for (const FEntry& entry : m_entries)
+			{
+				++offsets[((entry.*key >> shift) & RadixMask) + 1];
+			}
+			for (uint32 digit = 1; digit <= RadixMask; ++digit)
+			{
+				offsets[digit] += offsets[digit - 1];
+			}
+			for (const FEntry& entry : m_entries)
+			{
+				m_sorted_entries[offsets[(entry.*key >> shift) & RadixMask]++] = entry;
+			}
+			Swap(m_entries, m_sorted_entries);
+		}
+	}
+
+	//member function pointers can't be ordered, their leading bytes are enough to group the calls of the same member
+	template<typename FuncType>
+	static UPTRINT MemberKey(const FuncType& func)
+	{
+		UPTRINT key = 0;
+		FMemory::Memcpy(&key, &func, sizeof(key) < sizeof(func) ? sizeof(key) : sizeof(func));
+		return key;
+	}
+
+	void* Allocate(SIZE_T size, SIZE_T alignment)
+	{
+		if (size > BlockSize)
+		{
+			void* block = FMemory::Malloc(size, alignment);
+			m_large_blocks.Add(block);
+			return block;
+		}
+
+		SIZE_T offset = Align(m_block_top, alignment);
+		if (m_used_blocks == 0 || offset + size > BlockSize)
+		{
+			if (m_used_blocks == m_blocks.Num())
+			{
+				m_blocks.Add(static_cast<uint8*>(FMemory::Malloc(BlockSize, BlockAlignment)));
+			}
+			++m_used_blocks;
+			offset = 0;
+		}
+
+		m_block_top = offset + size;
+		return m_blocks[m_used_blocks - 1] + offset;
+	}
+
+	void ReleaseBlocks()
+	{
+		m_used_blocks = 0;
+		m_block_top = 0;
+		for (void* block : m_large_blocks)
+		{
+			FMemory::Free(block);
+		}
+		m_large_blocks.Reset();
+	}
+};
@@ -0,0 +1,230 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OptionalPtr.h"
+
+#if defined(__cpp_impl_coroutine)
+
+#include <coroutine>
+#include <new>
+
+/**
+ * Per-thread stack the frames of TOptionalPtr coroutines are placed in, frames which don't fit are allocated on the heap.
+ * The coroutines do suspend, at the end and at a failed co_await, but their frames are owned by TOptionalPtrCoroutine,
+ * which can't be moved and destroys the frame in the scope of the caller, so the frames are freed in reverse order
+ * of allocation.
+ */
+class FOptionalPtrCoroutineStack
+{
+public:
+	/** Size of the per-thread buffer, on most platforms reserved in the thread-local storage of every thread */
+	static constexpr SIZE_T Capacity = 64 * 1024;
+	static constexpr SIZE_T Alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+	static FOptionalPtrCoroutineStack& Get()
+	{
+		static thread_local FOptionalPtrCoroutineStack stack;
+		return stack;
+	}
+
+	void* Allocate(SIZE_T size)
+	{
+		size = Align(size, Alignment);
+		if (m_top + size > Capacity)
+			return FMemory::Malloc(size, Alignment);
+
+		void* frame = m_buffer + m_top;
+		m_top += size;
+		return frame;
+	}
+
+	void Free(void* frame, SIZE_T size)
+	{
+		uint8* const frame_bytes = static_cast<uint8*>(frame);
+		if (frame_bytes < m_buffer || frame_bytes >= m_buffer + Capacity)
+		{
+			FMemory::Free(frame);
+			return;
+		}
+
+		checkf(frame_bytes + Align(size, Alignment) == m_buffer + m_top, TEXT("Coroutine frames have to be freed in reverse order."));
+		m_top = frame_bytes - m_buffer;
+	}
+
+	/**
+	 * @return number of bytes taken by the frames of the running coroutines
+	 */
+	SIZE_T GetUsed() const
+	{
+		return m_top;
+	}
+
+private:
+	alignas(Alignment) uint8 m_buffer[Capacity];
+	SIZE_T m_top = 0;
+};
+
+template<typename ObjectType, typename PolicyType>
+class TOptionalPtrCoroutine;
+
+/**
+ * Promise of TOptionalPtrCoroutine, see TOptionalPtrCoroutine
+ */
+template<typename ObjectType, typename PolicyType>
+class TOptionalPtrCoroutinePromise
+{
+	template<typename AwaitedType>
+	struct TAwaiter
+	{
+		AwaitedType* Obj;
+
+		bool await_ready() const noexcept
+		{
+			return Obj != nullptr;
+		}
+
+		//the function stays suspended with empty result until its frame is destroyed by the returned object
+		void await_suspend(std::coroutine_handle<>) const noexcept
+		{
+		}
+
+		AwaitedType* await_resume() const noexcept
+		{
+			return Obj;
+		}
+	};
+
+public:
+	static void* operator new(std::size_t size)
+	{
+		return FOptionalPtrCoroutineStack::Get().Allocate(size);
+	}
+
+	static void operator delete(void* frame, std::size_t size)
+	{
+		FOptionalPtrCoroutineStack::Get().Free(frame, size);
+	}
+
+	TOptionalPtrCoroutine<ObjectType, PolicyType> get_return_object()
+	{
+		return TOptionalPtrCoroutine<ObjectType, PolicyType>(std::coroutine_handle<TOptionalPtrCoroutinePromise>::from_promise(*this));
+	}
+
+	std::suspend_never initial_suspend() const noexcept
+	{
+		return {};
+	}
+
+	//the frame is kept until the returned object reads the result
+	std::suspend_always final_suspend() const noexcept
+	{
+		return {};
+	}
+
+	void return_value(ObjectType* obj)
+	{
+		m_result = obj;
+	}
+
+	template<typename OtherPolicyType>
+	void return_value(TOptionalPtr<ObjectType, OtherPolicyType> obj)
+	{
+		m_result = obj.Get();
+	}
+
+	void unhandled_exception()
+	{
+		checkNoEntry();
+	}
+
+	template<typename AwaitedType, typename AwaitedPolicyType>
+	TAwaiter<AwaitedType> await_transform(TOptionalPtr<AwaitedType, AwaitedPolicyType> obj)
+	{
+		return TAwaiter<AwaitedType>{obj.IsSet() ? obj.Get() : nullptr};
+	}
+
+	template<typename AwaitedType, typename AwaitedPolicyType>
+	TAwaiter<AwaitedType> await_transform(const TOptionalPtrCoroutine<AwaitedType, AwaitedPolicyType>& obj)
+	{
+		return TAwaiter<AwaitedType>{obj.Get()};
+	}
+
+	template<typename AwaitedType>
+	TAwaiter<AwaitedType> await_transform(AwaitedType* obj)
+	{
+		return await_transform(MakeUncountedOptionalPtr(obj));
+	}
+
+	ObjectType* GetResult() const
+	{
+		return m_result;
+	}
+
+private:
+	ObjectType* m_result = nullptr;
+};
+
+/**
+ * Return type of functions written as coroutines able to co_await TOptionalPtr, raw pointer or other TOptionalPtrCoroutine.
+ * The awaited object is returned if valid, otherwise the function is finished right away with empty result:
+ *
+ * TOptionalPtrCoroutine<APawn> GetPawn(UWorld* World)
+ * {
+ *     APlayerController* Controller = co_await World->GetFirstPlayerController();
+ *     co_return Controller->GetPawn();
+ * }
+ *
+ * TOptionalPtr<APawn> Pawn = GetPawn(World);
+ *
+ * The coroutines run synchronously, the result is ready once the function returns. Their frames are placed
+ * in FOptionalPtrCoroutineStack and kept until the returned object is destroyed, so it can't be moved
+ * and has to be destroyed in the scope it was returned to, e.g. by converting it to TOptionalPtr right away.
+ */
+template<typename ObjectType, typename PolicyType = FOptionalPtrDefaultPolicy>
+class TOptionalPtrCoroutine
+{
+public:
+	using promise_type = TOptionalPtrCoroutinePromise<ObjectType, PolicyType>;
+
+	TOptionalPtrCoroutine(const TOptionalPtrCoroutine&) = delete;
+	TOptionalPtrCoroutine& operator=(const TOptionalPtrCoroutine&) = delete;
+
+	~TOptionalPtrCoroutine()
+	{
+		m_handle.destroy();
+	}
+
+	/**
+	 * @return true if the function finished with valid object, false if it finished early or with invalid object
+	 */
+	bool IsSet() const
+	{
+		return Get() != nullptr;
+	}
+
+	/**
+	 * @return object the function finished with, nullptr if it finished early or the object is not valid
+	 */
+	ObjectType* Get() const
+	{
+		ObjectType* result = m_handle.promise().GetResult();
+		return PolicyType::IsValidObj(result) ? result : nullptr;
+	}
+
+	operator TOptionalPtr<ObjectType, PolicyType>() const
+	{
+		return MakeUncountedOptionalPtr<ObjectType, PolicyType>(Get());
+	}
+
+private:
+	friend promise_type;
+
+	std::coroutine_handle<promise_type> m_handle;
+
+	explicit TOptionalPtrCoroutine(std::coroutine_handle<promise_type> handle)
+		: m_handle{handle}
+	{
+	}
+};
+
+#endif
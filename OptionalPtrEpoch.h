@@ -0,0 +1,252 @@
+#pragma once
+
+#include <atomic>
+
+#include "CoreMinimal.h"
+#include "OptionalPtr.h"
+
+
+/**
+ * Epoch-based reclamation of non-UObjects which can be destroyed while other threads run chains through them.
+ * Chains run inside FOptionalPtrEpochGuard, writers unlink the object first and then Retire it instead of deleting it.
+ * Retired objects are deleted once every thread which could still see them has left its guard, i.e. the global
+ * epoch advanced twice since the retirement. Entering and leaving the guard only touches the record of the thread.
+ */
+class FOptionalPtrEpochDomain
+{
+	friend class FOptionalPtrEpochGuard;
+
+	struct FRetired
+	{
+		void* Object;
+		void (*Deleter)(void*);
+		uint64 Epoch;
+	};
+
+	//each thread gets its own record, aligned to keep the records of different threads on different cache lines
+	struct alignas(64) FRecord
+	{
+		/** Epoch the thread entered its guard in, 0 outside of guards */
+		std::atomic<uint64> Epoch{0};
+		std::atomic<bool> bInUse{true};
+		FRecord* Next = nullptr;
+		int32 Nesting = 0;
+		TArray<FRetired> Retired;
+	};
+
+	//releases the record when the thread exits, objects it retired are deleted by the next thread reusing the record
+	struct FThreadRecord
+	{
+		FRecord* Record = nullptr;
+
+		~FThreadRecord()
+		{
+			if (Record != nullptr)
+			{
+				Record->bInUse.store(false, std::memory_order_release);
+			}
+		}
+	};
+
+public:
+	/** Number of objects retired by a thread before it tries to delete them */
+	static constexpr int32 ReclaimThreshold = 64;
+
+	FOptionalPtrEpochDomain(const FOptionalPtrEpochDomain&) = delete;
+	FOptionalPtrEpochDomain& operator=(const FOptionalPtrEpochDomain&) = delete;
+
+	/**
+	 * @return domain shared by all the chains
+	 */
+	static FOptionalPtrEpochDomain& Get()
+	{
+		static FOptionalPtrEpochDomain domain;
+		return domain;
+	}
+
+	/**
+	 * @brief Enters the read-side critical section of the calling thread, guards can be nested
+	 */
+	FORCEINLINE void Enter()
+	{
+		Enter(GetRecord());
+	}
+
+	/**
+	 * @brief Leaves the read-side critical section of the calling thread
+	 */
+	FORCEINLINE void Exit()
+	{
+		Exit(GetRecord());
+	}
+
+	/**
+	 * @return true if the calling thread is inside a guard, false otherwise
+	 */
+	bool IsInGuard()
+	{
+		return GetRecord().Nesting > 0;
+	}
+
+	/**
+	 * @brief Deletes the object once no thread can see it anymore, it has to be unlinked from all the objects chains can reach it from
+	 * @tparam ObjectType type of the object (auto-deduced)
+	 * @param obj object to delete
+	 */
+	template<typename ObjectType>
+	void Retire(ObjectType* obj)
+	{
+		static_assert(!std::is_base_of<UObject, std::remove_cv_t<ObjectType>>::value, "UObjects are reclaimed by the garbage collector.");
+
+		FRecord& record = GetRecord();
+		record.Retired.Add(FRetired{const_cast<std::remove_cv_t<ObjectType>*>(obj), &DeleteObject<std::remove_cv_t<ObjectType>>,
+			m_epoch.load(std::memory_order_seq_cst)});
+		if (record.Retired.Num() >= ReclaimThreshold)
+		{
+			Reclaim();
+		}
+	}
+
+	/**
+	 * @brief Advances the global epoch if all the threads in guards have seen it and deletes objects retired by the calling thread which are safe to delete
+	 * @return number of deleted objects
+	 */
+	int32 Reclaim()
+	{
+		TryAdvance();
+
+		FRecord& record = GetRecord();
+		const uint64 epoch = m_epoch.load(std::memory_order_acquire);
+		//objects are retired in the order of epochs, so the ones safe to delete come first
+		int32 num_deleted = 0;
+		while (num_deleted < record.Retired.Num() && record.Retired[num_deleted].Epoch + 2 <= epoch)
+		{
+			record.Retired[num_deleted].Deleter(record.Retired[num_deleted].Object);
+			++num_deleted;
+		}
+		record.Retired.RemoveAt(0, num_deleted);
+		return num_deleted;
+	}
+
+	/**
+	 * @return current global epoch
+	 */
+	uint64 GetEpoch() const
+	{
+		return m_epoch.load(std::memory_order_relaxed);
+	}
+
+private:
+	std::atomic<uint64> m_epoch{1};
+	//records are never freed, released ones are reused by new threads
+	std::atomic<FRecord*> m_records{nullptr};
+
+	FOptionalPtrEpochDomain() = default;
+
+	FORCEINLINE void Enter(FRecord& record)
+	{
+		if (record.Nesting++ == 0)
+		{
+			//the epoch has to be published before any object is read, exchange is a cheaper full barrier than a fence on x86
+			record.Epoch.exchange(m_epoch.load(std::memory_order_relaxed), std::memory_order_seq_cst);
+		}
+	}
+
+	FORCEINLINE void Exit(FRecord& record)
+	{
+		checkSlow(record.Nesting > 0);
+		if (--record.Nesting == 0)
+		{
+			record.Epoch.store(0, std::memory_order_release);
+		}
+	}
+
+	template<typename ObjectType>
+	static void DeleteObject(void* obj)
+	{
+		delete static_cast<ObjectType*>(obj);
+	}
+
+	FORCEINLINE FRecord& GetRecord()
+	{
+		static thread_local FThreadRecord thread_record;
+		if (UNLIKELY(thread_record.Record == nullptr))
+		{
+			thread_record.Record = AcquireRecord();
+		}
+		return *thread_record.Record;
+	}
+
+	FRecord* AcquireRecord()
+	{
+		for (FRecord* record = m_records.load(std::memory_order_acquire); record != nullptr; record = record->Next)
+		{
+			bool in_use = false;
+			if (!record->bInUse.load(std::memory_order_relaxed) && record->bInUse.compare_exchange_strong(in_use, true, std::memory_order_acquire))
+				return record;
+		}
+
+		FRecord* const record = new FRecord();
+		FRecord* head = m_records.load(std::memory_order_relaxed);
+		do
+		{
+			record->Next = head;
+		}
+		while (!m_records.compare_exchange_weak(head, record, std::memory_order_release, std::memory_order_relaxed));
+		return record;
+	}
+
+	void TryAdvance()
+	{
+		uint64 epoch = m_epoch.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		for (FRecord* record = m_records.load(std::memory_order_acquire); record != nullptr; record = record->Next)
+		{
+			const uint64 record_epoch = record->Epoch.load(std::memory_order_acquire);
+			if (record_epoch != 0 && record_epoch != epoch)
+				return;
+		}
+		m_epoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_acq_rel);
+	}
+};
+
+/**
+ * Read-side critical section of FOptionalPtrEpochDomain, objects reached within it are not deleted until it ends
+ */
+class FOptionalPtrEpochGuard
+{
+public:
+	FOptionalPtrEpochGuard() : m_domain{FOptionalPtrEpochDomain::Get()}, m_record{m_domain.GetRecord()}
+	{
+		m_domain.Enter(m_record);
+	}
+
+	~FOptionalPtrEpochGuard()
+	{
+		m_domain.Exit(m_record);
+	}
+
+	FOptionalPtrEpochGuard(const FOptionalPtrEpochGuard&) = delete;
+	FOptionalPtrEpochGuard& operator=(const FOptionalPtrEpochGuard&) = delete;
+
+private:
+	FOptionalPtrEpochDomain& m_domain;
+	FOptionalPtrEpochDomain::FRecord& m_record;
+};
+
+/**
+ * Validity policy of objects reclaimed by FOptionalPtrEpochDomain, checks the chain runs inside FOptionalPtrEpochGuard
+ * @tparam BasePolicy policy validating the objects
+ */
+template<typename BasePolicy = FOptionalPtrDefaultPolicy>
+struct TOptionalPtrEpochPolicy
+{
+	using NextPolicy = TOptionalPtrEpochPolicy<typename BasePolicy::NextPolicy>;
+
+	template<typename Type>
+	FORCEINLINE static bool IsValidObj(const Type* obj)
+	{
+		checkfSlow(FOptionalPtrEpochDomain::Get().IsInGuard(), TEXT("Chain of epoch reclaimed objects runs outside of FOptionalPtrEpochGuard."));
+		return BasePolicy::IsValidObj(obj);
+	}
+};
@@ -0,0 +1,339 @@
+#pragma once
+
+#include <atomic>
+#include <type_traits>
+
+#include "CoreMinimal.h"
+#include "Async/Async.h"
+#include "Engine/AssetManager.h"
+#include "OptionalPtr.h"
+
+
+template<typename ObjectType>
+class TOptionalPtrFuture;
+
+/**
+ * Completes TOptionalPtrFuture. The promise can be completed only once.
+ */
+template<typename ObjectType>
+class TOptionalPtrPromise
+{
+	template<typename>
+	friend class TOptionalPtrFuture;
+
+	enum class EStatus : uint8
+	{
+		Pending,
+		Continued,
+		Ready
+	};
+
+	struct FState
+	{
+		std::atomic<EStatus> Status{EStatus::Pending};
+		ObjectType* Result = nullptr;
+		TUniqueFunction<void(ObjectType*)> Continuation;
+	};
+
+public:
+	TOptionalPtrPromise() : m_state{MakeShared<FState, ESPMode::ThreadSafe>()} {}
+
+	TOptionalPtrFuture<ObjectType> GetFuture() const
+	{
+		return TOptionalPtrFuture<ObjectType>(m_state);
+	}
+
+	/**
+	 * @brief Completes the future, its continuation is run on the calling thread if there already is one
+	 * @param obj result of the future, nullptr if there is none
+	 */
+	void SetValue(ObjectType* obj)
+	{
+		m_state->Result = obj;
+		if (m_state->Status.exchange(EStatus::Ready, std::memory_order_acq_rel) == EStatus::Continued)
+		{
+			m_state->Continuation(obj);
+			//releases whatever the continuation captured
+			m_state->Continuation = nullptr;
+		}
+	}
+
+private:
+	TSharedRef<FState, ESPMode::ThreadSafe> m_state;
+};
+
+/**
+ * Result of an asynchronous chain step, e.g. TOptionalPtr::MapAsync, which is continued by the rest of the chain once
+ * ready. The future can be continued only once, by Map, MapAsync or Then, each returning a new future for the next step.
+ */
+template<typename ObjectType>
+class TOptionalPtrFuture
+{
+	template<typename>
+	friend class TOptionalPtrPromise;
+
+	template<typename>
+	friend class TOptionalPtrFuture;
+
+	using FState = typename TOptionalPtrPromise<ObjectType>::FState;
+	using EStatus = typename TOptionalPtrPromise<ObjectType>::EStatus;
+
+public:
+	using ElementType = ObjectType;
+
+	/**
+	 * @param obj result of the future which is ready right away
+	 */
+	TOptionalPtrFuture(ObjectType* obj) : m_obj{obj} {}
+
+	/**
+	 * @return true if the result is available, either way the continuations can be added right away
+	 */
+	bool IsReady() const
+	{
+		return !m_state.IsValid() || m_state->Status.load(std::memory_order_acquire) == EStatus::Ready;
+	}
+
+	/**
+	 * @brief Applies TOptionalPtr::Map with given arguments to the result once ready
+	 * @tparam Args types of member function or field and arguments provided to the member function (auto-deduced)
+	 * @tparam ReturnType type of return object (auto-deduced)
+	 * @param args member function or field followed by arguments provided to the member function
+	 * @return future of the result of Map
+	 */
+	template<typename... Args, typename ReturnType = std::remove_pointer_t<decltype(
+		std::declval<TOptionalPtr<ObjectType>&>().Map(std::declval<Args>()...).Get())>>
+	TOptionalPtrFuture<ReturnType> Map(Args... args)
+	{
+		if (!m_state.IsValid())
+			return TOptionalPtrFuture<ReturnType>(MakeUncountedOptionalPtr(m_obj).Map(Args(args)...).Get());
+
+		TOptionalPtrPromise<ReturnType> promise;
+		TOptionalPtrFuture<ReturnType> future = promise.GetFuture();
+		OnReady([promise, args...](ObjectType* obj) mutable
+		{
+			promise.SetValue(MakeUncountedOptionalPtr(obj).Map(Args(args)...).Get());
+		});
+		return future;
+	}
+
+	/**
+	 * @brief Applies TOptionalPtr::MapAsync to the result once ready
+	 * @tparam MemberType type of member field or member function returning TSoftObjectPtr or TSoftClassPtr (auto-deduced)
+	 * @tparam LoaderType type of the loader, e.g. TOptionalPtrAsyncLoader<> (auto-deduced)
+	 * @tparam ReturnType type of the loaded asset (auto-deduced)
+	 * @param member member field or member function returning the soft reference
+	 * @param loader loader of the asset, has to outlive the chain
+	 * @return future of the loaded asset
+	 */
+	template<typename MemberType, typename LoaderType, typename ReturnType = typename decltype(
+		std::declval<TOptionalPtr<ObjectType>&>().MapAsync(std::declval<MemberType>(), std::declval<LoaderType&>()))::ElementType>
+	TOptionalPtrFuture<ReturnType> MapAsync(MemberType member, LoaderType& loader)
+	{
+		if (!m_state.IsValid())
+			return MakeUncountedOptionalPtr(m_obj).MapAsync(MemberType(member), loader);
+
+		TOptionalPtrPromise<ReturnType> promise;
+		TOptionalPtrFuture<ReturnType> future = promise.GetFuture();
+		OnReady([promise, member, &loader](ObjectType* obj) mutable
+		{
+			MakeUncountedOptionalPtr(obj).MapAsync(MemberType(member), loader).OnReady([promise](ReturnType* asset) mutable
+			{
+				promise.SetValue(asset);
+			});
+		});
+		return future;
+	}
+
+	/**
+	 * @brief Calls given function with the result once ready, on the thread completing the future
+	 * @tparam FuncType type of function taking the result wrapped in TOptionalPtr (auto-deduced)
+	 * @param func function to call with the result
+	 */
+	template<typename FuncType>
+	void Then(FuncType&& func)
+	{
+		OnReady([func = std::forward<FuncType>(func)](ObjectType* obj) mutable
+		{
+			func(MakeUncountedOptionalPtr(obj));
+		});
+	}
+
+	/**
+	 * @brief Calls given function with the result once ready, on the given thread. UObjects are kept by weak pointers
+	 * until the function runs, so the result is empty if they are destroyed in the meantime.
+	 * @tparam FuncType type of function taking the result wrapped in TOptionalPtr (auto-deduced)
+	 * @param thread thread to call the function on
+	 * @param func function to call with the result
+	 */
+	template<typename FuncType>
+	void Then(ENamedThreads::Type thread, FuncType&& func)
+	{
+		OnReady([thread, func = std::forward<FuncType>(func)](ObjectType* obj) mutable
+		{
+			AsyncTask(thread, [kept_obj = KeepObj(obj), func = MoveTemp(func)]() mutable
+			{
+				func(MakeUncountedOptionalPtr<ObjectType>(TOptionalPtrResolver<decltype(kept_obj)>::Resolve(kept_obj)));
+			});
+		});
+	}
+
+private:
+	ObjectType* m_obj = nullptr;
+	TSharedPtr<FState, ESPMode::ThreadSafe> m_state;
+
+	explicit TOptionalPtrFuture(const TSharedRef<FState, ESPMode::ThreadSafe>& state) : m_state{state} {}
+
+	void OnReady(TUniqueFunction<void(ObjectType*)>&& continuation)
+	{
+		if (!m_state.IsValid())
+		{
+			continuation(m_obj);
+			return;
+		}
+
+		checkf(m_state->Status.load(std::memory_order_acquire) != EStatus::Continued, TEXT("Future can be continued only once."));
+		m_state->Continuation = MoveTemp(continuation);
+		EStatus expected = EStatus::Pending;
+		if (!m_state->Status.compare_exchange_strong(expected, EStatus::Continued, std::memory_order_acq_rel))
+		{
+			m_state->Continuation(m_state->Result);
+			m_state->Continuation = nullptr;
+		}
+	}
+
+	template<typename Type, std::enable_if_t<std::is_base_of<UObject, std::remove_cv_t<Type>>::value, int> = 0>
+	FORCEINLINE static TWeakObjectPtr<Type> KeepObj(Type* obj)
+	{
+		return TWeakObjectPtr<Type>(obj);
+	}
+
+	template<typename Type, std::enable_if_t<!std::is_base_of<UObject, std::remove_cv_t<Type>>::value, int> = 0>
+	FORCEINLINE static Type* KeepObj(Type* obj)
+	{
+		return obj;
+	}
+};
+
+/**
+ * Loads soft references with the streamable manager of the asset manager. Loads are requested and completed on the game thread.
+ */
+struct FOptionalPtrStreamableLoader
+{
+	template<typename FuncType>
+	void RequestLoad(const FSoftObjectPath& path, FuncType&& on_loaded)
+	{
+		UAssetManager::GetStreamableManager().RequestAsyncLoad(path, FStreamableDelegate::CreateLambda(std::forward<FuncType>(on_loaded)));
+	}
+
+	UObject* Resolve(const FSoftObjectPath& path) const
+	{
+		return path.ResolveObject();
+	}
+};
+
+/**
+ * Loads soft references for TOptionalPtr::MapAsync, identical outstanding loads are requested only once and all the
+ * chains waiting for them are resumed when the load completes. The loader has to outlive all its pending loads.
+ * @tparam LoaderType policy requesting the loads, has to provide RequestLoad and Resolve like FOptionalPtrStreamableLoader
+ */
+template<typename LoaderType = FOptionalPtrStreamableLoader>
+class TOptionalPtrAsyncLoader
+{
+public:
+	TOptionalPtrAsyncLoader() = default;
+
+	explicit TOptionalPtrAsyncLoader(const LoaderType& loader) : m_loader{loader} {}
+
+	/**
+	 * @param ptr soft reference to load
+	 * @return future of the loaded asset, ready right away if the asset is already loaded
+	 */
+	template<typename AssetType>
+	TOptionalPtrFuture<AssetType> Load(const TSoftObjectPtr<AssetType>& ptr)
+	{
+		AssetType* asset = ptr.Get();
+		return asset != nullptr ?
+			TOptionalPtrFuture<AssetType>(asset) :
+			LoadPath<AssetType>(ptr.ToSoftObjectPath());
+	}
+
+	/**
+	 * @param ptr soft class reference to load
+	 * @return future of the loaded class, ready right away if the class is already loaded
+	 */
+	template<typename AssetType>
+	TOptionalPtrFuture<UClass> Load(const TSoftClassPtr<AssetType>& ptr)
+	{
+		UClass* asset_class = ptr.Get();
+		return asset_class != nullptr ?
+			TOptionalPtrFuture<UClass>(asset_class) :
+			LoadPath<UClass>(ptr.ToSoftObjectPath());
+	}
+
+	/**
+	 * @param path path of the object to load
+	 * @return future of the loaded object
+	 */
+	TOptionalPtrFuture<UObject> Load(const FSoftObjectPath& path)
+	{
+		return LoadPath<UObject>(path);
+	}
+
+	/**
+	 * @return number of distinct loads in flight
+	 */
+	int32 NumPending() const
+	{
+		return m_pending.Num();
+	}
+
+	LoaderType& GetLoader()
+	{
+		return m_loader;
+	}
+
+private:
+	LoaderType m_loader;
+	//chains waiting for each load in flight
+	TMap<FSoftObjectPath, TArray<TUniqueFunction<void(UObject*)>>> m_pending;
+
+	template<typename AssetType>
+	TOptionalPtrFuture<AssetType> LoadPath(const FSoftObjectPath& path)
+	{
+		if (path.IsNull())
+			return TOptionalPtrFuture<AssetType>(nullptr);
+
+		TOptionalPtrPromise<AssetType> promise;
+		TOptionalPtrFuture<AssetType> future = promise.GetFuture();
+		TUniqueFunction<void(UObject*)> waiter = [promise](UObject* asset) mutable
+		{
+			promise.SetValue(Cast<AssetType>(asset));
+		};
+
+		if (TArray<TUniqueFunction<void(UObject*)>>* waiters = m_pending.Find(path))
+		{
+			waiters->Add(MoveTemp(waiter));
+			return future;
+		}
+
+		m_pending.Add(path).Add(MoveTemp(waiter));
+		m_loader.RequestLoad(path, [this, path]()
+		{
+			Complete(path);
+		});
+		return future;
+	}
+
+	void Complete(const FSoftObjectPath& path)
+	{
+		//waiters are moved out first, as the resumed chains can request other loads
+		TArray<TUniqueFunction<void(UObject*)>> waiters;
+		m_pending.RemoveAndCopyValue(path, waiters);
+		UObject* asset = m_loader.Resolve(path);
+		for (TUniqueFunction<void(UObject*)>& waiter : waiters)
+		{
+			waiter(asset);
+		}
+	}
+};
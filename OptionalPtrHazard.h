@@ -0,0 +1,351 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+
+#include "CoreMinimal.h"
+#include "OptionalPtr.h"
+
+
+/**
+ * Hazard pointer reclamation of non-UObjects for readers which can stall, e.g. suspended coroutines, where
+ * FOptionalPtrEpochDomain would stop reclaiming altogether. Each hop through TOptionalPtrHazardPtr publishes the
+ * object in a hazard slot of the thread before it's read, so a stalled reader pins only the objects in its slots.
+ * Writers unlink the object first and then Retire it instead of deleting it.
+ */
+class FOptionalPtrHazardDomain
+{
+	friend class FOptionalPtrHazardScope;
+
+	struct FRetired
+	{
+		void* Object;
+		void (*Deleter)(void*);
+	};
+
+	//two slots per scope, a pair for each scope open at once on one thread
+	static constexpr int32 NumSlots = 16;
+
+	//each thread gets its own record, aligned to keep the records of different threads on different cache lines
+	struct alignas(64) FRecord
+	{
+		/**
+		 * Objects protected by the thread, each scope owns a pair of them which alternate, so each hop keeps the object
+		 * it starts from protected
+		 */
+		std::atomic<void*> Slots[NumSlots] = {};
+		std::atomic<bool> bInUse{true};
+		FRecord* Next = nullptr;
+		/** Bit per pair of slots owned by a scope */
+		uint32 UsedPairs = 0;
+		/** First slot of the innermost scope, INDEX_NONE outside of any scope */
+		int32 ScopeSlot = INDEX_NONE;
+		uint32 NextSlot = 0;
+		TArray<FRetired> Retired;
+	};
+
+	//releases the record when the thread exits, objects it retired are deleted by the next thread reusing the record
+	struct FThreadRecord
+	{
+		FRecord* Record = nullptr;
+
+		~FThreadRecord()
+		{
+			if (Record != nullptr)
+			{
+				Record->bInUse.store(false, std::memory_order_release);
+			}
+		}
+	};
+
+public:
+	/** Number of objects retired by a thread before it tries to delete them */
+	static constexpr int32 ReclaimThreshold = 64;
+
+	/** Maximum number of scopes open at once on one thread */
+	static constexpr int32 MaxScopes = NumSlots / 2;
+
+	FOptionalPtrHazardDomain(const FOptionalPtrHazardDomain&) = delete;
+	FOptionalPtrHazardDomain& operator=(const FOptionalPtrHazardDomain&) = delete;
+
+	/**
+	 * @return domain shared by all the chains
+	 */
+	static FOptionalPtrHazardDomain& Get()
+	{
+		static FOptionalPtrHazardDomain domain;
+		return domain;
+	}
+
+	/**
+	 * @brief Publishes the object the pointer points to in the next hazard slot of the innermost scope, so it can't be
+	 * deleted until the scope reuses the slot or ends
+	 * @tparam ObjectType type of the object (auto-deduced)
+	 * @param ptr pointer to the object, can be changed by other threads
+	 * @return protected object
+	 */
+	template<typename ObjectType>
+	FORCEINLINE ObjectType* Protect(const std::atomic<ObjectType*>& ptr)
+	{
+		FRecord& record = GetRecord();
+		checkfSlow(record.ScopeSlot != INDEX_NONE, TEXT("Hazard pointer is protected outside of FOptionalPtrHazardScope."));
+		std::atomic<void*>& slot = record.Slots[record.ScopeSlot + record.NextSlot];
+		record.NextSlot ^= 1;
+
+		ObjectType* obj = ptr.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			//the object has to be published before the pointer is checked again, exchange is a cheaper full barrier than a fence on x86
+			slot.exchange(const_cast<std::remove_cv_t<ObjectType>*>(obj), std::memory_order_seq_cst);
+			ObjectType* const current = ptr.load(std::memory_order_acquire);
+			if (current == obj)
+				return obj;
+
+			obj = current;
+		}
+	}
+
+	/**
+	 * @return true if the calling thread is inside a scope, false otherwise
+	 */
+	bool IsInScope()
+	{
+		return GetRecord().ScopeSlot != INDEX_NONE;
+	}
+
+	/**
+	 * @brief Deletes the object once it's not in any hazard slot, it has to be unlinked from all the objects chains can reach it from
+	 * @tparam ObjectType type of the object (auto-deduced)
+	 * @param obj object to delete
+	 */
+	template<typename ObjectType>
+	void Retire(ObjectType* obj)
+	{
+		static_assert(!std::is_base_of<UObject, std::remove_cv_t<ObjectType>>::value, "UObjects are reclaimed by the garbage collector.");
+
+		FRecord& record = GetRecord();
+		record.Retired.Add(FRetired{const_cast<std::remove_cv_t<ObjectType>*>(obj), &DeleteObject<std::remove_cv_t<ObjectType>>});
+		if (record.Retired.Num() >= ReclaimThreshold)
+		{
+			Reclaim();
+		}
+	}
+
+	/**
+	 * @brief Deletes objects retired by the calling thread which are not in any hazard slot
+	 * @return number of deleted objects
+	 */
+	int32 Reclaim()
+	{
+		FRecord& record = GetRecord();
+		if (record.Retired.Num() == 0)
+			return 0;
+
+		//hazards are collected into an array kept to reuse the allocation
+		static thread_local TArray<void*> hazards;
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		hazards.Reset();
+		for (FRecord* other = m_records.load(std::memory_order_acquire); other != nullptr; other = other->Next)
+		{
+			for (const std::atomic<void*>& slot : other->Slots)
+			{
+				if (void* const hazard = slot.load(std::memory_order_acquire))
+				{
+					hazards.Add(hazard);
+				}
+			}
+		}
+		std::sort(hazards.GetData(), hazards.GetData() + hazards.Num());
+
+		//objects in the slots stay retired, so each thread keeps at most ReclaimThreshold plus the number of slots
+		int32 num_kept = 0;
+		for (const FRetired& retired : record.Retired)
+		{
+			if (std::binary_search(hazards.GetData(), hazards.GetData() + hazards.Num(), retired.Object))
+			{
+				record.Retired[num_kept++] = retired;
+			}
+			else
+			{
+				retired.Deleter(retired.Object);
+			}
+		}
+		const int32 num_deleted = record.Retired.Num() - num_kept;
+		record.Retired.SetNum(num_kept);
+		return num_deleted;
+	}
+
+	/**
+	 * @return number of objects retired by the calling thread which are not deleted yet
+	 */
+	int32 GetNumRetired()
+	{
+		return GetRecord().Retired.Num();
+	}
+
+private:
+	//records are never freed, released ones are reused by new threads
+	std::atomic<FRecord*> m_records{nullptr};
+
+	FOptionalPtrHazardDomain() = default;
+
+	template<typename ObjectType>
+	static void DeleteObject(void* obj)
+	{
+		delete static_cast<ObjectType*>(obj);
+	}
+
+	FORCEINLINE FRecord& GetRecord()
+	{
+		static thread_local FThreadRecord thread_record;
+		if (UNLIKELY(thread_record.Record == nullptr))
+		{
+			thread_record.Record = AcquireRecord();
+		}
+		return *thread_record.Record;
+	}
+
+	FRecord* AcquireRecord()
+	{
+		for (FRecord* record = m_records.load(std::memory_order_acquire); record != nullptr; record = record->Next)
+		{
+			bool in_use = false;
+			if (!record->bInUse.load(std::memory_order_relaxed) && record->bInUse.compare_exchange_strong(in_use, true, std::memory_order_acquire))
+				return record;
+		}
+
+		FRecord* const record = new FRecord();
+		FRecord* head = m_records.load(std::memory_order_relaxed);
+		do
+		{
+			record->Next = head;
+		}
+		while (!m_records.compare_exchange_weak(head, record, std::memory_order_release, std::memory_order_relaxed));
+		return record;
+	}
+};
+
+/**
+ * Scope of the hops through TOptionalPtrHazardPtr, the objects protected within it are released when it ends.
+ * Each scope protects the objects in its own slots, so nested scopes never release the objects of the outer ones.
+ */
+class FOptionalPtrHazardScope
+{
+public:
+	FOptionalPtrHazardScope()
+		: m_record{FOptionalPtrHazardDomain::Get().GetRecord()}
+		, m_outer_slot{m_record.ScopeSlot}
+		, m_outer_next_slot{m_record.NextSlot}
+	{
+		//first pair no open scope owns, the slots of the outer scopes keep protecting their objects
+		int32 pair = 0;
+		while (pair < FOptionalPtrHazardDomain::MaxScopes && (m_record.UsedPairs & (1u << pair)) != 0)
+		{
+			++pair;
+		}
+		checkf(pair < FOptionalPtrHazardDomain::MaxScopes, TEXT("More than %d hazard scopes are open on the thread."), FOptionalPtrHazardDomain::MaxScopes);
+
+		m_pair = pair;
+		m_record.UsedPairs |= 1u << pair;
+		m_record.ScopeSlot = 2 * pair;
+		m_record.NextSlot = 0;
+	}
+
+	~FOptionalPtrHazardScope()
+	{
+		m_record.Slots[2 * m_pair].store(nullptr, std::memory_order_release);
+		m_record.Slots[2 * m_pair + 1].store(nullptr, std::memory_order_release);
+		m_record.UsedPairs &= ~(1u << m_pair);
+		m_record.ScopeSlot = m_outer_slot;
+		m_record.NextSlot = m_outer_next_slot;
+	}
+
+	FOptionalPtrHazardScope(const FOptionalPtrHazardScope&) = delete;
+	FOptionalPtrHazardScope& operator=(const FOptionalPtrHazardScope&) = delete;
+
+private:
+	FOptionalPtrHazardDomain::FRecord& m_record;
+	int32 m_pair = 0;
+	//slots the chains of the outer scope use again once this one ends
+	int32 m_outer_slot;
+	uint32 m_outer_next_slot;
+};
+
+/**
+ * Pointer to an object reclaimed by FOptionalPtrHazardDomain, Map through it protects the object before it's returned
+ */
+template<typename ObjectType>
+class TOptionalPtrHazardPtr
+{
+public:
+	TOptionalPtrHazardPtr(ObjectType* obj = nullptr) : m_ptr{obj} {}
+	TOptionalPtrHazardPtr(const TOptionalPtrHazardPtr&) = delete;
+	TOptionalPtrHazardPtr& operator=(const TOptionalPtrHazardPtr&) = delete;
+
+	/**
+	 * @return object pointed to, not protected
+	 */
+	ObjectType* Load() const
+	{
+		return m_ptr.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * @param obj object to point to
+	 */
+	void Store(ObjectType* obj)
+	{
+		m_ptr.store(obj, std::memory_order_release);
+	}
+
+	/**
+	 * @param obj object to point to
+	 * @return object pointed to before, to be retired
+	 */
+	ObjectType* Exchange(ObjectType* obj)
+	{
+		return m_ptr.exchange(obj, std::memory_order_acq_rel);
+	}
+
+	/**
+	 * @return object pointed to, protected until the scope reuses the hazard slot or ends
+	 */
+	FORCEINLINE ObjectType* Protect() const
+	{
+		return FOptionalPtrHazardDomain::Get().Protect(m_ptr);
+	}
+
+private:
+	std::atomic<ObjectType*> m_ptr;
+};
+
+//the pointer is shared with the writers, so it has to be read where it's stored
+template<typename Type>
+struct TOptionalPtrResolver<TOptionalPtrHazardPtr<Type>>
+{
+	using ObjectType = Type;
+	static constexpr bool bValidated = false;
+	static constexpr bool bBorrowed = true;
+
+	FORCEINLINE static Type* Resolve(const TOptionalPtrHazardPtr<Type>& ptr)
+	{
+		return ptr.Protect();
+	}
+};
+
+/**
+ * Validity policy of objects reclaimed by FOptionalPtrHazardDomain, checks the chain runs inside FOptionalPtrHazardScope
+ * @tparam BasePolicy policy validating the objects
+ */
+template<typename BasePolicy = FOptionalPtrDefaultPolicy>
+struct TOptionalPtrHazardPolicy
+{
+	using NextPolicy = TOptionalPtrHazardPolicy<typename BasePolicy::NextPolicy>;
+
+	template<typename Type>
+	FORCEINLINE static bool IsValidObj(const Type* obj)
+	{
+		checkfSlow(FOptionalPtrHazardDomain::Get().IsInScope(), TEXT("Chain of hazard pointer reclaimed objects runs outside of FOptionalPtrHazardScope."));
+		return BasePolicy::IsValidObj(obj);
+	}
+};
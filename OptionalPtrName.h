@@ -0,0 +1,234 @@
+#pragma once
+
+#include <atomic>
+
+#include "CoreMinimal.h"
+
+
+/**
+ * @brief 64-bit FNV-1a hash of the name, usable at compile time. Each code unit is hashed as its value, so narrow and
+ * wide literals of the same ASCII name hash the same.
+ * @param name name to hash
+ * @param length number of code units of the name
+ * @return hash of the name
+ */
+template<typename CharType>
+constexpr uint64 OptionalPtrNameHash(const CharType* name, SIZE_T length)
+{
+	uint64 hash = 0xcbf29ce484222325ull;
+	for (SIZE_T i = 0; i < length; ++i)
+	{
+		hash ^= static_cast<uint64>(name[i]);
+		hash *= 0x100000001b3ull;
+	}
+	return hash;
+}
+
+namespace OptionalPtrLiterals
+{
+	/**
+	 * @brief Compile-time hash of the name literal, e.g. MapFind<"Health"_h>(...)
+	 */
+	constexpr uint64 operator""_h(const char* name, SIZE_T length)
+	{
+		return OptionalPtrNameHash(name, length);
+	}
+}
+
+/**
+ * Global table of interned names, mapping their hashes to small runtime ids. Interning and lookups are lock-free,
+ * the table is open addressed with fixed capacity and names are never removed.
+ */
+class FOptionalPtrNameTable
+{
+	struct FSlot
+	{
+		std::atomic<uint64> Hash{0};
+		std::atomic<const TCHAR*> Name{nullptr};
+	};
+
+public:
+	static constexpr int32 Capacity = 1 << 16;
+
+	//function static, so the table exists before any name is interned during static initialization
+	static FOptionalPtrNameTable& Get()
+	{
+		static FOptionalPtrNameTable table;
+		return table;
+	}
+
+	/**
+	 * @brief Interns the name, copying it if it's not interned yet
+	 * @param name name to intern
+	 * @return id of the name, INDEX_NONE if a different name with the same hash is already interned
+	 */
+	int32 Intern(const TCHAR* name)
+	{
+		return Intern(name, OptionalPtrNameHash(name, FCString::Strlen(name)));
+	}
+
+	/**
+	 * @brief Interns the name with the already calculated hash, copying it if it's not interned yet
+	 * @param name name to intern
+	 * @param hash hash of the name calculated by OptionalPtrNameHash
+	 * @return id of the name, INDEX_NONE if a different name with the same hash is already interned
+	 */
+	int32 Intern(const TCHAR* name, uint64 hash)
+	{
+		hash = ToSlotHash(hash);
+		for (int32 probe = 0, index = SlotIndex(hash); probe < Capacity; ++probe, index = (index + 1) & (Capacity - 1))
+		{
+			FSlot& slot = m_slots[index];
+			uint64 slot_hash = slot.Hash.load(std::memory_order_acquire);
+			if (slot_hash == 0 && slot.Hash.compare_exchange_strong(slot_hash, hash, std::memory_order_acq_rel))
+			{
+				slot.Name.store(CopyName(name), std::memory_order_release);
+				return index;
+			}
+
+			if (slot_hash == hash)
+			{
+				//another thread may have claimed the slot but not published the name yet
+				const TCHAR* slot_name;
+				while ((slot_name = slot.Name.load(std::memory_order_acquire)) == nullptr)
+				{
+					FPlatformProcess::Yield();
+				}
+				return ensureMsgf(FCString::Strcmp(slot_name, name) == 0,
+					TEXT("Names %s and %s have the same hash."), slot_name, name) ? index : INDEX_NONE;
+			}
+		}
+
+		checkf(false, TEXT("Optional pointer name table is full."));
+		return INDEX_NONE;
+	}
+
+	/**
+	 * @param hash hash of the name calculated by OptionalPtrNameHash
+	 * @return id of the name, INDEX_NONE if the name is not interned
+	 */
+	int32 Find(uint64 hash) const
+	{
+		hash = ToSlotHash(hash);
+		for (int32 probe = 0, index = SlotIndex(hash); probe < Capacity; ++probe, index = (index + 1) & (Capacity - 1))
+		{
+			const uint64 slot_hash = m_slots[index].Hash.load(std::memory_order_acquire);
+			if (slot_hash == hash)
+				return index;
+			if (slot_hash == 0)
+				return INDEX_NONE;
+		}
+		return INDEX_NONE;
+	}
+
+	/**
+	 * @param id id of the interned name
+	 * @return interned name, nullptr if not published yet
+	 */
+	const TCHAR* GetName(int32 id) const
+	{
+		return m_slots[id].Name.load(std::memory_order_acquire);
+	}
+
+private:
+	TUniquePtr<FSlot[]> m_slots{new FSlot[Capacity]};
+
+	FOptionalPtrNameTable() = default;
+
+	//zero marks an empty slot
+	FORCEINLINE static uint64 ToSlotHash(uint64 hash)
+	{
+		return hash != 0 ? hash : 1;
+	}
+
+	FORCEINLINE static int32 SlotIndex(uint64 hash)
+	{
+		return static_cast<int32>((hash ^ (hash >> 32)) & (Capacity - 1));
+	}
+
+	static const TCHAR* CopyName(const TCHAR* name)
+	{
+		const int32 length = FCString::Strlen(name);
+		TCHAR* copy = new TCHAR[length + 1];
+		FMemory::Memcpy(copy, name, (length + 1) * sizeof(TCHAR));
+		return copy;
+	}
+};
+
+/**
+ * Interned name comparable by a single integer compare, meant as a key of maps looked up by literal names through
+ * MapFind<"Name"_h>. Names constructed from strings are interned, names used only as literals can be interned during
+ * static initialization by OPTIONAL_PTR_NAME.
+ */
+class FOptionalPtrName
+{
+public:
+	FOptionalPtrName() = default;
+
+	explicit FOptionalPtrName(const TCHAR* name) : m_id{FOptionalPtrNameTable::Get().Intern(name)} {}
+
+	explicit FOptionalPtrName(const FString& name) : FOptionalPtrName(*name) {}
+
+	/**
+	 * @brief Finds the name with the given compile-time hash, the id is cached once the name is interned
+	 * @tparam NameHash hash of the name, e.g. "Health"_h
+	 * @return interned name, none if the name is not interned yet
+	 */
+	template<uint64 NameHash>
+	FORCEINLINE static FOptionalPtrName FromHash()
+	{
+		//constant initialized, so no guard is needed, and not cached while missing as the name can be interned later
+		static std::atomic<int32> cached_id{INDEX_NONE};
+		int32 id = cached_id.load(std::memory_order_relaxed);
+		if (id == INDEX_NONE)
+		{
+			id = FOptionalPtrNameTable::Get().Find(NameHash);
+			cached_id.store(id, std::memory_order_relaxed);
+		}
+		return FOptionalPtrName(FIdTag{}, id);
+	}
+
+	bool IsNone() const
+	{
+		return m_id == INDEX_NONE;
+	}
+
+	int32 GetId() const
+	{
+		return m_id;
+	}
+
+	FString ToString() const
+	{
+		return IsNone() ? FString() : FString(FOptionalPtrNameTable::Get().GetName(m_id));
+	}
+
+	bool operator==(const FOptionalPtrName& rhs) const
+	{
+		return m_id == rhs.m_id;
+	}
+
+	bool operator!=(const FOptionalPtrName& rhs) const
+	{
+		return m_id != rhs.m_id;
+	}
+
+	//ids are slot indices derived from the hash of the name, so they are already well distributed
+	friend uint32 GetTypeHash(const FOptionalPtrName& name)
+	{
+		return static_cast<uint32>(name.m_id);
+	}
+
+private:
+	//tells the constructor from an already interned id apart from the public constructors from the name
+	struct FIdTag {};
+
+	int32 m_id = INDEX_NONE;
+
+	FOptionalPtrName(FIdTag, int32 id) : m_id{id} {}
+};
+
+/**
+ * Interns the name during static initialization and declares FOptionalPtrName variable OptionalPtrName_<Name> for it
+ */
+#define OPTIONAL_PTR_NAME(Name) static const FOptionalPtrName OptionalPtrName_##Name(TEXT(#Name))
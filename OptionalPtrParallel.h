@@ -0,0 +1,98 @@
+#pragma once
+
+#include <type_traits>
+
+#include "CoreMinimal.h"
+#include "Async/ParallelFor.h"
+#include "OptionalPtr.h"
+
+
+/**
+ * Order the objects of IfPresentAll are assigned to the buckets in
+ */
+enum class EOptionalPtrParallelOrder : uint8
+{
+	/** Hash of the conflict key, cheapest but depends on the key values, e.g. addresses of the objects */
+	Any,
+	/** Order the conflict keys first appear in, the same buckets for the same input, e.g. when replaying */
+	Deterministic
+};
+
+/** Number of buckets IfPresentAll splits the objects into, independent of the number of worker threads */
+static constexpr int32 OptionalPtrParallelBuckets = 64;
+
+/** Minimal number of objects per bucket for IfPresentAll to dispatch the buckets to worker threads */
+static constexpr int32 OptionalPtrParallelMinObjectsPerBucket = 16;
+
+/**
+ * @brief Applies given member function to all the valid objects in parallel. Objects with the same conflict key are
+ * put into the same bucket and called in the order of the array on the same thread, so the calls of different buckets
+ * must not touch the same data, e.g. key of the owning actor for calls modifying the actor.
+ * @tparam ObjectType type of the objects (auto-deduced)
+ * @tparam KeyFuncType type of callable returning the conflict key of the object, hashable by GetTypeHash (auto-deduced)
+ * @tparam FuncType type of member function (auto-deduced)
+ * @tparam Args types of arguments provided to the member function (auto-deduced)
+ * @param objects objects to apply the member function on, objects which are not valid are skipped
+ * @param key_func callable returning the conflict key of the object, called on the calling thread
+ * @param order order the objects are assigned to the buckets in
+ * @param func member function to apply on the objects
+ * @param args arguments provided to the member function, shared by all the calls
+ * @return number of objects the member function was applied on
+ */
+template<typename ObjectType, typename KeyFuncType, typename FuncType, typename... Args>
+int32 IfPresentAll(const TArray<ObjectType*>& objects, KeyFuncType&& key_func, EOptionalPtrParallelOrder order, FuncType func, const Args&... args)
+{
+	using KeyType = std::decay_t<decltype(key_func(std::declval<ObjectType*>()))>;
+
+	//objects are validated and bucketed on the calling thread, the workers only make the calls
+	TArray<ObjectType*> valid_objects;
+	TArray<uint8> buckets;
+	valid_objects.Reserve(objects.Num());
+	buckets.Reserve(objects.Num());
+	TMap<KeyType, uint8> first_buckets;
+	for (ObjectType* obj : objects)
+	{
+		if (!MakeUncountedOptionalPtr(obj).IsSet())
+			continue;
+
+		const KeyType key = key_func(obj);
+		if (order == EOptionalPtrParallelOrder::Deterministic)
+		{
+			const uint8* bucket = first_buckets.Find(key);
+			buckets.Add(bucket ? *bucket : first_buckets.Add(key, first_buckets.Num() % OptionalPtrParallelBuckets));
+		}
+		else
+		{
+			buckets.Add(GetTypeHash(key) % OptionalPtrParallelBuckets);
+		}
+		valid_objects.Add(obj);
+	}
+
+	//stable counting sort keeps the order of the array within the bucket
+	int32 offsets[OptionalPtrParallelBuckets + 1] = {};
+	for (const uint8 bucket : buckets)
+	{
+		++offsets[bucket + 1];
+	}
+	for (int32 bucket = 1; bucket <= OptionalPtrParallelBuckets; ++bucket)
+	{
+		offsets[bucket] += offsets[bucket - 1];
+	}
+	TArray<ObjectType*> sorted_objects;
+	sorted_objects.SetNumUninitialized(valid_objects.Num());
+	int32 tops[OptionalPtrParallelBuckets];
+	FMemory::Memcpy(tops, offsets, sizeof(tops));
+	for (int32 i = 0; i < valid_objects.Num(); ++i)
+	{
+		sorted_objects[tops[buckets[i]]++] = valid_objects[i];
+	}
+
+	ParallelFor(OptionalPtrParallelBuckets, [&](int32 bucket)
+	{
+		for (int32 i = offsets[bucket]; i < offsets[bucket + 1]; ++i)
+		{
+			(sorted_objects[i]->*func)(args...);
+		}
+	}, valid_objects.Num() < OptionalPtrParallelBuckets * OptionalPtrParallelMinObjectsPerBucket);
+	return valid_objects.Num();
+}
@@ -0,0 +1,447 @@
+#pragma once
+
+#include <type_traits>
+
+#include "CoreMinimal.h"
+#include "UObject/UnrealType.h"
+#include "OptionalPtr.h"
+
+
+/**
+ * One hop of a compiled path, filled in by the reflection policy
+ */
+struct FOptionalPtrPathStep
+{
+	/** Offset of the field in its owner, or of the return value in the parameters of a getter */
+	int32 Offset = 0;
+	/** Size of the value the step reads */
+	int32 ValueSize = 0;
+	/** Policy specific key of the type of the value the step reads, compared with the requested one before reading */
+	const void* ValueTypeKey = nullptr;
+	/** Reflected member the step was compiled from (property, function, ...), interpreted only by the policy */
+	const void* Member = nullptr;
+	/** Policy specific kind of the step */
+	uint8 Kind = 0;
+};
+
+/**
+ * Path compiled into a plan of reflection steps, the names are looked up only once when compiling
+ */
+struct FOptionalPtrPath
+{
+	FString Source;
+	const void* RootType = nullptr;
+	TArray<FOptionalPtrPathStep> Steps;
+	/** Whether the last step returns object, value otherwise */
+	bool bLeafIsObject = false;
+	/** Names the type of the last object didn't have, resolved against the type the object has at run-time, e.g. members of subclasses */
+	FString DynamicTail;
+	uint32 DynamicTailHash = 0;
+
+	/**
+	 * @return true if the path compiled, false if any of its names couldn't be resolved
+	 */
+	bool IsValid() const
+	{
+		return Steps.Num() > 0;
+	}
+
+	/**
+	 * @return true if the rest of the path has to be compiled against the object reached by the steps
+	 */
+	bool HasDynamicTail() const
+	{
+		return !DynamicTail.IsEmpty();
+	}
+};
+
+/**
+ * Maps type of the value read at the end of the path to the type of the property it can be read from
+ */
+template<typename ValueType, typename = void>
+struct TOptionalPtrPropertyType
+{
+	static_assert(sizeof(ValueType) == 0, "Only numeric, FName and struct values can be resolved by reflection.");
+};
+
+#define OPTIONAL_PTR_PROPERTY_TYPE(ValueType, PropertyType) \
+	template<> \
+	struct TOptionalPtrPropertyType<ValueType> \
+	{ \
+		static const void* Get() { return PropertyType::StaticClass(); } \
+	};
+
+OPTIONAL_PTR_PROPERTY_TYPE(int8, FInt8Property)
+OPTIONAL_PTR_PROPERTY_TYPE(int16, FInt16Property)
+OPTIONAL_PTR_PROPERTY_TYPE(int32, FIntProperty)
+OPTIONAL_PTR_PROPERTY_TYPE(int64, FInt64Property)
+OPTIONAL_PTR_PROPERTY_TYPE(uint8, FByteProperty)
+OPTIONAL_PTR_PROPERTY_TYPE(uint16, FUInt16Property)
+OPTIONAL_PTR_PROPERTY_TYPE(uint32, FUInt32Property)
+OPTIONAL_PTR_PROPERTY_TYPE(uint64, FUInt64Property)
+OPTIONAL_PTR_PROPERTY_TYPE(float, FFloatProperty)
+OPTIONAL_PTR_PROPERTY_TYPE(double, FDoubleProperty)
+OPTIONAL_PTR_PROPERTY_TYPE(FName, FNameProperty)
+
+#undef OPTIONAL_PTR_PROPERTY_TYPE
+
+//structs are keyed by the struct itself as all of them are read from FStructProperty
+template<typename ValueType>
+struct TOptionalPtrPropertyType<ValueType, std::enable_if_t<std::is_class<ValueType>::value, decltype(void(TBaseStructure<ValueType>::Get()))>>
+{
+	static const void* Get() { return TBaseStructure<ValueType>::Get(); }
+};
+
+/**
+ * Reflection policy of TOptionalPtrPathResolver over UObject properties and functions.
+ * Path segments resolve to properties first, then to functions with no parameters and then to such functions
+ * prefixed by Get, e.g. "FirstPlayerController" can be bound to GetFirstPlayerController. Only object properties
+ * can be followed and only plain old data values can be read at the end of the path, only from properties of the same type.
+ */
+struct FOptionalPtrUObjectReflection
+{
+	using ObjectType = UObject;
+
+	enum EStepKind : uint8
+	{
+		Field,
+		Getter
+	};
+
+	FORCEINLINE static const void* GetType(const UObject* obj)
+	{
+		return obj->GetClass();
+	}
+
+	FORCEINLINE static bool IsValidObj(const void* obj)
+	{
+		return IsValid(static_cast<const UObject*>(obj));
+	}
+
+	template<typename ValueType>
+	FORCEINLINE static const void* GetValueTypeKey()
+	{
+		return TOptionalPtrPropertyType<ValueType>::Get();
+	}
+
+	static bool CompileStep(const void* type, const FString& name, FOptionalPtrPathStep& out_step, const void*& out_next_type)
+	{
+		const UClass* type_class = static_cast<const UClass*>(type);
+		const FName member_name(*name);
+
+		if (const FProperty* property = type_class->FindPropertyByName(member_name))
+		{
+			out_step.Kind = Field;
+			out_step.Member = property;
+			out_step.Offset = property->GetOffset_ForInternal();
+			return CompileValue(property, out_step, out_next_type);
+		}
+
+		const UFunction* function = type_class->FindFunctionByName(member_name);
+		if (function == nullptr)
+		{
+			function = type_class->FindFunctionByName(FName(*(FString(TEXT("Get")) + name)));
+		}
+
+		const FProperty* return_property = function ? function->GetReturnProperty() : nullptr;
+		if (return_property == nullptr || function->NumParms != 1)
+			return false;
+
+		out_step.Kind = Getter;
+		out_step.Member = function;
+		out_step.Offset = return_property->GetOffset_ForUFunction();
+		return CompileValue(return_property, out_step, out_next_type);
+	}
+
+	FORCEINLINE static void* LoadObject(void* obj, const FOptionalPtrPathStep& step)
+	{
+		if (step.Kind == Field)
+			return *reinterpret_cast<UObject**>(static_cast<uint8*>(obj) + step.Offset);
+
+		UObject* result;
+		CallGetter(obj, step, &result);
+		return result;
+	}
+
+	FORCEINLINE static void LoadValue(void* obj, const FOptionalPtrPathStep& step, void* out_value)
+	{
+		if (step.Kind == Field)
+		{
+			FMemory::Memcpy(out_value, static_cast<uint8*>(obj) + step.Offset, step.ValueSize);
+			return;
+		}
+
+		CallGetter(obj, step, out_value);
+	}
+
+	template<typename CastType>
+	FORCEINLINE static CastType* CastObj(void* obj)
+	{
+		return Cast<std::remove_cv_t<CastType>>(static_cast<UObject*>(obj));
+	}
+
+private:
+	static bool CompileValue(const FProperty* property, FOptionalPtrPathStep& out_step, const void*& out_next_type)
+	{
+		out_step.ValueSize = property->ElementSize;
+		if (const FObjectProperty* object_property = CastField<FObjectProperty>(property))
+		{
+			out_next_type = object_property->PropertyClass;
+			return true;
+		}
+
+		const FStructProperty* struct_property = CastField<FStructProperty>(property);
+		out_step.ValueTypeKey = struct_property ? static_cast<const void*>(struct_property->Struct) : property->GetClass();
+		//values are copied byte-wise, anything needing a copy constructor or destructor is not supported
+		out_next_type = nullptr;
+		return property->HasAnyPropertyFlags(CPF_IsPlainOldData);
+	}
+
+	//not inlined, so the parameters are allocated once per call instead of once per loop the call is inlined into
+	static FORCENOINLINE void CallGetter(void* obj, const FOptionalPtrPathStep& step, void* out_value)
+	{
+		UFunction* function = const_cast<UFunction*>(static_cast<const UFunction*>(step.Member));
+		const FProperty* return_property = function->GetReturnProperty();
+		uint8* params = static_cast<uint8*>(FMemory_Alloca_Aligned(function->ParmsSize, function->GetMinAlignment()));
+		FMemory::Memzero(params, function->ParmsSize);
+		return_property->InitializeValue_InContainer(params);
+		static_cast<UObject*>(obj)->ProcessEvent(function, params);
+		FMemory::Memcpy(out_value, params + step.Offset, step.ValueSize);
+		return_property->DestroyValue_InContainer(params);
+	}
+};
+
+/**
+ * Resolves dotted string paths such as "FirstPlayerController.Pawn.HealthComponent.Health" against a root object.
+ * Each path is compiled only once per root type into a plan of cached offsets and getters, later resolutions only
+ * look the plan up by the hash of the path and execute it, validating every object on the way. Names the declared type
+ * of an object doesn't have are compiled against the type the object has at run-time, so members of subclasses resolve too.
+ * @tparam ReflectionType policy providing the reflection, see FOptionalPtrUObjectReflection
+ */
+template<typename ReflectionType = FOptionalPtrUObjectReflection>
+class TOptionalPtrPathResolver
+{
+public:
+	using ObjectType = typename ReflectionType::ObjectType;
+
+	/**
+	 * @brief Resolves the path ending with a value
+	 * @tparam ValueType type of the value at the end of the path, has to be trivially copyable
+	 * @param root object the path starts from
+	 * @param path dot separated names of the fields or getters to follow
+	 * @param default_value value returned if any object on the way is invalid or the path doesn't resolve to ValueType
+	 * @return value at the end of the path or default_value
+	 */
+	template<typename ValueType>
+	ValueType ResolveValue(ObjectType* root, const FString& path, const ValueType& default_value)
+	{
+		const FOptionalPtrPath* plan = FindOrCompile(root, path);
+		return plan ? EvaluateValue(*plan, root, default_value) : default_value;
+	}
+
+	/**
+	 * @brief Resolves the path ending with an object
+	 * @tparam ResultType type of the object at the end of the path
+	 * @param root object the path starts from
+	 * @param path dot separated names of the fields or getters to follow
+	 * @return object at the end of the path wrapped in TOptionalPtr, empty optional if not resolved or not of ResultType
+	 */
+	template<typename ResultType>
+	TOptionalPtr<ResultType> ResolveObject(ObjectType* root, const FString& path)
+	{
+		const FOptionalPtrPath* plan = FindOrCompile(root, path);
+		return plan ? EvaluateObject<ResultType>(*plan, root) : MakeUncountedOptionalPtr<ResultType>(nullptr);
+	}
+
+	/**
+	 * @brief Finds the plan of the path for the type of the root, compiles and caches it if not compiled yet.
+	 * The returned plan stays valid until Empty is called and can be kept to skip the lookup in hot code.
+	 * @param root object the path starts from
+	 * @param path dot separated names of the fields or getters to follow
+	 * @return compiled plan, nullptr if root is invalid or the path doesn't compile against the type of the root
+	 */
+	const FOptionalPtrPath* FindOrCompile(const ObjectType* root, const FString& path)
+	{
+		return FindOrCompile(root, path, GetTypeHash(path));
+	}
+
+	/**
+	 * @brief Executes the compiled plan ending with a value
+	 * @tparam ValueType type of the value at the end of the path, has to be trivially copyable
+	 * @param plan plan compiled for the type of the root
+	 * @param root object the path starts from
+	 * @param default_value value returned if any object on the way is invalid or the path doesn't resolve to ValueType
+	 * @return value at the end of the path or default_value
+	 */
+	template<typename ValueType>
+	ValueType EvaluateValue(const FOptionalPtrPath& plan, ObjectType* root, const ValueType& default_value)
+	{
+		static_assert(std::is_trivially_copyable<ValueType>::value, "Only trivially copyable values can be resolved.");
+
+		if (!plan.IsValid())
+			return default_value;
+
+		if (plan.HasDynamicTail())
+		{
+			ObjectType* tail_root = FollowSteps(plan, root, plan.Steps.Num());
+			const FOptionalPtrPath* tail = tail_root ? FindOrCompile(tail_root, plan.DynamicTail, plan.DynamicTailHash) : nullptr;
+			return tail ? EvaluateValue(*tail, tail_root, default_value) : default_value;
+		}
+
+		const FOptionalPtrPathStep& leaf = plan.Steps.Last();
+		if (plan.bLeafIsObject || leaf.ValueTypeKey != ReflectionType::template GetValueTypeKey<ValueType>() || leaf.ValueSize != sizeof(ValueType))
+			return default_value;
+
+		ObjectType* owner = FollowSteps(plan, root, plan.Steps.Num() - 1);
+		if (owner == nullptr)
+			return default_value;
+
+		ValueType value;
+		ReflectionType::LoadValue(owner, leaf, &value);
+		return value;
+	}
+
+	/**
+	 * @brief Executes the compiled plan ending with an object
+	 * @tparam ResultType type of the object at the end of the path
+	 * @param plan plan compiled for the type of the root
+	 * @param root object the path starts from
+	 * @return object at the end of the path wrapped in TOptionalPtr, empty optional if not resolved or not of ResultType
+	 */
+	template<typename ResultType>
+	TOptionalPtr<ResultType> EvaluateObject(const FOptionalPtrPath& plan, ObjectType* root)
+	{
+		if (!plan.IsValid())
+			return MakeUncountedOptionalPtr<ResultType>(nullptr);
+
+		if (plan.HasDynamicTail())
+		{
+			ObjectType* tail_root = FollowSteps(plan, root, plan.Steps.Num());
+			const FOptionalPtrPath* tail = tail_root ? FindOrCompile(tail_root, plan.DynamicTail, plan.DynamicTailHash) : nullptr;
+			return tail ? EvaluateObject<ResultType>(*tail, tail_root) : MakeUncountedOptionalPtr<ResultType>(nullptr);
+		}
+
+		if (!plan.bLeafIsObject)
+			return MakeUncountedOptionalPtr<ResultType>(nullptr);
+
+		ObjectType* owner = FollowSteps(plan, root, plan.Steps.Num() - 1);
+		if (owner == nullptr)
+			return MakeUncountedOptionalPtr<ResultType>(nullptr);
+
+		void* leaf = ReflectionType::LoadObject(owner, plan.Steps.Last());
+		return MakeUncountedOptionalPtr<ResultType>(ReflectionType::IsValidObj(leaf) ? ReflectionType::template CastObj<ResultType>(leaf) : nullptr);
+	}
+
+	/**
+	 * @return number of cached plans, including the ones of paths which failed to compile
+	 */
+	int32 Num() const
+	{
+		return m_plans.Num() + m_collided_plans.Num();
+	}
+
+	/**
+	 * @brief Removes all the cached plans, invalidating all the plans returned by FindOrCompile
+	 */
+	void Empty()
+	{
+		m_plans.Reset();
+		m_collided_plans.Reset();
+	}
+
+private:
+	TMap<uint32, TUniquePtr<FOptionalPtrPath>> m_plans;
+	//plans of paths whose hash collided with an already cached one, searched linearly as they are very rare
+	TArray<TUniquePtr<FOptionalPtrPath>> m_collided_plans;
+
+	const FOptionalPtrPath* FindOrCompile(const ObjectType* root, const FString& path, uint32 path_hash)
+	{
+		if (!ReflectionType::IsValidObj(root))
+			return nullptr;
+
+		const void* root_type = ReflectionType::GetType(root);
+		const uint32 hash = HashCombine(path_hash, GetTypeHash(root_type));
+		if (const TUniquePtr<FOptionalPtrPath>* cached = m_plans.Find(hash))
+		{
+			const FOptionalPtrPath& plan = **cached;
+			if (plan.RootType == root_type && plan.Source == path)
+				return plan.IsValid() ? &plan : nullptr;
+
+			return FindOrCompileCollided(root_type, path);
+		}
+
+		//failed compilations are cached too, so a misspelled path costs only a lookup
+		const FOptionalPtrPath& plan = *m_plans.Add(hash, MakeUnique<FOptionalPtrPath>(Compile(root_type, path)));
+		return plan.IsValid() ? &plan : nullptr;
+	}
+
+	const FOptionalPtrPath* FindOrCompileCollided(const void* root_type, const FString& path)
+	{
+		for (const TUniquePtr<FOptionalPtrPath>& collided : m_collided_plans)
+		{
+			if (collided->RootType == root_type && collided->Source == path)
+				return collided->IsValid() ? collided.Get() : nullptr;
+		}
+
+		const FOptionalPtrPath& plan = *m_collided_plans.Add_GetRef(MakeUnique<FOptionalPtrPath>(Compile(root_type, path)));
+		return plan.IsValid() ? &plan : nullptr;
+	}
+
+	static FOptionalPtrPath Compile(const void* root_type, const FString& path)
+	{
+		FOptionalPtrPath plan;
+		plan.Source = path;
+		plan.RootType = root_type;
+
+		TArray<FString> names;
+		path.ParseIntoArray(names, TEXT("."));
+
+		const void* type = root_type;
+		int32 name_start = 0;
+		for (const FString& name : names)
+		{
+			FOptionalPtrPathStep step;
+			const void* next_type = nullptr;
+			//null type means the previous name resolved to a value, only the last one can
+			if (type == nullptr)
+			{
+				plan.Steps.Reset();
+				return plan;
+			}
+
+			if (!ReflectionType::CompileStep(type, name, step, next_type))
+			{
+				//the type of the root is already the one it has at run-time, the other objects can be of subclasses
+				if (plan.Steps.Num() == 0)
+					return plan;
+
+				plan.DynamicTail = path.RightChop(name_start);
+				plan.DynamicTailHash = GetTypeHash(plan.DynamicTail);
+				return plan;
+			}
+
+			plan.Steps.Add(step);
+			type = next_type;
+			name_start += name.Len() + 1;
+		}
+
+		plan.bLeafIsObject = type != nullptr;
+		return plan;
+	}
+
+	//validates and follows the first num_steps steps, returns the object reached
+	FORCEINLINE static ObjectType* FollowSteps(const FOptionalPtrPath& plan, ObjectType* root, int32 num_steps)
+	{
+		if (!ReflectionType::IsValidObj(root) || ReflectionType::GetType(root) != plan.RootType)
+			return nullptr;
+
+		void* current = root;
+		for (int32 i = 0; i < num_steps; ++i)
+		{
+			current = ReflectionType::LoadObject(current, plan.Steps[i]);
+			if (!ReflectionType::IsValidObj(current))
+				return nullptr;
+		}
+		return static_cast<ObjectType*>(current);
+	}
+};
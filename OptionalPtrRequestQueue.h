@@ -0,0 +1,169 @@
+#pragma once
+
+#include <atomic>
+
+#include "CoreMinimal.h"
+#include "OptionalPtr.h"
+#include "OptionalPtrChain.h"
+
+
+/**
+ * Request to execute TOptionalPtrChain on the game thread, queued by FOptionalPtrRequestQueue. The request is owned
+ * by the requesting thread and is itself the node of the queue, so queuing it doesn't allocate. It has to outlive
+ * the drain of the queue and can be queued again once ready.
+ */
+class FOptionalPtrRequest
+{
+	friend class FOptionalPtrRequestQueue;
+
+public:
+	FOptionalPtrRequest() = default;
+	FOptionalPtrRequest(const FOptionalPtrRequest&) = delete;
+	FOptionalPtrRequest& operator=(const FOptionalPtrRequest&) = delete;
+
+	/**
+	 * @return true if the chain was executed and the result can be read, false otherwise
+	 */
+	bool IsReady() const
+	{
+		return m_ready.load(std::memory_order_acquire);
+	}
+
+protected:
+	void* GetResult() const
+	{
+		checkf(IsReady(), TEXT("Result of the request is read before the queue is drained."));
+		return m_result;
+	}
+
+private:
+	const FOptionalPtrChain* m_chain = nullptr;
+	void* m_root = nullptr;
+	void* m_result = nullptr;
+	FOptionalPtrRequest* m_next = nullptr;
+	std::atomic<bool> m_ready{false};
+};
+
+/**
+ * Request to execute chain ending with ResultType
+ */
+template<typename ResultType>
+class TOptionalPtrRequest : public FOptionalPtrRequest
+{
+public:
+	/**
+	 * @return object at the end of the chain wrapped in TOptionalPtr, validated when the chain was executed on the game thread,
+	 * so it isn't validated again on the requesting thread
+	 */
+	TOptionalPtr<ResultType, TOptionalPtrResolvedPolicy<>> Get() const
+	{
+		return MakeUncountedOptionalPtr<ResultType, TOptionalPtrResolvedPolicy<>>(static_cast<ResultType*>(GetResult()));
+	}
+};
+
+/**
+ * Lock-free multi-producer single-consumer queue of chain requests. Any thread can queue the requests, the game thread
+ * executes all of them in one batch per drain, e.g. once per frame, instead of dispatching a task per request.
+ * Requests of the same chain from the same root queued for the same drain are executed only once.
+ */
+class FOptionalPtrRequestQueue
+{
+	struct FRequestKey
+	{
+		const FOptionalPtrChain* Chain;
+		void* Root;
+
+		bool operator==(const FRequestKey& other) const
+		{
+			return Chain == other.Chain && Root == other.Root;
+		}
+
+		friend uint32 GetTypeHash(const FRequestKey& key)
+		{
+			return HashCombine(GetTypeHash(key.Chain), GetTypeHash(key.Root));
+		}
+	};
+
+public:
+	FOptionalPtrRequestQueue() = default;
+	FOptionalPtrRequestQueue(const FOptionalPtrRequestQueue&) = delete;
+	FOptionalPtrRequestQueue& operator=(const FOptionalPtrRequestQueue&) = delete;
+
+	/**
+	 * @brief Queues execution of the chain, can be called from any thread
+	 * @param chain chain to execute, has to outlive the drain of the queue
+	 * @param root object the chain starts from
+	 * @param request request receiving the result, has to outlive the drain of the queue
+	 */
+	template<typename RootType, typename ResultType>
+	void Enqueue(const TOptionalPtrChain<RootType, ResultType>& chain, RootType* root, TOptionalPtrRequest<ResultType>& request)
+	{
+		//queued request is already linked into the queue, queuing it again would make a cycle
+		checkSlow(request.m_chain == nullptr || request.IsReady());
+		request.m_chain = &chain.GetBytecode();
+		request.m_root = const_cast<std::remove_cv_t<RootType>*>(root);
+		request.m_ready.store(false, std::memory_order_relaxed);
+
+		FOptionalPtrRequest* head = m_head.load(std::memory_order_relaxed);
+		do
+		{
+			request.m_next = head;
+		}
+		while (!m_head.compare_exchange_weak(head, &request, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	/**
+	 * @brief Executes all the queued requests in the order they were queued, has to be called on the game thread
+	 * @return number of executed chains, duplicate requests are not counted
+	 */
+	int32 Drain()
+	{
+		check(IsInGameThread());
+
+		//the queue is a stack, the batch is reversed to execute the requests in the order they were queued
+		FOptionalPtrRequest* batch = nullptr;
+		FOptionalPtrRequest* request = m_head.exchange(nullptr, std::memory_order_acquire);
+		while (request != nullptr)
+		{
+			FOptionalPtrRequest* const next = request->m_next;
+			request->m_next = batch;
+			batch = request;
+			request = next;
+		}
+
+		int32 num_executed = 0;
+		m_results.Reset();
+		while (batch != nullptr)
+		{
+			//the request can be queued again or destroyed by its owner as soon as it's ready
+			FOptionalPtrRequest* const next = batch->m_next;
+			const FRequestKey key{batch->m_chain, batch->m_root};
+			if (void** const result = m_results.Find(key))
+			{
+				batch->m_result = *result;
+			}
+			else
+			{
+				batch->m_result = batch->m_chain->Execute(batch->m_root);
+				m_results.Add(key, batch->m_result);
+				++num_executed;
+			}
+			batch->m_ready.store(true, std::memory_order_release);
+			batch = next;
+		}
+		return num_executed;
+	}
+
+	/**
+	 * @return true if there are no requests queued, the result can be outdated right away if other threads queue requests
+	 */
+	bool IsEmpty() const
+	{
+		return m_head.load(std::memory_order_relaxed) == nullptr;
+	}
+
+private:
+	std::atomic<FOptionalPtrRequest*> m_head{nullptr};
+	//results of the chains executed by the current drain, kept to reuse the allocation
+	TMap<FRequestKey, void*> m_results;
+};
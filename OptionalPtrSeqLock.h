@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+
+#include "CoreMinimal.h"
+
+
+/**
+ * Sequence lock of an object whose fields are written by one thread while other threads read several of them at once
+ * through MapSnapshot. The sequence is odd while a write is in progress, readers copy the fields optimistically and
+ * retry if the sequence changed meanwhile, so they never block the writer. Writers of the same object have to be
+ * serialized by other means, e.g. only the game thread writes it.
+ */
+class FOptionalPtrSeqLock
+{
+public:
+	FOptionalPtrSeqLock() = default;
+	FOptionalPtrSeqLock(const FOptionalPtrSeqLock&) = delete;
+	FOptionalPtrSeqLock& operator=(const FOptionalPtrSeqLock&) = delete;
+
+	/**
+	 * @brief Waits until no write is in progress
+	 * @return sequence to pass to EndRead
+	 */
+	FORCEINLINE uint32 BeginRead() const
+	{
+		uint32 sequence = m_sequence.load(std::memory_order_acquire);
+		while (UNLIKELY(sequence & 1))
+		{
+			FPlatformProcess::Yield();
+			sequence = m_sequence.load(std::memory_order_acquire);
+		}
+		return sequence;
+	}
+
+	/**
+	 * @param sequence sequence returned by BeginRead
+	 * @return true if no write started since BeginRead, so the fields read in between are consistent, false otherwise
+	 */
+	FORCEINLINE bool EndRead(uint32 sequence) const
+	{
+		//the reads of the fields can't be moved after the second read of the sequence
+		std::atomic_thread_fence(std::memory_order_acquire);
+		return m_sequence.load(std::memory_order_relaxed) == sequence;
+	}
+
+	/**
+	 * @brief Starts the write, the readers retry until EndWrite is called
+	 */
+	FORCEINLINE void BeginWrite()
+	{
+		const uint32 sequence = m_sequence.load(std::memory_order_relaxed);
+		checkfSlow((sequence & 1) == 0, TEXT("Write of the sequence lock starts while another one is in progress."));
+		m_sequence.store(sequence + 1, std::memory_order_relaxed);
+		//the writes of the fields can't be moved before the sequence turns odd
+		std::atomic_thread_fence(std::memory_order_release);
+	}
+
+	/**
+	 * @brief Finishes the write, publishing the written fields
+	 */
+	FORCEINLINE void EndWrite()
+	{
+		m_sequence.store(m_sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	/**
+	 * @return number of started and finished writes
+	 */
+	uint32 GetSequence() const
+	{
+		return m_sequence.load(std::memory_order_relaxed);
+	}
+
+private:
+	std::atomic<uint32> m_sequence{0};
+};
+
+/**
+ * Write of the fields guarded by FOptionalPtrSeqLock, readers see either all of them or none
+ */
+class FOptionalPtrSeqLockWriteScope
+{
+public:
+	explicit FOptionalPtrSeqLockWriteScope(FOptionalPtrSeqLock& seq_lock) : m_seq_lock{seq_lock}
+	{
+		m_seq_lock.BeginWrite();
+	}
+
+	~FOptionalPtrSeqLockWriteScope()
+	{
+		m_seq_lock.EndWrite();
+	}
+
+	FOptionalPtrSeqLockWriteScope(const FOptionalPtrSeqLockWriteScope&) = delete;
+	FOptionalPtrSeqLockWriteScope& operator=(const FOptionalPtrSeqLockWriteScope&) = delete;
+
+private:
+	FOptionalPtrSeqLock& m_seq_lock;
+};
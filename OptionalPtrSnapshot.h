@@ -0,0 +1,546 @@
+#pragma once
+
+#include <atomic>
+#include <type_traits>
+
+#include "CoreMinimal.h"
+#include "OptionalPtr.h"
+#include "OptionalPtrEpoch.h"
+#include "OptionalPtrTry.h"
+
+
+/**
+ * Type of the result of member field or member function without parameters registered in FOptionalPtrSnapshotSchema
+ */
+template<typename MemberType>
+struct TOptionalPtrSnapshotMember;
+
+template<typename ClassType, typename FieldType>
+struct TOptionalPtrSnapshotMember<FieldType ClassType::*>
+{
+	using ResultType = std::decay_t<FieldType>;
+};
+
+template<typename ClassType, typename ReturnType>
+struct TOptionalPtrSnapshotMember<ReturnType(ClassType::*)()>
+{
+	using ResultType = std::decay_t<ReturnType>;
+};
+
+template<typename ClassType, typename ReturnType>
+struct TOptionalPtrSnapshotMember<ReturnType(ClassType::*)() const>
+{
+	using ResultType = std::decay_t<ReturnType>;
+};
+
+//members returning types with a resolver are links to other objects, the rest are values copied into the snapshot
+template<typename ResultType, typename = void>
+struct TIsOptionalPtrSnapshotLink
+{
+	static constexpr bool value = false;
+};
+
+template<typename ResultType>
+struct TIsOptionalPtrSnapshotLink<ResultType, decltype(void(sizeof(typename TOptionalPtrResolver<ResultType>::ObjectType*)))>
+{
+	static constexpr bool value = true;
+};
+
+/**
+ * @return identifier of the type, unique within the module
+ */
+template<typename ObjectType>
+const void* GetOptionalPtrSnapshotTypeId()
+{
+	static const uint8 id = 0;
+	return &id;
+}
+
+class FOptionalPtrSnapshot;
+
+template<typename ObjectType>
+class TOptionalPtrSnapshotPtr;
+
+/**
+ * Fields copied into snapshots, declared by the same member fields and member functions Map takes. Links are followed
+ * by Map when the snapshot is built, so only the objects reachable from the roots through them are copied. Fields
+ * can't be added once a snapshot is built, the schema has to outlive its snapshots.
+ */
+class FOptionalPtrSnapshotSchema
+{
+	friend class FOptionalPtrSnapshot;
+	template<typename> friend class TOptionalPtrSnapshotPtr;
+
+	struct FField
+	{
+		/** Member pointer the field is registered with, compared by the readers */
+		alignas(void*) uint8 Member[2 * sizeof(void*)] = {};
+		const void* MemberTypeId = nullptr;
+		/** Type of the linked object, INDEX_NONE for values */
+		int32 TargetType = INDEX_NONE;
+		/** Offset of the copied value or record offset of the linked object in the record */
+		int32 Offset = 0;
+		void* (*Follow)(void* obj, const FField& field) = nullptr;
+		void (*Copy)(void* obj, const FField& field, void* out_value) = nullptr;
+	};
+
+	struct FType
+	{
+		const void* Id;
+		/** Size of the record in bytes and in 8 byte words, including the header */
+		int32 RecordBytes = HeaderWords * sizeof(uint64);
+		int32 RecordWords = HeaderWords;
+		TArray<FField> Fields;
+	};
+
+	//each record starts with the source object and the index of its type
+	struct FRecordHeader
+	{
+		void* Source;
+		int32 Type;
+	};
+	static constexpr int32 HeaderWords = sizeof(FRecordHeader) / sizeof(uint64);
+	static_assert(sizeof(FRecordHeader) % sizeof(uint64) == 0, "Header of the record has to be made of whole words.");
+
+public:
+	/**
+	 * @brief Registers member of ObjectType copied into the snapshots, links are copied as the records of the linked objects
+	 * @tparam ObjectType type of the objects the member is copied from, the class of the member by default
+	 * @tparam MemberType type of member field or member function without parameters (auto-deduced)
+	 * @param member member to copy, values have to be trivially copyable
+	 * @return this schema to chain the registrations
+	 */
+	template<typename ObjectType = void, typename MemberType>
+	FOptionalPtrSnapshotSchema& Add(MemberType member)
+	{
+		using OwnerType = std::conditional_t<std::is_void<ObjectType>::value, member_class_of_t<MemberType>, ObjectType>;
+		using ResultType = typename TOptionalPtrSnapshotMember<MemberType>::ResultType;
+		static_assert(sizeof(MemberType) <= sizeof(FField::Member), "Member pointer is too big.");
+		static_assert(alignof(ResultType) <= sizeof(uint64), "Values aligned to more than 8 bytes are not supported.");
+		checkf(!m_frozen, TEXT("Field is added to the snapshot schema after a snapshot was built."));
+
+		FField field;
+		FMemory::Memcpy(field.Member, &member, sizeof(MemberType));
+		field.MemberTypeId = GetOptionalPtrSnapshotTypeId<MemberType>();
+		AddField<OwnerType, MemberType, ResultType>(field, std::integral_constant<bool, TIsOptionalPtrSnapshotLink<ResultType>::value>());
+
+		FType& type = m_types[FindOrAddType(GetOptionalPtrSnapshotTypeId<std::remove_cv_t<OwnerType>>())];
+		const bool link = field.TargetType != INDEX_NONE;
+		//fields are appended at the end of the record, keeping their alignment
+		field.Offset = Align(type.RecordBytes, link ? alignof(int32) : alignof(ResultType));
+		type.RecordBytes = field.Offset + (link ? sizeof(int32) : sizeof(ResultType));
+		type.RecordWords = Align(type.RecordBytes, sizeof(uint64)) / sizeof(uint64);
+		type.Fields.Add(field);
+		return *this;
+	}
+
+	/**
+	 * @brief Copies the registered fields of all the objects reachable from the roots, has to run on the thread owning them
+	 * @tparam RootType type of the roots (auto-deduced)
+	 * @param roots objects the snapshot starts from, invalid ones are kept as unset roots
+	 * @return immutable snapshot, readable by any thread
+	 */
+	template<typename RootType>
+	TUniquePtr<FOptionalPtrSnapshot> Build(const TArray<RootType*>& roots);
+
+private:
+	template<typename MemberType>
+	struct member_class_of;
+
+	template<typename ClassType, typename FieldType>
+	struct member_class_of<FieldType ClassType::*>
+	{
+		using type = ClassType;
+	};
+
+	template<typename MemberType>
+	using member_class_of_t = typename member_class_of<MemberType>::type;
+
+	//record of the object copied as the type, the same object reached as different types gets a record for each of them
+	struct FVisited
+	{
+		void* Object;
+		int32 Type;
+		int32 Record;
+	};
+
+	TArray<FType> m_types;
+	bool m_frozen = false;
+	//snapshots of consecutive frames are about the same size, so the buffers are reserved by the size of the last one
+	int32 m_num_words_hint = 0;
+	int32 m_num_objects_hint = 0;
+	//open addressing table of the copied objects, kept between the builds to reuse the allocation
+	TArray<FVisited> m_visited;
+
+	FORCEINLINE int32 VisitedIndex(void* obj, int32 type) const
+	{
+		const uint64 hash = (static_cast<uint64>(reinterpret_cast<UPTRINT>(obj)) ^ static_cast<uint64>(type)) * 0x9E3779B97F4A7C15ull;
+		return static_cast<int32>((hash >> 32) & (m_visited.Num() - 1));
+	}
+
+	void ResetVisited(int32 num_objects)
+	{
+		int32 capacity = 64;
+		while (capacity < 2 * num_objects)
+		{
+			capacity *= 2;
+		}
+		m_visited.SetNumUninitialized(capacity);
+		for (FVisited& visited : m_visited)
+		{
+			visited.Object = nullptr;
+		}
+	}
+
+	static constexpr int32 Align(int32 value, int32 alignment)
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	int32 FindOrAddType(const void* id)
+	{
+		for (int32 i = 0; i < m_types.Num(); ++i)
+		{
+			if (m_types[i].Id == id)
+				return i;
+		}
+		return m_types.Add(FType{id});
+	}
+
+	int32 FindType(const void* id) const
+	{
+		for (int32 i = 0; i < m_types.Num(); ++i)
+		{
+			if (m_types[i].Id == id)
+				return i;
+		}
+		return INDEX_NONE;
+	}
+
+	template<typename OwnerType, typename MemberType, typename ResultType>
+	void AddField(FField& field, std::true_type)
+	{
+		using TargetType = std::remove_cv_t<typename TOptionalPtrResolver<ResultType>::ObjectType>;
+		field.TargetType = FindOrAddType(GetOptionalPtrSnapshotTypeId<TargetType>());
+		field.Follow = [](void* obj, const FField& field) -> void*
+		{
+			MemberType member;
+			FMemory::Memcpy(&member, field.Member, sizeof(MemberType));
+			//links are followed by Map and validated the same way as by the chains, so pending kill objects get no record
+			return const_cast<TargetType*>(GetValidOptionalPtr(MakeUncountedOptionalPtr(static_cast<OwnerType*>(obj)).Map(MoveTemp(member))));
+		};
+	}
+
+	template<typename OwnerType, typename MemberType, typename ResultType>
+	void AddField(FField& field, std::false_type)
+	{
+		static_assert(std::is_trivially_copyable<ResultType>::value, "Values copied into the snapshot have to be trivially copyable.");
+		field.Copy = [](void* obj, const FField& field, void* out_value)
+		{
+			MemberType member;
+			FMemory::Memcpy(&member, field.Member, sizeof(MemberType));
+			const ResultType value = InvokeMember(static_cast<OwnerType*>(obj), member);
+			FMemory::Memcpy(out_value, &value, sizeof(ResultType));
+		};
+	}
+
+	template<typename OwnerType, typename MemberType, std::enable_if_t<std::is_member_function_pointer<MemberType>::value, int> = 0>
+	static decltype(auto) InvokeMember(OwnerType* obj, MemberType member)
+	{
+		return (obj->*member)();
+	}
+
+	template<typename OwnerType, typename MemberType, std::enable_if_t<std::is_member_object_pointer<MemberType>::value, int> = 0>
+	static decltype(auto) InvokeMember(OwnerType* obj, MemberType member)
+	{
+		return obj->*member;
+	}
+
+	template<typename MemberType>
+	const FField* FindField(int32 type, MemberType member) const
+	{
+		const void* const member_type_id = GetOptionalPtrSnapshotTypeId<MemberType>();
+		for (const FField& field : m_types[type].Fields)
+		{
+			if (field.MemberTypeId == member_type_id && FMemory::Memcmp(field.Member, &member, sizeof(MemberType)) == 0)
+				return &field;
+		}
+		return nullptr;
+	}
+};
+
+/**
+ * Immutable copy of the registered fields of the objects reachable from the roots, stored as records in one contiguous
+ * buffer. Links are stored as offsets of the records, so readers never touch the live objects.
+ */
+class FOptionalPtrSnapshot
+{
+	friend class FOptionalPtrSnapshotSchema;
+	template<typename> friend class TOptionalPtrSnapshotPtr;
+
+public:
+	/**
+	 * @tparam RootType type of the roots the snapshot was built from
+	 * @param index index of the root in the array the snapshot was built from
+	 * @return root wrapped in TOptionalPtrSnapshotPtr, unset if the root was not valid
+	 */
+	template<typename RootType>
+	TOptionalPtrSnapshotPtr<RootType> GetRoot(int32 index) const
+	{
+		checkf(m_root_type == GetOptionalPtrSnapshotTypeId<std::remove_cv_t<RootType>>(), TEXT("Root of the snapshot is read as a different type."));
+		return TOptionalPtrSnapshotPtr<RootType>(this, m_roots[index]);
+	}
+
+	/**
+	 * @return number of the roots
+	 */
+	int32 NumRoots() const
+	{
+		return m_roots.Num();
+	}
+
+	/**
+	 * @return number of the copied objects
+	 */
+	int32 NumObjects() const
+	{
+		return m_num_objects;
+	}
+
+	/**
+	 * @return size of the copied data in bytes
+	 */
+	SIZE_T GetAllocatedSize() const
+	{
+		return m_data.GetAllocatedSize() + m_roots.GetAllocatedSize();
+	}
+
+private:
+	const FOptionalPtrSnapshotSchema& m_schema;
+	const void* m_root_type;
+	TArray<uint64> m_data;
+	//record offset of each root, INDEX_NONE for invalid roots
+	TArray<int32> m_roots;
+	int32 m_num_objects = 0;
+
+	FOptionalPtrSnapshot(const FOptionalPtrSnapshotSchema& schema, const void* root_type) : m_schema{schema}, m_root_type{root_type} {}
+
+	const FOptionalPtrSnapshotSchema::FRecordHeader& GetHeader(int32 record) const
+	{
+		return *reinterpret_cast<const FOptionalPtrSnapshotSchema::FRecordHeader*>(m_data.GetData() + record);
+	}
+
+	const uint8* GetField(int32 record, int32 offset) const
+	{
+		return reinterpret_cast<const uint8*>(m_data.GetData() + record) + offset;
+	}
+};
+
+template<typename RootType>
+TUniquePtr<FOptionalPtrSnapshot> FOptionalPtrSnapshotSchema::Build(const TArray<RootType*>& roots)
+{
+	m_frozen = true;
+	//types can't be added either, readers of the previous snapshots look the fields up concurrently
+	const int32 root_type = FindType(GetOptionalPtrSnapshotTypeId<std::remove_cv_t<RootType>>());
+	checkf(root_type != INDEX_NONE, TEXT("Root type has no fields registered in the snapshot schema."));
+
+	TUniquePtr<FOptionalPtrSnapshot> snapshot(new FOptionalPtrSnapshot(*this, m_types[root_type].Id));
+	TArray<uint64>& data = snapshot->m_data;
+	data.Reserve(m_num_words_hint);
+	ResetVisited(FMath::Max(m_num_objects_hint, roots.Num()));
+	int32 num_visited = 0;
+
+	auto find_or_add_record = [&](void* obj, int32 type) -> int32
+	{
+		int32 index = VisitedIndex(obj, type);
+		for (; m_visited[index].Object != nullptr; index = (index + 1) & (m_visited.Num() - 1))
+		{
+			if (m_visited[index].Object == obj && m_visited[index].Type == type)
+				return m_visited[index].Record;
+		}
+
+		const int32 record = data.AddZeroed(m_types[type].RecordWords);
+		FRecordHeader& header = *reinterpret_cast<FRecordHeader*>(data.GetData() + record);
+		header.Source = obj;
+		header.Type = type;
+		m_visited[index] = FVisited{obj, type, record};
+		//the table is kept at most half full, the records are inserted again from the buffer when it grows
+		if (2 * ++num_visited > m_visited.Num())
+		{
+			ResetVisited(2 * num_visited);
+			for (int32 other = 0; other < data.Num(); other += m_types[reinterpret_cast<const FRecordHeader*>(data.GetData() + other)->Type].RecordWords)
+			{
+				const FRecordHeader& other_header = *reinterpret_cast<const FRecordHeader*>(data.GetData() + other);
+				int32 other_index = VisitedIndex(other_header.Source, other_header.Type);
+				while (m_visited[other_index].Object != nullptr)
+				{
+					other_index = (other_index + 1) & (m_visited.Num() - 1);
+				}
+				m_visited[other_index] = FVisited{other_header.Source, other_header.Type, other};
+			}
+		}
+		return record;
+	};
+
+	snapshot->m_roots.Reserve(roots.Num());
+	for (RootType* root : roots)
+	{
+		snapshot->m_roots.Add(MakeUncountedOptionalPtr(root).IsSet() ? find_or_add_record(const_cast<std::remove_cv_t<RootType>*>(root), root_type) : INDEX_NONE);
+	}
+
+	//records are appended while they are filled, so the buffer is walked breadth first until no new record is added
+	for (int32 record = 0; record < data.Num(); )
+	{
+		const FRecordHeader header = *reinterpret_cast<const FRecordHeader*>(data.GetData() + record);
+		const FType& type = m_types[header.Type];
+		for (const FField& field : type.Fields)
+		{
+			if (field.TargetType == INDEX_NONE)
+			{
+				field.Copy(header.Source, field, reinterpret_cast<uint8*>(data.GetData() + record) + field.Offset);
+				continue;
+			}
+
+			void* const target = field.Follow(header.Source, field);
+			const int32 target_record = target != nullptr ? find_or_add_record(target, field.TargetType) : INDEX_NONE;
+			FMemory::Memcpy(reinterpret_cast<uint8*>(data.GetData() + record) + field.Offset, &target_record, sizeof(int32));
+		}
+		record += type.RecordWords;
+		++snapshot->m_num_objects;
+	}
+	m_num_words_hint = data.Num();
+	m_num_objects_hint = snapshot->m_num_objects;
+	return snapshot;
+}
+
+/**
+ * Object of FOptionalPtrSnapshot, chains run through it the same way as through TOptionalPtr but read only the copied
+ * fields. Members which are not registered in the schema fail the check and leave the pointer unset.
+ * @tparam ObjectType type of the object
+ */
+template<typename ObjectType>
+class TOptionalPtrSnapshotPtr
+{
+	template<typename> friend class TOptionalPtrSnapshotPtr;
+	friend class FOptionalPtrSnapshot;
+
+public:
+	/**
+	 * @return false if the object wasn't valid when the snapshot was built, true otherwise
+	 */
+	bool IsSet() const
+	{
+		return m_record != INDEX_NONE;
+	}
+
+	/**
+	 * @brief Follows the link copied into the snapshot
+	 * @tparam MemberType type of member field or member function registered as link (auto-deduced)
+	 * @param member member the link is registered with
+	 * @return linked object wrapped in TOptionalPtrSnapshotPtr
+	 */
+	template<typename MemberType, typename ResultType = typename TOptionalPtrSnapshotMember<MemberType>::ResultType,
+		typename = std::enable_if_t<TIsOptionalPtrSnapshotLink<ResultType>::value>,
+		typename ReturnType = typename TOptionalPtrResolver<ResultType>::ObjectType>
+	TOptionalPtrSnapshotPtr<ReturnType> Map(MemberType member) const
+	{
+		const uint8* const value = FindValue(member);
+		if (value == nullptr)
+			return TOptionalPtrSnapshotPtr<ReturnType>(m_snapshot, INDEX_NONE);
+
+		int32 target_record;
+		FMemory::Memcpy(&target_record, value, sizeof(int32));
+		return TOptionalPtrSnapshotPtr<ReturnType>(m_snapshot, target_record);
+	}
+
+	/**
+	 * @brief Reads the value copied into the snapshot
+	 * @tparam MemberType type of member field or member function registered as value (auto-deduced)
+	 * @param default_value value returned if the object is not set
+	 * @param member member the value is registered with
+	 * @return copied value if the object is set, default_value otherwise
+	 */
+	template<typename MemberType, typename ResultType = typename TOptionalPtrSnapshotMember<MemberType>::ResultType,
+		typename = std::enable_if_t<!TIsOptionalPtrSnapshotLink<ResultType>::value>>
+	ResultType MapToValue(const ResultType& default_value, MemberType member) const
+	{
+		const uint8* const value = FindValue(member);
+		if (value == nullptr)
+			return default_value;
+
+		ResultType result;
+		FMemory::Memcpy(&result, value, sizeof(ResultType));
+		return result;
+	}
+
+	/**
+	 * @return live object the record was copied from, only to identify it, it could be destroyed since
+	 */
+	const void* GetSourceId() const
+	{
+		return IsSet() ? m_snapshot->GetHeader(m_record).Source : nullptr;
+	}
+
+private:
+	const FOptionalPtrSnapshot* m_snapshot;
+	int32 m_record;
+
+	TOptionalPtrSnapshotPtr(const FOptionalPtrSnapshot* snapshot, int32 record) : m_snapshot{snapshot}, m_record{record} {}
+
+	template<typename MemberType>
+	const uint8* FindValue(MemberType member) const
+	{
+		if (!IsSet())
+			return nullptr;
+
+		const FOptionalPtrSnapshotSchema::FField* const field = m_snapshot->m_schema.FindField(m_snapshot->GetHeader(m_record).Type, member);
+		checkf(field != nullptr, TEXT("Member is not registered in the snapshot schema."));
+		return field != nullptr ? m_snapshot->GetField(m_record, field->Offset) : nullptr;
+	}
+};
+
+/**
+ * Publishes snapshots to the readers by read-copy-update. The owning thread builds a new snapshot, e.g. once per frame,
+ * and swaps it in with one atomic exchange, readers keep the snapshot they acquired until they leave their
+ * FOptionalPtrEpochGuard. Replaced snapshots are retired to FOptionalPtrEpochDomain.
+ */
+class FOptionalPtrSnapshotPublisher
+{
+public:
+	FOptionalPtrSnapshotPublisher() = default;
+	FOptionalPtrSnapshotPublisher(const FOptionalPtrSnapshotPublisher&) = delete;
+	FOptionalPtrSnapshotPublisher& operator=(const FOptionalPtrSnapshotPublisher&) = delete;
+
+	//no reader can be left when the publisher is destroyed
+	~FOptionalPtrSnapshotPublisher()
+	{
+		delete m_current.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * @brief Replaces the current snapshot, the replaced one is deleted once no reader can see it
+	 * @param snapshot snapshot to publish
+	 */
+	void Publish(TUniquePtr<FOptionalPtrSnapshot> snapshot)
+	{
+		FOptionalPtrEpochDomain& domain = FOptionalPtrEpochDomain::Get();
+		if (const FOptionalPtrSnapshot* const previous = m_current.exchange(snapshot.Release(), std::memory_order_acq_rel))
+		{
+			domain.Retire(previous);
+		}
+		//snapshots are big, so they are reclaimed on every publish instead of waiting for the threshold
+		domain.Reclaim();
+	}
+
+	/**
+	 * @return current snapshot, valid until the calling thread leaves its FOptionalPtrEpochGuard, nullptr if none was published
+	 */
+	const FOptionalPtrSnapshot* Acquire() const
+	{
+		checkfSlow(FOptionalPtrEpochDomain::Get().IsInGuard(), TEXT("Snapshot is acquired outside of FOptionalPtrEpochGuard."));
+		return m_current.load(std::memory_order_acquire);
+	}
+
+private:
+	std::atomic<const FOptionalPtrSnapshot*> m_current{nullptr};
+};
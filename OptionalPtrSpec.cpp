@@ -1,1026 +1,5319 @@
-#include "OptionalPtrSpec.h"
-#include "OptionalPtr.h"
-#include "Misc/AutomationTest.h"
-
-#include <chrono>
-#include <utility>
-
-BEGIN_DEFINE_SPEC(FOptionalPtrSpec, "OptionalPtr.Unit", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
-MockObject* m_wrapped_obj = nullptr;
-MockObject* m_default_obj = nullptr;
-
-template<typename ResultType, typename FuncObjectType, typename = std::enable_if_t<std::is_member_function_pointer<FuncObjectType>::value>, typename... Args>
-ResultType GetResult(FuncObjectType&& func, Args&&... args)
-{
-	return (m_wrapped_obj->*func)(std::forward<Args>(args)...);
-}
-
-template<typename ResultType, typename FuncObjectType, typename = std::enable_if_t<std::is_member_object_pointer<FuncObjectType>::value>>
-ResultType GetResult(FuncObjectType&& field)
-{
-	return m_wrapped_obj->*field;
-}
-
-template<typename MockType, typename FuncObjectType>
-void IfPresentTest(FuncObjectType&& func)
-{
-	bool executed = false;
-	TOptionalPtr<MockType>((MockType*)m_wrapped_obj).IfPresent(std::forward<FuncObjectType>(func), executed);
-	TestTrue("", m_wrapped_obj != nullptr ? executed : !executed);
-}
-
-template<typename MockType, typename DefaultType>
-void OrElseTest()
-{
-	auto testing_obj = TOptionalPtr<MockType>((MockType*)m_wrapped_obj).OrElse((DefaultType*)m_default_obj);
-	TestTrue("", testing_obj.IsSet());
-	TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<DefaultType>>::value);
-	TestEqual<MockObject*>("", testing_obj.Get(), m_wrapped_obj != nullptr ? m_wrapped_obj : m_default_obj);
-}
-
-template<typename ResultType, typename MockType, typename FuncObjectType, typename... Args>
-void MapTest(FuncObjectType&& func, Args&&... args)
-{
-	auto testing_obj = TOptionalPtr<MockType>((MockType*)(m_wrapped_obj)).Map(std::forward<FuncObjectType>(func), std::forward<Args>(args)...);
-	TestTrue("", m_wrapped_obj != nullptr ? testing_obj.IsSet() : !testing_obj.IsSet());
-	TestTrue("", std::is_same<decltype(testing_obj), ResultType>::value);
-	if (m_wrapped_obj)
-	{
-		TestTrue("", *testing_obj.Get() == *GetResult<decltype(testing_obj.Get())>(std::forward<FuncObjectType>(func), std::forward<Args>(args)...));
-	}
-}
-
-template<typename ResultType, typename MockType, typename FuncObjectType, typename... Args>
-void MapToValueTest(FuncObjectType&& func, Args&&... args)
-{
-	auto default_obj = new std::remove_pointer_t<ResultType>(MethodEnum::Default);
-	auto testing_obj = TOptionalPtr<MockType>((MockType*)m_wrapped_obj).MapToValue(default_obj,
-		std::forward<FuncObjectType>(func), std::forward<Args>(args)...);
-		
-	ResultType result = default_obj;
-	if (m_wrapped_obj != nullptr)
-	{
-		result = GetResult<ResultType>(std::forward<FuncObjectType>(func), std::forward<Args>(args)...);
-	}
-	
-	TestEqual("", *testing_obj, *result);
-	TestTrue("", std::is_same<decltype(testing_obj), ResultType>::value);
-
-	delete default_obj;
-}
-
-template<typename ResultType, typename MockType, typename FuncObjectType, typename... Args>
-void MapStaticTest(FuncObjectType&& func, Args&&... args)
-{
-	auto testing_obj = TOptionalPtr<MockType>((MockType*)(m_wrapped_obj)).MapStatic(std::forward<FuncObjectType>(func), std::forward<Args>(args)...);
-	TestTrue("", m_wrapped_obj != nullptr ? testing_obj.IsSet() : !testing_obj.IsSet());
-	TestTrue("", std::is_same<decltype(testing_obj), ResultType>::value);
-}
-END_DEFINE_SPEC(FOptionalPtrSpec)
-
-void FOptionalPtrSpec::Define()
-{
-	Describe("Map", [this]()
-	{
-		Describe("when given a wrapped UObject pointer", [this]()
-		{
-			Describe("when valid", [this]()
-			{
-				BeforeEach([this]()
-				{
-					m_wrapped_obj = NewObject<UMockUObject>();
-				});
-				AfterEach([this]()
-				{
-					m_wrapped_obj->Destroy();
-				});
-				It("should map a non-const method and return set optional", [this]()
-					{MapTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::Method);});
-				It("should map a const method and return set optional", [this]()
-					{MapTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::MethodConst);});
-				It("should map a method returning const data and return set optional", [this]()
-					{MapTest<TOptionalPtr<const SimpleObject>, UMockUObject>(&MockObject::ConstMethod);});
-				It("should map a const method returning const data and return set optional", [this]()
-					{MapTest<TOptionalPtr<const SimpleObject>, UMockUObject>(&MockObject::ConstMethodConst);});
-				It("should map a method returning const pointer and return set optional", [this]()
-					{MapTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::ConstPointerMethod);});
-				It("should map a const method returning const pointer and return set optional", [this]()
-					{MapTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::ConstPointerMethodConst);});
-				It("should map a non-const field and return set optional", [this]()
-					{MapTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::m_field);});
-				It("should map a const field and return set optional", [this]()
-					{MapTest<TOptionalPtr<const SimpleObject>, UMockUObject>(&MockObject::m_const_field);});
-				It("should map a field with const pointer and return set optional", [this]()
-					{MapTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::m_field_const);});
-				
-				It("should map a method with copy parameter and return set optional", [this]()
-					{MapTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::MethodWithParamCopy, SimpleObject{});});
-				It("should map a method with pointer parameter and return set optional", [this]()
-					{MapTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::MethodWithParamPointer, new SimpleObject());});
-				It("should map a method with const pointer parameter and return set optional", [this]()
-					{MapTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::MethodWithConstParamPointer, new SimpleObject());});
-				It("should map a method with const reference parameter and return set optional", [this]()
-					{MapTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::MethodWithConstParamRef, SimpleObject{});});
-				It("should map a method with non-const reference parameter and return set optional", [this]()
-				{
-					SimpleObject simple_object {};
-					MapTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::MethodWithParamRef, simple_object);
-				});
-				It("should map a method with r-value parameter and return set optional", [this]()
-					{MapTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::MethodWithParamRValue, SimpleObject{});});
-				It("should map a method with multiple parameters and return set optional", [this]()
-					{MapTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::MethodWithMultipleParams, SimpleObject{}, 0, 0.f);});
-				
-				It("should map the overloaded method 1 and return set optional", [this]()
-				{
-					auto testing_obj = TOptionalPtr<UMockUObject>((UMockUObject*)(m_wrapped_obj)).
-						Map(static_cast<SimpleObject*(MockObject::*)()>(&MockObject::OverloadedMethod));
-					TestTrue("", testing_obj.IsSet());
-					TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<SimpleObject>>::value);
-				});
-				It("should map the overloaded method 2 and return set optional", [this]()
-				{
-					bool executed = false;
-					auto testing_obj = TOptionalPtr<UMockUObject>((UMockUObject*)m_wrapped_obj).
-						Map(static_cast<SimpleObject*(MockObject::*)(bool&)>(&MockObject::OverloadedMethod), executed);
-					TestTrue("", testing_obj.IsSet());
-					TestTrue("", executed);
-					TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<SimpleObject>>::value);
-				});
-			});
-
-			Describe("when not valid", [this]()
-			{
-				BeforeEach([this]()
-				{
-					m_wrapped_obj = nullptr;
-				});
-				It("should map a method and return empty optional", [this]()
-					{MapTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::Method);});
-			});
-		});
-
-		Describe("when given a wrapped non-UObject pointer", [this]()
-		{
-			Describe("when valid", [this]()
-			{
-				BeforeEach([this]()
-				{
-					m_wrapped_obj = new MockNonUObject();
-				});
-				AfterEach([this]()
-				{
-					m_wrapped_obj->Destroy();
-				});
-				It("should map a non-const method and return set optional", [this]()
-					{MapTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::Method);});
-				It("should map a const method and return set optional", [this]()
-					{MapTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::MethodConst);});
-				It("should map a method returning const data and return set optional", [this]()
-					{MapTest<TOptionalPtr<const SimpleObject>, MockNonUObject>(&MockObject::ConstMethod);});
-				It("should map a const method returning const data and return set optional", [this]()
-					{MapTest<TOptionalPtr<const SimpleObject>, MockNonUObject>(&MockObject::ConstMethodConst);});
-				It("should map a method returning const pointer and return set optional", [this]()
-					{MapTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::ConstPointerMethod);});
-				It("should map a const method returning const pointer and return set optional", [this]()
-					{MapTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::ConstPointerMethodConst);});
-				It("should map a non-const field and return set optional", [this]()
-					{MapTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::m_field);});
-				It("should map a const field and return set optional", [this]()
-					{MapTest<TOptionalPtr<const SimpleObject>, MockNonUObject>(&MockObject::m_const_field);});
-				It("should map a field with const pointer and return set optional", [this]()
-					{MapTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::m_field_const);});
-
-				It("should map a method with copy parameter and return set optional", [this]()
-					{MapTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::MethodWithParamCopy, SimpleObject{});});
-				It("should map a method with pointer parameter and return set optional", [this]()
-					{MapTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::MethodWithParamPointer, new SimpleObject{});});
-				It("should map a method with const pointer parameter and return set optional", [this]()
-					{MapTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::MethodWithConstParamPointer, new SimpleObject{});});
-				It("should map a method with const reference parameter and return set optional", [this]()
-					{MapTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::MethodWithConstParamRef, SimpleObject{});});
-				It("should map a method with non-const reference parameter and return set optional", [this]()
-				{
-					SimpleObject simple_object {};
-					MapTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::MethodWithParamRef, simple_object);
-				});
-				It("should map a method with r-value parameter and return set optional", [this]()
-					{MapTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::MethodWithParamRValue, SimpleObject{});});
-				It("should map a method with multiple parameters and return set optional", [this]()
-					{MapTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::MethodWithMultipleParams, SimpleObject{}, 0, 0.f);});
-
-				It("should map the overloaded method 1 and return set optional", [this]()
-				{
-					auto testing_obj = TOptionalPtr<MockNonUObject>((MockNonUObject*)m_wrapped_obj).
-						Map(static_cast<SimpleObject*(MockObject::*)()>(&MockObject::OverloadedMethod));
-					TestTrue("", testing_obj.IsSet());
-					TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<SimpleObject>>::value);
-				});
-				It("should map the overloaded method 2 and return set optional", [this]()
-				{
-					bool executed = false;
-					auto testing_obj = TOptionalPtr<MockNonUObject>((MockNonUObject*)m_wrapped_obj).
-						Map(static_cast<SimpleObject*(MockObject::*)(bool&)>(&MockObject::OverloadedMethod), executed);
-					TestTrue("", testing_obj.IsSet());
-					TestTrue("", executed);
-					TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<SimpleObject>>::value);
-				});
-			});
-			
-			Describe("when not valid", [this]()
-			{
-				BeforeEach([this]()
-				{
-					m_wrapped_obj = nullptr;
-				});
-				It("should map a method and return empty optional", [this]()
-					{MapTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::Method);});
-			});
-		});
-	});
-	Describe("IfPresent", [this]()
-	{
-		Describe("when given a wrapped UObject pointer", [this]()
-		{
-			Describe("when valid", [this]()
-			{
-				BeforeEach([this]()
-				{
-					m_wrapped_obj = NewObject<UMockUObject>();
-				});
-				AfterEach([this]()
-				{
-					m_wrapped_obj->Destroy();
-				});
-				It("should execute a non-const method", [this]()
-				{
-					IfPresentTest<UMockUObject>(&MockObject::Method2WithParamRef);
-				});
-
-				It("should execute a const method", [this]()
-				{
-					IfPresentTest<UMockUObject>(&MockObject::MethodConstWithParamRef);
-				});
-			});
-
-			Describe("when not valid", [this]()
-			{
-				BeforeEach([this]()
-				{
-					m_wrapped_obj = nullptr;
-				});
-				
-				It("should not execute a non-const method", [this]()
-				{
-					IfPresentTest<UMockUObject>(&MockObject::Method2WithParamRef);
-				}); 
-
-				It("should not execute a const method", [this]()
-				{
-					IfPresentTest<UMockUObject>(&MockObject::MethodConstWithParamRef);
-				});
-			});
-		});
-
-		Describe("when given a wrapped non-UObject pointer", [this]()
-		{
-			Describe("when valid", [this]()
-			{
-				BeforeEach([this]()
-				{
-					m_wrapped_obj = new MockNonUObject();
-				});
-				AfterEach([this]()
-				{
-					m_wrapped_obj->Destroy();
-				});
-				
-				It("should execute a non-const method", [this]()
-				{
-					IfPresentTest<MockNonUObject>(&MockObject::Method2WithParamRef);
-				});
-
-				It("should execute a const method", [this]()
-				{
-					IfPresentTest<MockNonUObject>(&MockObject::MethodConstWithParamRef);
-				});
-			});
-
-			Describe("when not valid", [this]()
-			{
-				BeforeEach([this]()
-				{
-					m_wrapped_obj = nullptr;
-				});
-				
-				It("should not execute a non-const method", [this]()
-				{
-					IfPresentTest<MockNonUObject>(&MockObject::Method2WithParamRef);
-				});
-
-				It("should not execute a const method", [this]()
-				{
-					IfPresentTest<MockNonUObject>(&MockObject::MethodConstWithParamRef);
-				});
-			});
-		});
-
-	});
-	Describe("OrElse", [this]()
-	{
-		Describe("when given a wrapped UObject pointer", [this]()
-		{
-			Describe("when valid", [this]()
-			{
-				BeforeEach([this]()
-				{
-					m_wrapped_obj = NewObject<UMockUObject>();
-					m_default_obj = NewObject<UMockUObject>();
-				});
-				AfterEach([this]()
-				{
-					m_wrapped_obj->Destroy();
-					m_default_obj->Destroy();
-				});
-				
-				It("should return the initial wrapped object", [this]()
-				{
-					OrElseTest<UMockUObject, UMockUObject>();
-				});
-			});
-
-			Describe("when not valid", [this]()
-			{
-				BeforeEach([this]()
-				{
-					m_wrapped_obj = nullptr;
-					m_default_obj = NewObject<UMockUObject>();
-				});
-				AfterEach([this]()
-				{
-					m_default_obj->Destroy();
-				});
-				
-				It("should return the wrapped default object", [this]()
-				{
-					OrElseTest<UMockUObject, UMockUObject>();
-				});
-			});
-		});
-		Describe("when given a wrapped non-UObject pointer", [this]()
-		{
-			Describe("when valid", [this]()
-			{
-				BeforeEach([this]()
-				{
-					m_wrapped_obj = new MockNonUObject();
-					m_default_obj = new MockNonUObject();
-				});
-				AfterEach([this]()
-				{
-					m_wrapped_obj->Destroy();
-					m_default_obj->Destroy();
-				});
-				
-				It("should return the initial wrapped object", [this]()
-				{
-					OrElseTest<MockNonUObject, MockNonUObject>();
-				});
-			});
-
-			Describe("when not valid", [this]()
-			{
-				BeforeEach([this]()
-				{
-					m_wrapped_obj = nullptr;
-					m_default_obj = new MockNonUObject();
-				});
-				AfterEach([this]()
-				{
-					m_default_obj->Destroy();
-				});
-				
-				It("should return the wrapped default object", [this]()
-				{
-					OrElseTest<MockNonUObject, MockNonUObject>();
-				});
-			});
-		});
-	});
-	Describe("MapToValue", [this]()
-	{
-		Describe("when given a wrapped UObject pointer", [this]()
-		{
-			Describe("when valid", [this]()
-			{
-				BeforeEach([this]()
-				{
-					m_wrapped_obj = NewObject<UMockUObject>();
-				});
-				AfterEach([this]()
-				{
-					m_wrapped_obj->Destroy();
-				});
-				
-				It("should map a non-const method and return the value", [this]()
-					{MapToValueTest<SimpleObject*, UMockUObject>(&MockObject::Method);});
-				It("should map a const method and return the value", [this]()
-					{MapToValueTest<SimpleObject*, UMockUObject>(&MockObject::MethodConst);});
-				It("should map a method returning const data and return the value", [this]()
-					{MapToValueTest<const SimpleObject*, UMockUObject>(&MockObject::ConstMethod);});
-				It("should map a const method returning const data and return the value", [this]()
-					{MapToValueTest<const SimpleObject*, UMockUObject>(&MockObject::ConstMethodConst);});
-				It("should map a method returning const pointer and return the value", [this]()
-					{MapToValueTest<SimpleObject*, UMockUObject>(&MockObject::ConstPointerMethod);});
-				It("should map a const method returning const pointer and return the value", [this]()
-					{MapToValueTest<SimpleObject*, UMockUObject>(&MockObject::ConstPointerMethodConst);});
-				It("should map a non-const field and return the value", [this]()
-					{MapToValueTest<SimpleObject*, UMockUObject>(&MockObject::m_field);});
-				It("should map a const field and return the value", [this]()
-					{MapToValueTest<const SimpleObject*, UMockUObject>(&MockObject::m_const_field);});
-				It("should map a field with const pointer and return the value", [this]()
-					{MapToValueTest<SimpleObject*, UMockUObject>(&MockObject::m_field_const);});
-
-				It("should map the overloaded method 1 and return the value", [this]()
-				{
-					auto wrapped_obj = NewObject<UMockUObject>();
-					auto default_obj = new SimpleObject{MethodEnum::Default};
-					auto testing_obj = TOptionalPtr<UMockUObject>(wrapped_obj).
-						MapToValue(default_obj, static_cast<SimpleObject*(MockObject::*)()>(&MockObject::OverloadedMethod));
-					TestEqual("", *testing_obj, *wrapped_obj->OverloadedMethod());
-					TestTrue("", std::is_same<decltype(testing_obj), SimpleObject*>::value);
-
-					wrapped_obj->Destroy();
-					delete default_obj;
-				});
-				It("should map the overloaded method 2 and return the value", [this]()
-				{
-					auto wrapped_obj = NewObject<UMockUObject>();
-					auto default_obj = new SimpleObject{MethodEnum::Default};
-					bool executed = false;
-					auto testing_obj = TOptionalPtr<UMockUObject>(wrapped_obj).
-						MapToValue(default_obj, static_cast<SimpleObject*(MockObject::*)(bool&)>(&MockObject::OverloadedMethod), executed);
-					TestTrue("", executed);
-					TestEqual("", *testing_obj, *wrapped_obj->OverloadedMethod(executed));
-					TestTrue("", std::is_same<decltype(testing_obj), SimpleObject*>::value);
-
-					wrapped_obj->Destroy();
-					delete default_obj;
-				});
-			});
-	
-			Describe("when not valid", [this]()
-			{
-				BeforeEach([this]()
-				{
-					m_wrapped_obj = nullptr;
-				});
-				
-				It("should map a method and return the default value", [this]()
-					{MapToValueTest<SimpleObject*, UMockUObject>(&MockObject::Method);});
-			});
-		});
-	
-		Describe("when given a wrapped non-UObject pointer", [this]()
-		{
-			Describe("when valid", [this]()
-			{
-				BeforeEach([this]()
-				{
-					m_wrapped_obj = new MockNonUObject();
-				});
-				AfterEach([this]()
-				{
-					m_wrapped_obj->Destroy();
-				});
-				
-				It("should map a non-const method and return the value", [this]()
-					{MapToValueTest<SimpleObject*, MockNonUObject>(&MockObject::Method);});
-				It("should map a const method and return the value", [this]()
-					{MapToValueTest<SimpleObject*, MockNonUObject>(&MockObject::MethodConst);});
-				It("should map a method returning const data and return the value", [this]()
-					{MapToValueTest<const SimpleObject*, MockNonUObject>(&MockObject::ConstMethod);});
-				It("should map a const method returning const data and return the value", [this]()
-					{MapToValueTest<const SimpleObject*, MockNonUObject>(&MockObject::ConstMethodConst);});
-				It("should map a method returning const pointer and return the value", [this]()
-					{MapToValueTest<SimpleObject*, MockNonUObject>(&MockObject::ConstPointerMethod);});
-				It("should map a const method returning const pointer and return the value", [this]()
-					{MapToValueTest<SimpleObject*, MockNonUObject>(&MockObject::ConstPointerMethodConst);});
-				It("should map a non-const field and return the value", [this]()
-					{MapToValueTest<SimpleObject*, MockNonUObject>(&MockObject::m_field);});
-				It("should map a const field and return the value", [this]()
-					{MapToValueTest<const SimpleObject*, MockNonUObject>(&MockObject::m_const_field);});
-				It("should map a field with const pointer and return the value", [this]()
-					{MapToValueTest<SimpleObject*, MockNonUObject>(&MockObject::m_field_const);});
-		
-				It("should map the overloaded method 1 and return the value", [this]()
-				{
-					auto wrapped_obj = new MockNonUObject();
-					auto default_obj = new SimpleObject{MethodEnum::Default};
-					auto testing_obj = TOptionalPtr<MockNonUObject>(wrapped_obj).
-						MapToValue(default_obj, static_cast<SimpleObject*(MockObject::*)()>(&MockObject::OverloadedMethod));
-					TestEqual("", *testing_obj, *wrapped_obj->OverloadedMethod());
-					TestTrue("", std::is_same<decltype(testing_obj), SimpleObject*>::value);
-
-					wrapped_obj->Destroy();
-					delete default_obj;
-				});
-				It("should map the overloaded method 2 and return the value", [this]()
-				{
-					auto wrapped_obj = new MockNonUObject();
-					auto default_obj = new SimpleObject{MethodEnum::Default};
-					bool executed = false;
-					auto testing_obj = TOptionalPtr<MockNonUObject>(wrapped_obj).
-						MapToValue(default_obj, static_cast<SimpleObject*(MockObject::*)(bool&)>(&MockObject::OverloadedMethod), executed);
-					TestTrue("", executed);
-					TestEqual("", *testing_obj, *wrapped_obj->OverloadedMethod(executed));
-					TestTrue("", std::is_same<decltype(testing_obj), SimpleObject*>::value);
-
-					wrapped_obj->Destroy();
-					delete default_obj;
-				});
-			});
-			
-			Describe("when not valid", [this]()
-			{
-				BeforeEach([this]()
-				{
-					m_wrapped_obj = nullptr;
-				});
-				
-				It("should map a method and return the default value", [this]()
-					{MapToValueTest<SimpleObject*, MockNonUObject>(&MockObject::Method);});
-			});
-		});
-	});
-	Describe("MapStatic", [this]()
-	{
-		Describe("when given a wrapped UObject pointer", [this]()
-		{
-			Describe("when valid", [this]()
-			{
-				BeforeEach([this]()
-				{
-					m_wrapped_obj = NewObject<UMockUObject>();
-				});
-				AfterEach([this]()
-				{
-					m_wrapped_obj->Destroy();
-				});
-				
-				It("should map a static function taking the wrapped object as parameter and return set optional", [this]()
-					{MapStaticTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::StaticFunction);});				
-				It("should map a static function taking the wrapped object as parameter and another copy parameter and return set optional", [this]()
-					{MapStaticTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::StaticFunctionWithParamCopy, SimpleObject{});});				
-				It("should map a static function taking the wrapped object as parameter and another reference parameter and return set optional", [this]()
-					{MapStaticTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::StaticFunctionWithConstParamRef, SimpleObject{});});
-
-				It("should map the overloaded static function 1 and return the value", [this]()
-				{
-					auto wrapped_obj = NewObject<UMockUObject>();
-					auto default_obj = new SimpleObject{MethodEnum::Default};
-					auto testing_obj = TOptionalPtr<UMockUObject>(wrapped_obj).
-						MapStatic(static_cast<SimpleObject*(*)(MockObject*)>(&MockObject::OverloadedStaticFunction));
-					TestTrue("", testing_obj.IsSet());
-					TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<SimpleObject>>::value);
-				
-					wrapped_obj->Destroy();
-					delete default_obj;
-				});
-				It("should map the overloaded static function 2, set reference bool and return the value", [this]()
-				{
-					auto wrapped_obj = NewObject<UMockUObject>();
-					auto default_obj = new SimpleObject{MethodEnum::Default};
-					bool executed = false;
-					auto testing_obj = TOptionalPtr<UMockUObject>(wrapped_obj).
-						MapStatic(static_cast<SimpleObject*(*)(MockObject*, bool&)>(&MockObject::OverloadedStaticFunction), executed);
-					TestTrue("", testing_obj.IsSet());
-					TestTrue("", executed);
-					TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<SimpleObject>>::value);
-				
-					wrapped_obj->Destroy();
-					delete default_obj;
-				});
-			});
-	
-			Describe("when not valid", [this]()
-			{
-				BeforeEach([this]()
-				{
-					m_wrapped_obj = nullptr;
-				});
-				
-				It("should map a function and return empty optional", [this]()
-					{MapStaticTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::StaticFunction);});
-			});
-		});
-	
-		Describe("when given a wrapped non-UObject pointer", [this]()
-		{
-			Describe("when valid", [this]()
-			{
-				BeforeEach([this]()
-				{
-					m_wrapped_obj = new MockNonUObject();
-				});
-				AfterEach([this]()
-				{
-					m_wrapped_obj->Destroy();
-				});
-				
-				It("should map a static function taking the wrapped object as parameter and return set optional", [this]()
-					{MapStaticTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::StaticFunction);});				
-				It("should map a static function taking the wrapped object as parameter and another copy parameter and return set optional", [this]()
-					{MapStaticTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::StaticFunctionWithParamCopy, SimpleObject{});});				
-				It("should map a static function taking the wrapped object as parameter and another reference parameter and return set optional", [this]()
-					{MapStaticTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::StaticFunctionWithConstParamRef, SimpleObject{});});
-				
-				It("should map the overloaded static function 1 and return the value", [this]()
-				{
-					auto wrapped_obj = new MockNonUObject();
-					auto default_obj = new SimpleObject{MethodEnum::Default};
-					auto testing_obj = TOptionalPtr<MockNonUObject>(wrapped_obj).
-						MapStatic(static_cast<SimpleObject*(*)(MockObject*)>(&MockObject::OverloadedStaticFunction));
-					TestTrue("", testing_obj.IsSet());
-					TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<SimpleObject>>::value);
-				
-					wrapped_obj->Destroy();
-					delete default_obj;
-				});
-				It("should map the overloaded static function 2, set reference bool and return the value", [this]()
-				{
-					auto wrapped_obj = new MockNonUObject();
-					auto default_obj = new SimpleObject{MethodEnum::Default};
-					auto testing_obj = TOptionalPtr<MockNonUObject>(wrapped_obj).
-						MapStatic(static_cast<SimpleObject*(*)(MockObject*)>(&MockObject::OverloadedStaticFunction));
-					TestTrue("", testing_obj.IsSet());
-					TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<SimpleObject>>::value);
-				
-					wrapped_obj->Destroy();
-					delete default_obj;
-				});
-			});
-			
-			Describe("when not valid", [this]()
-			{
-				BeforeEach([this]()
-				{
-					m_wrapped_obj = nullptr;
-				});
-				
-				It("should map a static function and return empty optional", [this]()
-					{MapStaticTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::StaticFunction);});
-			});
-		});
-	});
-}
-
-BEGIN_DEFINE_SPEC(FOptionalPtrPerformanceSpec, "OptionalPtr.Performance", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
-
-//https://stackoverflow.com/a/33900479
-typedef std::chrono::high_resolution_clock::time_point TimeVar;
-
-template<typename MockType, typename = std::enable_if_t<std::is_base_of<UObject, MockType>::value>>
-MockType* GetObject()
-{
-	return NewObject<MockType>();
-}
-
-template<typename MockType, typename = std::enable_if_t<!std::is_base_of<UObject, MockType>::value>>
-MockType* GetObject(bool dont_set = false)
-{
-	return new MockType();
-}
-
-template<typename MockType, typename F>
-double GetExecutionTime(uint32 reps, F func){
-	using namespace std::chrono;
-
-	MockType* obj1 = GetObject<MockType>();
-	MockType* obj2 = GetObject<MockType>();
-
-	const TimeVar time_now = high_resolution_clock::now();
-	for (uint32 i = 0; i < reps; ++i)
-	{
-		//has to be member function template, specialized static function template won't compile on PS4 
-		(this->*func)(obj1, obj2);
-	}
-	const auto exec_time = duration_cast<nanoseconds>(high_resolution_clock::now() - time_now).count();
-	
-	obj1->Destroy();
-	obj2->Destroy();
-	
-	return exec_time;
-}
-//END
-
-template<uint8 NumOfCalls>
-UMockUObject* RegularFlowUObject(UMockUObject* obj1, UMockUObject* obj2);
-
-template<>
-UMockUObject* RegularFlowUObject<1>(UMockUObject* obj1, UMockUObject* obj2)
-{
-	UMockUObject* obj = obj1;
-	UMockUObject* result = nullptr;
-
-	if (IsValid(obj))
-		result = obj->GetRandomObject(obj1, obj2);
-
-	return result;
-}
-
-template<>
-UMockUObject* RegularFlowUObject<2>(UMockUObject* obj1, UMockUObject* obj2)
-{
-	UMockUObject* obj = obj1;
-	UMockUObject* result = nullptr;
-
-	if (!IsValid(obj))
-		return nullptr;
-		
-	auto result1 = obj->GetRandomObject(obj1, obj2);
-	if (!IsValid(result1))
-		return nullptr;
-		
-	result = result1->GetRandomObject(obj1, obj2);
-
-	return result;
-}
-
-template<>
-UMockUObject* RegularFlowUObject<3>(UMockUObject* obj1, UMockUObject* obj2)
-{
-	UMockUObject* obj = obj1;
-	UMockUObject* result = nullptr;
-
-	if (!IsValid(obj))
-		return nullptr;
-		
-	auto result1 = obj->GetRandomObject(obj1, obj2);
-	if (!IsValid(result1))
-		return nullptr;
-		
-	auto result2 = result1->GetRandomObject(obj1, obj2);
-	if (!IsValid(result2))
-		return nullptr;
-
-	result = result2->GetRandomObject(obj1, obj2);
-
-	return result;
-}
-
-template<>
-UMockUObject* RegularFlowUObject<4>(UMockUObject* obj1, UMockUObject* obj2)
-{
-	UMockUObject* obj = obj1;
-	UMockUObject* result = nullptr;
-
-	if (!IsValid(obj))
-		return nullptr;
-	
-	auto result1 = obj->GetRandomObject(obj1, obj2);
-	if (!IsValid(result1))
-		return nullptr;
-	
-	auto result2 = result1->GetRandomObject(obj1, obj2);
-	if (!IsValid(result2))
-		return nullptr;
-
-	auto result3 = result2->GetRandomObject(obj1, obj2);
-	if (!IsValid(result3))
-		return nullptr;
-	
-	result = result3->GetRandomObject(obj1, obj2);
-
-	return result;
-}
-
-template<uint8 NumOfCalls>
-MockNonUObject* RegularFlowNonUObject(MockNonUObject* obj1, MockNonUObject* obj2);
-
-template<>
-MockNonUObject* RegularFlowNonUObject<1>(MockNonUObject* obj1, MockNonUObject* obj2)
-{
-	MockNonUObject* obj = obj1;
-	MockNonUObject* result = nullptr;
-
-	if (obj != nullptr)
-		result = obj->GetRandomObject(obj1, obj2);
-
-	return result;
-}
-
-template<>
-MockNonUObject* RegularFlowNonUObject<2>(MockNonUObject* obj1, MockNonUObject* obj2)
-{
-	MockNonUObject* obj = obj1;
-
-	if (obj == nullptr)
-		return nullptr;
-		
-	auto result1 = obj->GetRandomObject(obj1, obj2);
-	if (result1 == nullptr)
-		return nullptr;
-		
-	return result1->GetRandomObject(obj1, obj2);
-}
-
-template<>
-MockNonUObject* RegularFlowNonUObject<3>(MockNonUObject* obj1, MockNonUObject* obj2)
-{
-	MockNonUObject* obj = obj1;
-
-	if (obj == nullptr)
-		return nullptr;
-		
-	auto result1 = obj->GetRandomObject(obj1, obj2);
-	if (result1 == nullptr)
-		return nullptr;
-	
-	auto result2 = obj->GetRandomObject(obj1, obj2);
-	if (result2 == nullptr)
-		return nullptr;
-		
-	return result2->GetRandomObject(obj1, obj2);
-}
-
-template<>
-MockNonUObject* RegularFlowNonUObject<4>(MockNonUObject* obj1, MockNonUObject* obj2)
-{
-	MockNonUObject* obj = obj1;
-
-	if (obj == nullptr)
-		return nullptr;
-		
-	auto result1 = obj->GetRandomObject(obj1, obj2);
-	if (result1 == nullptr)
-		return nullptr;
-	
-	auto result2 = obj->GetRandomObject(obj1, obj2);
-	if (result2 == nullptr)
-		return nullptr;
-	
-	auto result3 = obj->GetRandomObject(obj1, obj2);
-	if (result3 == nullptr)
-		return nullptr;
-		
-	return result3->GetRandomObject(obj1, obj2);
-}
-
-template<uint8 NumOfCalls>
-UMockUObject* MapFlowUObject(UMockUObject* obj1, UMockUObject* obj2);
-
-template<>
-UMockUObject* MapFlowUObject<1>(UMockUObject* obj1, UMockUObject* obj2)
-{
-	return TOptionalPtr<UMockUObject>(obj1).Map(&UMockUObject::GetRandomObject, obj1, obj2).Get();
-}
-
-template<>
-UMockUObject* MapFlowUObject<2>(UMockUObject* obj1, UMockUObject* obj2)
-{
-	return TOptionalPtr<UMockUObject>(obj1)
-		.Map(&UMockUObject::GetRandomObject, obj1, obj2)
-		.Map(&UMockUObject::GetRandomObject, obj1, obj2).Get();
-}
-
-template<>
-UMockUObject* MapFlowUObject<3>(UMockUObject* obj1, UMockUObject* obj2)
-{
-	return TOptionalPtr<UMockUObject>(obj1)
-		.Map(&UMockUObject::GetRandomObject, obj1, obj2)
-		.Map(&UMockUObject::GetRandomObject, obj1, obj2)
-		.Map(&UMockUObject::GetRandomObject, obj1, obj2).Get();
-}
-
-template<>
-UMockUObject* MapFlowUObject<4>(UMockUObject* obj1, UMockUObject* obj2)
-{
-	return TOptionalPtr<UMockUObject>(obj1)
-		.Map(&UMockUObject::GetRandomObject, obj1, obj2)
-		.Map(&UMockUObject::GetRandomObject, obj1, obj2)
-		.Map(&UMockUObject::GetRandomObject, obj1, obj2)
-		.Map(&UMockUObject::GetRandomObject, obj1, obj2).Get();
-}
-
-template<uint8 NumOfCalls>
-MockNonUObject* MapFlowNonUObject(MockNonUObject* obj1, MockNonUObject* obj2);
-
-template<>
-MockNonUObject* MapFlowNonUObject<1>(MockNonUObject* obj1, MockNonUObject* obj2)
-{
-	return TOptionalPtr<MockNonUObject>(obj1).Map(&MockNonUObject::GetRandomObject, obj1, obj2).Get();
-}
-
-template<>
-MockNonUObject* MapFlowNonUObject<2>(MockNonUObject* obj1, MockNonUObject* obj2)
-{
-	return TOptionalPtr<MockNonUObject>(obj1)
-		.Map(&MockNonUObject::GetRandomObject, obj1, obj2)
-		.Map(&MockNonUObject::GetRandomObject, obj1, obj2).Get();
-}
-
-template<>
-MockNonUObject* MapFlowNonUObject<3>(MockNonUObject* obj1, MockNonUObject* obj2)
-{
-	return TOptionalPtr<MockNonUObject>(obj1)
-		.Map(&MockNonUObject::GetRandomObject, obj1, obj2)
-		.Map(&MockNonUObject::GetRandomObject, obj1, obj2)
-		.Map(&MockNonUObject::GetRandomObject, obj1, obj2).Get();
-}
-
-template<>
-MockNonUObject* MapFlowNonUObject<4>(MockNonUObject* obj1, MockNonUObject* obj2)
-{
-	return TOptionalPtr<MockNonUObject>(obj1)
-		.Map(&MockNonUObject::GetRandomObject, obj1, obj2)
-		.Map(&MockNonUObject::GetRandomObject, obj1, obj2)
-		.Map(&MockNonUObject::GetRandomObject, obj1, obj2)
-		.Map(&MockNonUObject::GetRandomObject, obj1, obj2).Get();
-}
-
-const static uint32 num_of_repetitions = 100000;
-
-template<uint8 NumOfCalls, bool IsUObject, typename MockType, typename = std::enable_if_t<IsUObject>>
-double GetExecTimeInternal()
-{
-	return GetExecutionTime<MockType>(num_of_repetitions, &FOptionalPtrPerformanceSpec::RegularFlowUObject<NumOfCalls>);
-}
-
-template<uint8 NumOfCalls, bool IsUObject, typename MockType, typename = std::enable_if_t<!IsUObject>>
-double GetExecTimeInternal(bool dont_set = false)
-{
-	return GetExecutionTime<MockType>(num_of_repetitions, &FOptionalPtrPerformanceSpec::RegularFlowNonUObject<NumOfCalls>);
-}
-
-template<uint8 NumOfCalls, bool IsUObject = true, typename = std::enable_if_t<IsUObject>>
-void CompareExecutionTimes()
-{
-	const auto map_exec_time = GetExecutionTime<UMockUObject>(num_of_repetitions, &FOptionalPtrPerformanceSpec::MapFlowUObject<NumOfCalls>);
-	AddInfo(FString::Printf(TEXT("Execution time for Map approach: %f ns"), map_exec_time));
-	AddInfo(FString::Printf(TEXT("Execution time for regular approach: %f ns"),
-		GetExecTimeInternal<NumOfCalls, IsUObject, UMockUObject>()));
-}
-
-template<uint8 NumOfCalls, bool IsUObject = true, typename = std::enable_if_t<!IsUObject>>
-void CompareExecutionTimes(bool dont_set = false)
-{
-	const auto map_exec_time = GetExecutionTime<MockNonUObject>(num_of_repetitions, &FOptionalPtrPerformanceSpec::MapFlowNonUObject<NumOfCalls>);
-	AddInfo(FString::Printf(TEXT("Execution time for Map approach: %f ns"), map_exec_time));
-	AddInfo(FString::Printf(TEXT("Execution time for regular approach: %f ns"),
-		GetExecTimeInternal<NumOfCalls, IsUObject, MockNonUObject>()));
-}
-END_DEFINE_SPEC(FOptionalPtrPerformanceSpec)
-
-void FOptionalPtrPerformanceSpec::Define()
-{
-	Describe("Map", [this]()
-	{
-		Describe("when given a wrapped UObject pointer", [this]()
-		{
-			It(FString::Printf(TEXT("should log the performance for 1 call with validation over %u repetitions"),
-				num_of_repetitions), [this]()
-			{
-				CompareExecutionTimes<1>();
-			});
-			It(FString::Printf(TEXT("should log the performance for 2 calls with validation over %u repetitions"),
-				num_of_repetitions), [this]()
-			{
-				CompareExecutionTimes<2>();
-			});
-			It(FString::Printf(TEXT("should log the performance for 3 calls with validation over %u repetitions"),
-				num_of_repetitions), [this]()
-			{
-				CompareExecutionTimes<3>();
-			});
-			It(FString::Printf(TEXT("should log the performance for 4 calls with validation over %u repetitions"),
-				num_of_repetitions), [this]()
-			{
-				CompareExecutionTimes<4>();
-			});
-		});
-		Describe("when given a wrapped non-UObject pointer", [this]()
-		{
-			It(FString::Printf(TEXT("should log the performance for 1 call with validation over %u repetitions"),
-				num_of_repetitions), [this]()
-			{
-				CompareExecutionTimes<1, false>();
-			});
-			It(FString::Printf(TEXT("should log the performance for 2 calls with validation over %u repetitions"),
-				num_of_repetitions), [this]()
-			{
-				CompareExecutionTimes<2, false>();
-			});
-			It(FString::Printf(TEXT("should log the performance for 3 calls with validation over %u repetitions"),
-				num_of_repetitions), [this]()
-			{
-				CompareExecutionTimes<3, false>();
-			});
-			It(FString::Printf(TEXT("should log the performance for 4 calls with validation over %u repetitions"),
-				num_of_repetitions), [this]()
-			{
-				CompareExecutionTimes<4, false>();
-			});
-		});
-	});
+#include "OptionalPtrSpec.h"
+#include "OptionalPtr.h"
+#include "OptionalPtrAncestorCache.h"
+#include "OptionalPtrBinding.h"
+#include "OptionalPtrChain.h"
+#include "OptionalPtrCommandBuffer.h"
+#include "OptionalPtrCoroutine.h"
+#include "OptionalPtrEpoch.h"
+#include "OptionalPtrFuture.h"
+#include "OptionalPtrHazard.h"
+#include "OptionalPtrParallel.h"
+#include "OptionalPtrPathResolver.h"
+#include "OptionalPtrRequestQueue.h"
+#include "OptionalPtrSnapshot.h"
+#include "OptionalPtrTimeSlicer.h"
+#include "OptionalPtrTry.h"
+#include "Async/ParallelFor.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeRWLock.h"
+
+#include <atomic>
+#include <chrono>
+#include <utility>
+
+using namespace OptionalPtrLiterals;
+
+BEGIN_DEFINE_SPEC(FOptionalPtrSpec, "OptionalPtr.Unit", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+MockObject* m_wrapped_obj = nullptr;
+MockObject* m_default_obj = nullptr;
+
+template<typename ResultType, typename FuncObjectType, typename = std::enable_if_t<std::is_member_function_pointer<FuncObjectType>::value>, typename... Args>
+ResultType GetResult(FuncObjectType&& func, Args&&... args)
+{
+	return (m_wrapped_obj->*func)(std::forward<Args>(args)...);
+}
+
+template<typename ResultType, typename FuncObjectType, typename = std::enable_if_t<std::is_member_object_pointer<FuncObjectType>::value>>
+ResultType GetResult(FuncObjectType&& field)
+{
+	return m_wrapped_obj->*field;
+}
+
+template<typename MockType, typename FuncObjectType>
+void IfPresentTest(FuncObjectType&& func)
+{
+	bool executed = false;
+	TOptionalPtr<MockType>((MockType*)m_wrapped_obj).IfPresent(std::forward<FuncObjectType>(func), executed);
+	TestTrue("", m_wrapped_obj != nullptr ? executed : !executed);
+}
+
+template<typename MockType, typename DefaultType>
+void OrElseTest()
+{
+	auto testing_obj = TOptionalPtr<MockType>((MockType*)m_wrapped_obj).OrElse((DefaultType*)m_default_obj);
+	TestTrue("", testing_obj.IsSet());
+	TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<DefaultType>>::value);
+	TestEqual<MockObject*>("", testing_obj.Get(), m_wrapped_obj != nullptr ? m_wrapped_obj : m_default_obj);
+}
+
+template<typename ResultType, typename MockType, typename FuncObjectType, typename... Args>
+void MapTest(FuncObjectType&& func, Args&&... args)
+{
+	auto testing_obj = TOptionalPtr<MockType>((MockType*)(m_wrapped_obj)).Map(std::forward<FuncObjectType>(func), std::forward<Args>(args)...);
+	TestTrue("", m_wrapped_obj != nullptr ? testing_obj.IsSet() : !testing_obj.IsSet());
+	TestTrue("", std::is_same<decltype(testing_obj), ResultType>::value);
+	if (m_wrapped_obj)
+	{
+		TestTrue("", *testing_obj.Get() == *GetResult<decltype(testing_obj.Get())>(std::forward<FuncObjectType>(func), std::forward<Args>(args)...));
+	}
+}
+
+template<typename ResultType, typename MockType, typename FuncObjectType, typename... Args>
+void MapToValueTest(FuncObjectType&& func, Args&&... args)
+{
+	auto default_obj = new std::remove_pointer_t<ResultType>(MethodEnum::Default);
+	auto testing_obj = TOptionalPtr<MockType>((MockType*)m_wrapped_obj).MapToValue(default_obj,
+		std::forward<FuncObjectType>(func), std::forward<Args>(args)...);
+		
+	ResultType result = default_obj;
+	if (m_wrapped_obj != nullptr)
+	{
+		result = GetResult<ResultType>(std::forward<FuncObjectType>(func), std::forward<Args>(args)...);
+	}
+	
+	TestEqual("", *testing_obj, *result);
+	TestTrue("", std::is_same<decltype(testing_obj), ResultType>::value);
+
+	delete default_obj;
+}
+
+template<typename ResultType, typename MockType, typename FuncObjectType, typename... Args>
+void MapStaticTest(FuncObjectType&& func, Args&&... args)
+{
+	auto testing_obj = TOptionalPtr<MockType>((MockType*)(m_wrapped_obj)).MapStatic(std::forward<FuncObjectType>(func), std::forward<Args>(args)...);
+	TestTrue("", m_wrapped_obj != nullptr ? testing_obj.IsSet() : !testing_obj.IsSet());
+	TestTrue("", std::is_same<decltype(testing_obj), ResultType>::value);
+}
+
+template<typename ResultType, typename MockType, typename MemberType>
+void MapAtTest(MemberType&& member, int32 index, bool should_be_set)
+{
+	auto testing_obj = TOptionalPtr<MockType>((MockType*)m_wrapped_obj).MapAt(std::forward<MemberType>(member), index);
+	TestTrue("", should_be_set ? testing_obj.IsSet() : !testing_obj.IsSet());
+	TestTrue("", std::is_same<decltype(testing_obj), ResultType>::value);
+	if (should_be_set)
+	{
+		TestEqual("", *testing_obj.Get(), SimpleObject(MethodEnum::Method));
+	}
+}
+
+template<typename ResultType, typename MockType, typename MemberType, typename KeyType>
+void MapFindTest(MemberType&& member, const KeyType& key, bool should_be_set)
+{
+	auto testing_obj = TOptionalPtr<MockType>((MockType*)m_wrapped_obj).MapFind(std::forward<MemberType>(member), key);
+	TestTrue("", should_be_set ? testing_obj.IsSet() : !testing_obj.IsSet());
+	TestTrue("", std::is_same<decltype(testing_obj), ResultType>::value);
+	if (should_be_set)
+	{
+		TestEqual("", *testing_obj.Get(), SimpleObject(MethodEnum::Method));
+	}
+}
+
+template<typename ResultType, typename MockType, uint64 NameHash, typename MemberType>
+void MapFindNameTest(MemberType&& member, bool should_be_set)
+{
+	auto testing_obj = TOptionalPtr<MockType>((MockType*)m_wrapped_obj).template MapFind<NameHash>(std::forward<MemberType>(member));
+	TestTrue("", should_be_set ? testing_obj.IsSet() : !testing_obj.IsSet());
+	TestTrue("", std::is_same<decltype(testing_obj), ResultType>::value);
+	if (should_be_set)
+	{
+		TestEqual("", *testing_obj.Get(), SimpleObject(MethodEnum::Method));
+	}
+}
+
+TArray<UMockUObject*> m_outer_chain;
+TArray<MockLinkNode*> m_link_chain;
+
+void CreateOuterChain()
+{
+	m_outer_chain.Add(NewObject<UMockUObject>());
+	m_outer_chain.Add(NewObject<UMockAncestorUObject>(m_outer_chain.Last()));
+	m_outer_chain.Add(NewObject<UMockUObject>(m_outer_chain.Last()));
+	m_outer_chain.Add(NewObject<UMockUObject>(m_outer_chain.Last()));
+}
+
+void CreateLinkChain()
+{
+	m_link_chain.Add(new MockLinkNode(3));
+	m_link_chain.Add(new MockAncestorLinkNode(2));
+	m_link_chain.Add(new MockLinkNode(1));
+	m_link_chain.Add(new MockLinkNode(0));
+	for (int32 i = m_link_chain.Num() - 1; i > 0; --i)
+	{
+		m_link_chain[i]->m_next = m_link_chain[i - 1];
+	}
+}
+
+MockWorld* m_world = nullptr;
+
+void CreateReflectedWorld()
+{
+	m_world = new MockWorld();
+	m_world->m_first_player_controller = new MockPlayerController();
+	m_world->m_first_player_controller->m_pawn = new MockPawn();
+	m_world->m_first_player_controller->m_pawn->m_health_component = new MockHealthComponent();
+}
+
+void DestroyReflectedWorld()
+{
+	MockPlayerController* controller = m_world->m_first_player_controller;
+	MockPawn* pawn = controller ? controller->m_pawn : nullptr;
+	if (pawn != nullptr)
+	{
+		delete pawn->m_health_component;
+	}
+	delete pawn;
+	delete controller;
+	delete m_world;
+	m_world = nullptr;
+}
+
+UMockPlayerController* m_player_controller = nullptr;
+
+void CreateReflectedPlayerController()
+{
+	UMockCharacter* character = NewObject<UMockCharacter>();
+	character->HealthComponent = NewObject<UMockHealthComponent>(character);
+	m_player_controller = NewObject<UMockPlayerController>();
+	m_player_controller->Pawn = character;
+}
+
+int32 m_try_steps = 0;
+
+UObject* TryGetOuterOfOuter(UMockUObject* obj)
+{
+	OPT_TRY(outer, TOptionalPtr<UMockUObject>(obj).Map(&UObject::GetOuter));
+	++m_try_steps;
+	OPT_TRY(outer_of_outer, outer->GetOuter());
+	++m_try_steps;
+	return outer_of_outer;
+}
+
+TOptionalPtr<UMockUObject> TryGetWeakLink(UMockUObject* obj)
+{
+	OPT_TRY(checked_obj, obj);
+	OPT_TRY(link, checked_obj->m_weak_link);
+	return link;
+}
+
+bool TryHasOuter(UMockUObject* obj)
+{
+	OPT_TRY_OR(outer, TOptionalPtr<UMockUObject>(obj).Map(&UObject::GetOuter), false);
+	return true;
+}
+
+void TryCountOuter(UMockUObject* obj)
+{
+	OPT_TRY_OR(outer, obj->GetOuter(), );
+	++m_try_steps;
+}
+
+#if defined(__cpp_impl_coroutine)
+int32 m_coroutine_steps = 0;
+
+TOptionalPtrCoroutine<UObject> CoroutineGetOuterOfOuter(UMockUObject* obj)
+{
+	UObject* outer = co_await TOptionalPtr<UMockUObject>(obj).Map(&UObject::GetOuter);
+	++m_coroutine_steps;
+	UObject* outer_of_outer = co_await outer->GetOuter();
+	++m_coroutine_steps;
+	co_return outer_of_outer;
+}
+
+TOptionalPtrCoroutine<MockLinkNode> CoroutineGetNextOfNext(MockLinkNode* node, SIZE_T& used_stack)
+{
+	MockLinkNode* next = co_await node->m_next;
+	used_stack = FOptionalPtrCoroutineStack::Get().GetUsed();
+	co_return next->m_next;
+}
+
+TOptionalPtrCoroutine<MockLinkNode> CoroutineGetNextOfNextOfNext(MockLinkNode* node, SIZE_T& used_stack)
+{
+	MockLinkNode* next_of_next = co_await CoroutineGetNextOfNext(node, used_stack);
+	co_return next_of_next->m_next;
+}
+#endif
+//replaces the node behind the root on one thread while the others read it, exchange returns the replaced node and
+//read returns whether the node it read was already deleted
+template<typename DomainType, typename ExchangeFuncType, typename ReadFuncType>
+void ReclamationTest(DomainType& domain, ExchangeFuncType&& exchange, ReadFuncType&& read)
+{
+	const int32 num_threads = 8;
+	const int32 num_replacements = 2000;
+	std::atomic<int32> num_destroyed{0};
+	std::atomic<int32> num_invalid_reads{0};
+	std::atomic<bool> replaced{false};
+	MockReclaimedNode root;
+	MockReclaimedNode* const first = new MockReclaimedNode();
+	first->m_num_destroyed = &num_destroyed;
+	exchange(root, first);
+	ParallelFor(num_threads, [&](int32 thread)
+	{
+		if (thread == 0)
+		{
+			for (int32 i = 0; i < num_replacements; ++i)
+			{
+				MockReclaimedNode* const next = new MockReclaimedNode();
+				next->m_num_destroyed = &num_destroyed;
+				domain.Retire(exchange(root, next));
+			}
+			replaced = true;
+			//the rest of the retired objects is deleted once the readers finish
+			while (num_destroyed < num_replacements)
+			{
+				domain.Reclaim();
+			}
+			return;
+		}
+		while (!replaced)
+		{
+			num_invalid_reads += read(root);
+		}
+	});
+	delete exchange(root, nullptr);
+
+	TestEqual("", num_invalid_reads.load(), 0);
+	TestEqual("", num_destroyed.load(), num_replacements + 1);
+}
+
+#if OPTIONAL_PTR_STATS
+const uint32 m_stats_chain_line = __LINE__ + 4;
+
+int32 StatsChainValue(MockLinkNode* node)
+{
+	return TOptionalPtr<MockLinkNode>(node).Map(&MockLinkNode::m_next).Map(&MockLinkNode::m_next).MapToValue(-1, &MockLinkNode::m_value);
+}
+
+const uint32 m_stats_get_line = __LINE__ + 4;
+
+MockLinkNode* StatsChainGet(MockLinkNode* node)
+{
+	return TOptionalPtr<MockLinkNode>(node).Map(&MockLinkNode::m_next).Get();
+}
+
+const uint32 m_stats_get_or_else_line = __LINE__ + 4;
+
+MockLinkNode* StatsChainGetOrElse(MockLinkNode* node, MockLinkNode* fallback)
+{
+	return TOptionalPtr<MockLinkNode>(node).Map(&MockLinkNode::m_next).GetOrElse(fallback);
+}
+
+FOptionalPtrSiteStats FindStatsSite(uint32 line)
+{
+	for (const FOptionalPtrSiteStats& site : FOptionalPtrStats::Collect())
+	{
+		if (site.Line == line && FCStringAnsi::Strcmp(site.File, __FILE__) == 0)
+			return site;
+	}
+	return FOptionalPtrSiteStats();
+}
+#endif
+END_DEFINE_SPEC(FOptionalPtrSpec)
+
+void FOptionalPtrSpec::Define()
+{
+	Describe("Map", [this]()
+	{
+		Describe("when given a wrapped UObject pointer", [this]()
+		{
+			Describe("when valid", [this]()
+			{
+				BeforeEach([this]()
+				{
+					m_wrapped_obj = NewObject<UMockUObject>();
+				});
+				AfterEach([this]()
+				{
+					m_wrapped_obj->Destroy();
+				});
+				It("should map a non-const method and return set optional", [this]()
+					{MapTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::Method);});
+				It("should map a const method and return set optional", [this]()
+					{MapTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::MethodConst);});
+				It("should map a method returning const data and return set optional", [this]()
+					{MapTest<TOptionalPtr<const SimpleObject>, UMockUObject>(&MockObject::ConstMethod);});
+				It("should map a const method returning const data and return set optional", [this]()
+					{MapTest<TOptionalPtr<const SimpleObject>, UMockUObject>(&MockObject::ConstMethodConst);});
+				It("should map a method returning const pointer and return set optional", [this]()
+					{MapTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::ConstPointerMethod);});
+				It("should map a const method returning const pointer and return set optional", [this]()
+					{MapTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::ConstPointerMethodConst);});
+				It("should map a non-const field and return set optional", [this]()
+					{MapTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::m_field);});
+				It("should map a const field and return set optional", [this]()
+					{MapTest<TOptionalPtr<const SimpleObject>, UMockUObject>(&MockObject::m_const_field);});
+				It("should map a field with const pointer and return set optional", [this]()
+					{MapTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::m_field_const);});
+				
+				It("should map a method with copy parameter and return set optional", [this]()
+					{MapTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::MethodWithParamCopy, SimpleObject{});});
+				It("should map a method with pointer parameter and return set optional", [this]()
+					{MapTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::MethodWithParamPointer, new SimpleObject());});
+				It("should map a method with const pointer parameter and return set optional", [this]()
+					{MapTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::MethodWithConstParamPointer, new SimpleObject());});
+				It("should map a method with const reference parameter and return set optional", [this]()
+					{MapTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::MethodWithConstParamRef, SimpleObject{});});
+				It("should map a method with non-const reference parameter and return set optional", [this]()
+				{
+					SimpleObject simple_object {};
+					MapTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::MethodWithParamRef, simple_object);
+				});
+				It("should map a method with r-value parameter and return set optional", [this]()
+					{MapTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::MethodWithParamRValue, SimpleObject{});});
+				It("should map a method with multiple parameters and return set optional", [this]()
+					{MapTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::MethodWithMultipleParams, SimpleObject{}, 0, 0.f);});
+				
+				It("should map the overloaded method 1 and return set optional", [this]()
+				{
+					auto testing_obj = TOptionalPtr<UMockUObject>((UMockUObject*)(m_wrapped_obj)).
+						Map(static_cast<SimpleObject*(MockObject::*)()>(&MockObject::OverloadedMethod));
+					TestTrue("", testing_obj.IsSet());
+					TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<SimpleObject>>::value);
+				});
+				It("should map the overloaded method 2 and return set optional", [this]()
+				{
+					bool executed = false;
+					auto testing_obj = TOptionalPtr<UMockUObject>((UMockUObject*)m_wrapped_obj).
+						Map(static_cast<SimpleObject*(MockObject::*)(bool&)>(&MockObject::OverloadedMethod), executed);
+					TestTrue("", testing_obj.IsSet());
+					TestTrue("", executed);
+					TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<SimpleObject>>::value);
+				});
+			});
+
+			Describe("when not valid", [this]()
+			{
+				BeforeEach([this]()
+				{
+					m_wrapped_obj = nullptr;
+				});
+				It("should map a method and return empty optional", [this]()
+					{MapTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::Method);});
+			});
+		});
+
+		Describe("when given a wrapped non-UObject pointer", [this]()
+		{
+			Describe("when valid", [this]()
+			{
+				BeforeEach([this]()
+				{
+					m_wrapped_obj = new MockNonUObject();
+				});
+				AfterEach([this]()
+				{
+					m_wrapped_obj->Destroy();
+				});
+				It("should map a non-const method and return set optional", [this]()
+					{MapTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::Method);});
+				It("should map a const method and return set optional", [this]()
+					{MapTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::MethodConst);});
+				It("should map a method returning const data and return set optional", [this]()
+					{MapTest<TOptionalPtr<const SimpleObject>, MockNonUObject>(&MockObject::ConstMethod);});
+				It("should map a const method returning const data and return set optional", [this]()
+					{MapTest<TOptionalPtr<const SimpleObject>, MockNonUObject>(&MockObject::ConstMethodConst);});
+				It("should map a method returning const pointer and return set optional", [this]()
+					{MapTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::ConstPointerMethod);});
+				It("should map a const method returning const pointer and return set optional", [this]()
+					{MapTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::ConstPointerMethodConst);});
+				It("should map a non-const field and return set optional", [this]()
+					{MapTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::m_field);});
+				It("should map a const field and return set optional", [this]()
+					{MapTest<TOptionalPtr<const SimpleObject>, MockNonUObject>(&MockObject::m_const_field);});
+				It("should map a field with const pointer and return set optional", [this]()
+					{MapTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::m_field_const);});
+
+				It("should map a method with copy parameter and return set optional", [this]()
+					{MapTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::MethodWithParamCopy, SimpleObject{});});
+				It("should map a method with pointer parameter and return set optional", [this]()
+					{MapTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::MethodWithParamPointer, new SimpleObject{});});
+				It("should map a method with const pointer parameter and return set optional", [this]()
+					{MapTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::MethodWithConstParamPointer, new SimpleObject{});});
+				It("should map a method with const reference parameter and return set optional", [this]()
+					{MapTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::MethodWithConstParamRef, SimpleObject{});});
+				It("should map a method with non-const reference parameter and return set optional", [this]()
+				{
+					SimpleObject simple_object {};
+					MapTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::MethodWithParamRef, simple_object);
+				});
+				It("should map a method with r-value parameter and return set optional", [this]()
+					{MapTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::MethodWithParamRValue, SimpleObject{});});
+				It("should map a method with multiple parameters and return set optional", [this]()
+					{MapTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::MethodWithMultipleParams, SimpleObject{}, 0, 0.f);});
+
+				It("should map the overloaded method 1 and return set optional", [this]()
+				{
+					auto testing_obj = TOptionalPtr<MockNonUObject>((MockNonUObject*)m_wrapped_obj).
+						Map(static_cast<SimpleObject*(MockObject::*)()>(&MockObject::OverloadedMethod));
+					TestTrue("", testing_obj.IsSet());
+					TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<SimpleObject>>::value);
+				});
+				It("should map the overloaded method 2 and return set optional", [this]()
+				{
+					bool executed = false;
+					auto testing_obj = TOptionalPtr<MockNonUObject>((MockNonUObject*)m_wrapped_obj).
+						Map(static_cast<SimpleObject*(MockObject::*)(bool&)>(&MockObject::OverloadedMethod), executed);
+					TestTrue("", testing_obj.IsSet());
+					TestTrue("", executed);
+					TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<SimpleObject>>::value);
+				});
+			});
+			
+			Describe("when not valid", [this]()
+			{
+				BeforeEach([this]()
+				{
+					m_wrapped_obj = nullptr;
+				});
+				It("should map a method and return empty optional", [this]()
+					{MapTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::Method);});
+			});
+		});
+	});
+	Describe("IfPresent", [this]()
+	{
+		Describe("when given a wrapped UObject pointer", [this]()
+		{
+			Describe("when valid", [this]()
+			{
+				BeforeEach([this]()
+				{
+					m_wrapped_obj = NewObject<UMockUObject>();
+				});
+				AfterEach([this]()
+				{
+					m_wrapped_obj->Destroy();
+				});
+				It("should execute a non-const method", [this]()
+				{
+					IfPresentTest<UMockUObject>(&MockObject::Method2WithParamRef);
+				});
+
+				It("should execute a const method", [this]()
+				{
+					IfPresentTest<UMockUObject>(&MockObject::MethodConstWithParamRef);
+				});
+			});
+
+			Describe("when not valid", [this]()
+			{
+				BeforeEach([this]()
+				{
+					m_wrapped_obj = nullptr;
+				});
+				
+				It("should not execute a non-const method", [this]()
+				{
+					IfPresentTest<UMockUObject>(&MockObject::Method2WithParamRef);
+				}); 
+
+				It("should not execute a const method", [this]()
+				{
+					IfPresentTest<UMockUObject>(&MockObject::MethodConstWithParamRef);
+				});
+			});
+		});
+
+		Describe("when given a wrapped non-UObject pointer", [this]()
+		{
+			Describe("when valid", [this]()
+			{
+				BeforeEach([this]()
+				{
+					m_wrapped_obj = new MockNonUObject();
+				});
+				AfterEach([this]()
+				{
+					m_wrapped_obj->Destroy();
+				});
+				
+				It("should execute a non-const method", [this]()
+				{
+					IfPresentTest<MockNonUObject>(&MockObject::Method2WithParamRef);
+				});
+
+				It("should execute a const method", [this]()
+				{
+					IfPresentTest<MockNonUObject>(&MockObject::MethodConstWithParamRef);
+				});
+			});
+
+			Describe("when not valid", [this]()
+			{
+				BeforeEach([this]()
+				{
+					m_wrapped_obj = nullptr;
+				});
+				
+				It("should not execute a non-const method", [this]()
+				{
+					IfPresentTest<MockNonUObject>(&MockObject::Method2WithParamRef);
+				});
+
+				It("should not execute a const method", [this]()
+				{
+					IfPresentTest<MockNonUObject>(&MockObject::MethodConstWithParamRef);
+				});
+			});
+		});
+
+	});
+	Describe("OrElse", [this]()
+	{
+		Describe("when given a wrapped UObject pointer", [this]()
+		{
+			Describe("when valid", [this]()
+			{
+				BeforeEach([this]()
+				{
+					m_wrapped_obj = NewObject<UMockUObject>();
+					m_default_obj = NewObject<UMockUObject>();
+				});
+				AfterEach([this]()
+				{
+					m_wrapped_obj->Destroy();
+					m_default_obj->Destroy();
+				});
+				
+				It("should return the initial wrapped object", [this]()
+				{
+					OrElseTest<UMockUObject, UMockUObject>();
+				});
+			});
+
+			Describe("when not valid", [this]()
+			{
+				BeforeEach([this]()
+				{
+					m_wrapped_obj = nullptr;
+					m_default_obj = NewObject<UMockUObject>();
+				});
+				AfterEach([this]()
+				{
+					m_default_obj->Destroy();
+				});
+				
+				It("should return the wrapped default object", [this]()
+				{
+					OrElseTest<UMockUObject, UMockUObject>();
+				});
+			});
+		});
+		Describe("when given a wrapped non-UObject pointer", [this]()
+		{
+			Describe("when valid", [this]()
+			{
+				BeforeEach([this]()
+				{
+					m_wrapped_obj = new MockNonUObject();
+					m_default_obj = new MockNonUObject();
+				});
+				AfterEach([this]()
+				{
+					m_wrapped_obj->Destroy();
+					m_default_obj->Destroy();
+				});
+				
+				It("should return the initial wrapped object", [this]()
+				{
+					OrElseTest<MockNonUObject, MockNonUObject>();
+				});
+			});
+
+			Describe("when not valid", [this]()
+			{
+				BeforeEach([this]()
+				{
+					m_wrapped_obj = nullptr;
+					m_default_obj = new MockNonUObject();
+				});
+				AfterEach([this]()
+				{
+					m_default_obj->Destroy();
+				});
+				
+				It("should return the wrapped default object", [this]()
+				{
+					OrElseTest<MockNonUObject, MockNonUObject>();
+				});
+			});
+		});
+	});
+	Describe("MapToValue", [this]()
+	{
+		Describe("when given a wrapped UObject pointer", [this]()
+		{
+			Describe("when valid", [this]()
+			{
+				BeforeEach([this]()
+				{
+					m_wrapped_obj = NewObject<UMockUObject>();
+				});
+				AfterEach([this]()
+				{
+					m_wrapped_obj->Destroy();
+				});
+				
+				It("should map a non-const method and return the value", [this]()
+					{MapToValueTest<SimpleObject*, UMockUObject>(&MockObject::Method);});
+				It("should map a const method and return the value", [this]()
+					{MapToValueTest<SimpleObject*, UMockUObject>(&MockObject::MethodConst);});
+				It("should map a method returning const data and return the value", [this]()
+					{MapToValueTest<const SimpleObject*, UMockUObject>(&MockObject::ConstMethod);});
+				It("should map a const method returning const data and return the value", [this]()
+					{MapToValueTest<const SimpleObject*, UMockUObject>(&MockObject::ConstMethodConst);});
+				It("should map a method returning const pointer and return the value", [this]()
+					{MapToValueTest<SimpleObject*, UMockUObject>(&MockObject::ConstPointerMethod);});
+				It("should map a const method returning const pointer and return the value", [this]()
+					{MapToValueTest<SimpleObject*, UMockUObject>(&MockObject::ConstPointerMethodConst);});
+				It("should map a non-const field and return the value", [this]()
+					{MapToValueTest<SimpleObject*, UMockUObject>(&MockObject::m_field);});
+				It("should map a const field and return the value", [this]()
+					{MapToValueTest<const SimpleObject*, UMockUObject>(&MockObject::m_const_field);});
+				It("should map a field with const pointer and return the value", [this]()
+					{MapToValueTest<SimpleObject*, UMockUObject>(&MockObject::m_field_const);});
+
+				It("should map the overloaded method 1 and return the value", [this]()
+				{
+					auto wrapped_obj = NewObject<UMockUObject>();
+					auto default_obj = new SimpleObject{MethodEnum::Default};
+					auto testing_obj = TOptionalPtr<UMockUObject>(wrapped_obj).
+						MapToValue(default_obj, static_cast<SimpleObject*(MockObject::*)()>(&MockObject::OverloadedMethod));
+					TestEqual("", *testing_obj, *wrapped_obj->OverloadedMethod());
+					TestTrue("", std::is_same<decltype(testing_obj), SimpleObject*>::value);
+
+					wrapped_obj->Destroy();
+					delete default_obj;
+				});
+				It("should map the overloaded method 2 and return the value", [this]()
+				{
+					auto wrapped_obj = NewObject<UMockUObject>();
+					auto default_obj = new SimpleObject{MethodEnum::Default};
+					bool executed = false;
+					auto testing_obj = TOptionalPtr<UMockUObject>(wrapped_obj).
+						MapToValue(default_obj, static_cast<SimpleObject*(MockObject::*)(bool&)>(&MockObject::OverloadedMethod), executed);
+					TestTrue("", executed);
+					TestEqual("", *testing_obj, *wrapped_obj->OverloadedMethod(executed));
+					TestTrue("", std::is_same<decltype(testing_obj), SimpleObject*>::value);
+
+					wrapped_obj->Destroy();
+					delete default_obj;
+				});
+			});
+	
+			Describe("when not valid", [this]()
+			{
+				BeforeEach([this]()
+				{
+					m_wrapped_obj = nullptr;
+				});
+				
+				It("should map a method and return the default value", [this]()
+					{MapToValueTest<SimpleObject*, UMockUObject>(&MockObject::Method);});
+			});
+		});
+	
+		Describe("when given a wrapped non-UObject pointer", [this]()
+		{
+			Describe("when valid", [this]()
+			{
+				BeforeEach([this]()
+				{
+					m_wrapped_obj = new MockNonUObject();
+				});
+				AfterEach([this]()
+				{
+					m_wrapped_obj->Destroy();
+				});
+				
+				It("should map a non-const method and return the value", [this]()
+					{MapToValueTest<SimpleObject*, MockNonUObject>(&MockObject::Method);});
+				It("should map a const method and return the value", [this]()
+					{MapToValueTest<SimpleObject*, MockNonUObject>(&MockObject::MethodConst);});
+				It("should map a method returning const data and return the value", [this]()
+					{MapToValueTest<const SimpleObject*, MockNonUObject>(&MockObject::ConstMethod);});
+				It("should map a const method returning const data and return the value", [this]()
+					{MapToValueTest<const SimpleObject*, MockNonUObject>(&MockObject::ConstMethodConst);});
+				It("should map a method returning const pointer and return the value", [this]()
+					{MapToValueTest<SimpleObject*, MockNonUObject>(&MockObject::ConstPointerMethod);});
+				It("should map a const method returning const pointer and return the value", [this]()
+					{MapToValueTest<SimpleObject*, MockNonUObject>(&MockObject::ConstPointerMethodConst);});
+				It("should map a non-const field and return the value", [this]()
+					{MapToValueTest<SimpleObject*, MockNonUObject>(&MockObject::m_field);});
+				It("should map a const field and return the value", [this]()
+					{MapToValueTest<const SimpleObject*, MockNonUObject>(&MockObject::m_const_field);});
+				It("should map a field with const pointer and return the value", [this]()
+					{MapToValueTest<SimpleObject*, MockNonUObject>(&MockObject::m_field_const);});
+		
+				It("should map the overloaded method 1 and return the value", [this]()
+				{
+					auto wrapped_obj = new MockNonUObject();
+					auto default_obj = new SimpleObject{MethodEnum::Default};
+					auto testing_obj = TOptionalPtr<MockNonUObject>(wrapped_obj).
+						MapToValue(default_obj, static_cast<SimpleObject*(MockObject::*)()>(&MockObject::OverloadedMethod));
+					TestEqual("", *testing_obj, *wrapped_obj->OverloadedMethod());
+					TestTrue("", std::is_same<decltype(testing_obj), SimpleObject*>::value);
+
+					wrapped_obj->Destroy();
+					delete default_obj;
+				});
+				It("should map the overloaded method 2 and return the value", [this]()
+				{
+					auto wrapped_obj = new MockNonUObject();
+					auto default_obj = new SimpleObject{MethodEnum::Default};
+					bool executed = false;
+					auto testing_obj = TOptionalPtr<MockNonUObject>(wrapped_obj).
+						MapToValue(default_obj, static_cast<SimpleObject*(MockObject::*)(bool&)>(&MockObject::OverloadedMethod), executed);
+					TestTrue("", executed);
+					TestEqual("", *testing_obj, *wrapped_obj->OverloadedMethod(executed));
+					TestTrue("", std::is_same<decltype(testing_obj), SimpleObject*>::value);
+
+					wrapped_obj->Destroy();
+					delete default_obj;
+				});
+			});
+			
+			Describe("when not valid", [this]()
+			{
+				BeforeEach([this]()
+				{
+					m_wrapped_obj = nullptr;
+				});
+				
+				It("should map a method and return the default value", [this]()
+					{MapToValueTest<SimpleObject*, MockNonUObject>(&MockObject::Method);});
+			});
+		});
+	});
+	Describe("MapStatic", [this]()
+	{
+		Describe("when given a wrapped UObject pointer", [this]()
+		{
+			Describe("when valid", [this]()
+			{
+				BeforeEach([this]()
+				{
+					m_wrapped_obj = NewObject<UMockUObject>();
+				});
+				AfterEach([this]()
+				{
+					m_wrapped_obj->Destroy();
+				});
+				
+				It("should map a static function taking the wrapped object as parameter and return set optional", [this]()
+					{MapStaticTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::StaticFunction);});				
+				It("should map a static function taking the wrapped object as parameter and another copy parameter and return set optional", [this]()
+					{MapStaticTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::StaticFunctionWithParamCopy, SimpleObject{});});				
+				It("should map a static function taking the wrapped object as parameter and another reference parameter and return set optional", [this]()
+					{MapStaticTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::StaticFunctionWithConstParamRef, SimpleObject{});});
+
+				It("should map the overloaded static function 1 and return the value", [this]()
+				{
+					auto wrapped_obj = NewObject<UMockUObject>();
+					auto default_obj = new SimpleObject{MethodEnum::Default};
+					auto testing_obj = TOptionalPtr<UMockUObject>(wrapped_obj).
+						MapStatic(static_cast<SimpleObject*(*)(MockObject*)>(&MockObject::OverloadedStaticFunction));
+					TestTrue("", testing_obj.IsSet());
+					TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<SimpleObject>>::value);
+				
+					wrapped_obj->Destroy();
+					delete default_obj;
+				});
+				It("should map the overloaded static function 2, set reference bool and return the value", [this]()
+				{
+					auto wrapped_obj = NewObject<UMockUObject>();
+					auto default_obj = new SimpleObject{MethodEnum::Default};
+					bool executed = false;
+					auto testing_obj = TOptionalPtr<UMockUObject>(wrapped_obj).
+						MapStatic(static_cast<SimpleObject*(*)(MockObject*, bool&)>(&MockObject::OverloadedStaticFunction), executed);
+					TestTrue("", testing_obj.IsSet());
+					TestTrue("", executed);
+					TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<SimpleObject>>::value);
+				
+					wrapped_obj->Destroy();
+					delete default_obj;
+				});
+			});
+	
+			Describe("when not valid", [this]()
+			{
+				BeforeEach([this]()
+				{
+					m_wrapped_obj = nullptr;
+				});
+				
+				It("should map a function and return empty optional", [this]()
+					{MapStaticTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::StaticFunction);});
+			});
+		});
+	
+		Describe("when given a wrapped non-UObject pointer", [this]()
+		{
+			Describe("when valid", [this]()
+			{
+				BeforeEach([this]()
+				{
+					m_wrapped_obj = new MockNonUObject();
+				});
+				AfterEach([this]()
+				{
+					m_wrapped_obj->Destroy();
+				});
+				
+				It("should map a static function taking the wrapped object as parameter and return set optional", [this]()
+					{MapStaticTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::StaticFunction);});				
+				It("should map a static function taking the wrapped object as parameter and another copy parameter and return set optional", [this]()
+					{MapStaticTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::StaticFunctionWithParamCopy, SimpleObject{});});				
+				It("should map a static function taking the wrapped object as parameter and another reference parameter and return set optional", [this]()
+					{MapStaticTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::StaticFunctionWithConstParamRef, SimpleObject{});});
+				
+				It("should map the overloaded static function 1 and return the value", [this]()
+				{
+					auto wrapped_obj = new MockNonUObject();
+					auto default_obj = new SimpleObject{MethodEnum::Default};
+					auto testing_obj = TOptionalPtr<MockNonUObject>(wrapped_obj).
+						MapStatic(static_cast<SimpleObject*(*)(MockObject*)>(&MockObject::OverloadedStaticFunction));
+					TestTrue("", testing_obj.IsSet());
+					TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<SimpleObject>>::value);
+				
+					wrapped_obj->Destroy();
+					delete default_obj;
+				});
+				It("should map the overloaded static function 2, set reference bool and return the value", [this]()
+				{
+					auto wrapped_obj = new MockNonUObject();
+					auto default_obj = new SimpleObject{MethodEnum::Default};
+					auto testing_obj = TOptionalPtr<MockNonUObject>(wrapped_obj).
+						MapStatic(static_cast<SimpleObject*(*)(MockObject*)>(&MockObject::OverloadedStaticFunction));
+					TestTrue("", testing_obj.IsSet());
+					TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<SimpleObject>>::value);
+				
+					wrapped_obj->Destroy();
+					delete default_obj;
+				});
+			});
+			
+			Describe("when not valid", [this]()
+			{
+				BeforeEach([this]()
+				{
+					m_wrapped_obj = nullptr;
+				});
+				
+				It("should map a static function and return empty optional", [this]()
+					{MapStaticTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::StaticFunction);});
+			});
+		});
+	});
+	Describe("MapAt", [this]()
+	{
+		Describe("when given a wrapped UObject pointer", [this]()
+		{
+			Describe("when valid", [this]()
+			{
+				BeforeEach([this]()
+				{
+					m_wrapped_obj = NewObject<UMockUObject>();
+				});
+				AfterEach([this]()
+				{
+					m_wrapped_obj->Destroy();
+				});
+
+				It("should map an array field of pointers and return set optional", [this]()
+					{MapAtTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::m_items, 0, true);});
+				It("should map an array field of values and return set optional", [this]()
+					{MapAtTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::m_values, 0, true);});
+				It("should map an array field of values of const object and return set optional", [this]()
+					{MapAtTest<TOptionalPtr<const SimpleObject>, const UMockUObject>(&MockObject::m_values, 0, true);});
+				It("should map a method returning array and return set optional", [this]()
+					{MapAtTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::GetItems, 0, true);});
+				It("should map a null element and return empty optional", [this]()
+					{MapAtTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::m_items, 1, false);});
+				It("should map an index out of bounds and return empty optional", [this]()
+					{MapAtTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::m_items, 2, false);});
+				It("should map a negative index and return empty optional", [this]()
+					{MapAtTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::m_values, -1, false);});
+			});
+
+			Describe("when not valid", [this]()
+			{
+				BeforeEach([this]()
+				{
+					m_wrapped_obj = nullptr;
+				});
+				It("should map an array field and return empty optional", [this]()
+					{MapAtTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::m_items, 0, false);});
+			});
+		});
+
+		Describe("when given a wrapped non-UObject pointer", [this]()
+		{
+			Describe("when valid", [this]()
+			{
+				BeforeEach([this]()
+				{
+					m_wrapped_obj = new MockNonUObject();
+				});
+				AfterEach([this]()
+				{
+					m_wrapped_obj->Destroy();
+				});
+
+				It("should map an array field of pointers and return set optional", [this]()
+					{MapAtTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::m_items, 0, true);});
+				It("should map an array field of values and return set optional", [this]()
+					{MapAtTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::m_values, 0, true);});
+				It("should map an array field of values of const object and return set optional", [this]()
+					{MapAtTest<TOptionalPtr<const SimpleObject>, const MockNonUObject>(&MockObject::m_values, 0, true);});
+				It("should map a method returning array and return set optional", [this]()
+					{MapAtTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::GetItems, 0, true);});
+				It("should map a null element and return empty optional", [this]()
+					{MapAtTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::m_items, 1, false);});
+				It("should map an index out of bounds and return empty optional", [this]()
+					{MapAtTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::m_items, 2, false);});
+				It("should map a negative index and return empty optional", [this]()
+					{MapAtTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::m_values, -1, false);});
+			});
+
+			Describe("when not valid", [this]()
+			{
+				BeforeEach([this]()
+				{
+					m_wrapped_obj = nullptr;
+				});
+				It("should map an array field and return empty optional", [this]()
+					{MapAtTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::m_items, 0, false);});
+			});
+		});
+	});
+	Describe("MapFind", [this]()
+	{
+		Describe("when given a wrapped UObject pointer", [this]()
+		{
+			Describe("when valid", [this]()
+			{
+				BeforeEach([this]()
+				{
+					m_wrapped_obj = NewObject<UMockUObject>();
+				});
+				AfterEach([this]()
+				{
+					m_wrapped_obj->Destroy();
+				});
+
+				It("should find a key in a map field of pointers and return set optional", [this]()
+					{MapFindTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::m_entries, FString(TEXT("Method")), true);});
+				It("should find a key in a map field of values and return set optional", [this]()
+					{MapFindTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::m_value_entries, FString(TEXT("Method")), true);});
+				It("should find a key in a map returned by method and return set optional", [this]()
+					{MapFindTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::GetEntries, FString(TEXT("Method")), true);});
+				It("should find a hashed key and return set optional", [this]()
+					{MapFindTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::m_entries, TOptionalPtrHashedKey<FString>(TEXT("Method")), true);});
+				It("should not find a missing key and return empty optional", [this]()
+					{MapFindTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::m_entries, FString(TEXT("Missing")), false);});
+				It("should not find a missing hashed key and return empty optional", [this]()
+					{MapFindTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::m_value_entries, TOptionalPtrHashedKey<FString>(TEXT("Missing")), false);});
+				It("should find a literal name key and return set optional", [this]()
+					{MapFindNameTest<TOptionalPtr<SimpleObject>, UMockUObject, "Method"_h>(&MockObject::m_named_entries, true);});
+				It("should not find a missing literal name key and return empty optional", [this]()
+					{MapFindNameTest<TOptionalPtr<SimpleObject>, UMockUObject, "NeverInterned"_h>(&MockObject::m_named_entries, false);});
+			});
+
+			Describe("when not valid", [this]()
+			{
+				BeforeEach([this]()
+				{
+					m_wrapped_obj = nullptr;
+				});
+				It("should find a key and return empty optional", [this]()
+					{MapFindTest<TOptionalPtr<SimpleObject>, UMockUObject>(&MockObject::m_entries, FString(TEXT("Method")), false);});
+				It("should find a literal name key and return empty optional", [this]()
+					{MapFindNameTest<TOptionalPtr<SimpleObject>, UMockUObject, "Method"_h>(&MockObject::m_named_entries, false);});
+			});
+		});
+
+		Describe("when given a wrapped non-UObject pointer", [this]()
+		{
+			Describe("when valid", [this]()
+			{
+				BeforeEach([this]()
+				{
+					m_wrapped_obj = new MockNonUObject();
+				});
+				AfterEach([this]()
+				{
+					m_wrapped_obj->Destroy();
+				});
+
+				It("should find a key in a map field of pointers and return set optional", [this]()
+					{MapFindTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::m_entries, FString(TEXT("Method")), true);});
+				It("should find a key in a map field of values and return set optional", [this]()
+					{MapFindTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::m_value_entries, FString(TEXT("Method")), true);});
+				It("should find a key in a map returned by method and return set optional", [this]()
+					{MapFindTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::GetEntries, FString(TEXT("Method")), true);});
+				It("should find a hashed key and return set optional", [this]()
+					{MapFindTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::m_entries, TOptionalPtrHashedKey<FString>(TEXT("Method")), true);});
+				It("should not find a missing key and return empty optional", [this]()
+					{MapFindTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::m_entries, FString(TEXT("Missing")), false);});
+				It("should not find a missing hashed key and return empty optional", [this]()
+					{MapFindTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::m_value_entries, TOptionalPtrHashedKey<FString>(TEXT("Missing")), false);});
+				It("should find a literal name key and return set optional", [this]()
+					{MapFindNameTest<TOptionalPtr<SimpleObject>, MockNonUObject, "Method"_h>(&MockObject::m_named_entries, true);});
+				It("should not find a missing literal name key and return empty optional", [this]()
+					{MapFindNameTest<TOptionalPtr<SimpleObject>, MockNonUObject, "NeverInterned"_h>(&MockObject::m_named_entries, false);});
+			});
+
+			Describe("when not valid", [this]()
+			{
+				BeforeEach([this]()
+				{
+					m_wrapped_obj = nullptr;
+				});
+				It("should find a key and return empty optional", [this]()
+					{MapFindTest<TOptionalPtr<SimpleObject>, MockNonUObject>(&MockObject::m_entries, FString(TEXT("Method")), false);});
+				It("should find a literal name key and return empty optional", [this]()
+					{MapFindNameTest<TOptionalPtr<SimpleObject>, MockNonUObject, "Method"_h>(&MockObject::m_named_entries, false);});
+			});
+		});
+	});
+	Describe("Name", [this]()
+	{
+		It("should hash literals at compile time the same as strings at run-time", [this]()
+		{
+			static_assert("Health"_h == OptionalPtrNameHash("Health", 6), "Literal hash has to be constant expression.");
+			const FString name = TEXT("Health");
+			TestEqual("", OptionalPtrNameHash(*name, name.Len()), "Health"_h);
+			TestTrue("", "Health"_h != "health"_h);
+		});
+		It("should intern the same name to the same id", [this]()
+		{
+			const FOptionalPtrName name(TEXT("InternedName"));
+			TestFalse("", name.IsNone());
+			TestEqual("", FOptionalPtrName(FString(TEXT("InternedName"))), name);
+			TestEqual("", FOptionalPtrName::FromHash<"InternedName"_h>(), name);
+			TestEqual("", name.ToString(), FString(TEXT("InternedName")));
+			TestTrue("", name != FOptionalPtrName(TEXT("OtherInternedName")));
+		});
+		It("should not find name which is not interned", [this]()
+		{
+			TestTrue("", FOptionalPtrName::FromHash<"NeverInterned"_h>().IsNone());
+			TestEqual("", FOptionalPtrNameTable::Get().Find("NeverInterned"_h), INDEX_NONE);
+		});
+		It("should reject different name with the same hash", [this]()
+		{
+			const uint64 hash = "CollidingName"_h;
+			const int32 id = FOptionalPtrNameTable::Get().Intern(TEXT("CollidingName"), hash);
+			TestTrue("", id != INDEX_NONE);
+			TestEqual("", FOptionalPtrNameTable::Get().Intern(TEXT("CollidingName"), hash), id);
+			TestEqual("", FOptionalPtrNameTable::Get().Intern(TEXT("OtherCollidingName"), hash), INDEX_NONE);
+			TestEqual("", FString(FOptionalPtrNameTable::Get().GetName(id)), FString(TEXT("CollidingName")));
+		});
+	});
+	Describe("Walk", [this]()
+	{
+		Describe("when given a wrapped UObject pointer", [this]()
+		{
+			Describe("when valid", [this]()
+			{
+				BeforeEach([this]()
+				{
+					CreateOuterChain();
+				});
+				AfterEach([this]()
+				{
+					for (const auto obj : m_outer_chain)
+					{
+						obj->Destroy();
+					}
+					m_outer_chain.Reset();
+				});
+
+				It("should return the first outer satisfying the predicate", [this]()
+				{
+					const UObject* root = m_outer_chain[0];
+					auto testing_obj = TOptionalPtr<UMockUObject>(m_outer_chain.Last())
+						.Walk(&UObject::GetOuter, [root](const UObject* obj) { return obj == root; });
+					TestTrue("", testing_obj.IsSet());
+					TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<UObject>>::value);
+					TestEqual<UObject*>("", testing_obj.Get(), m_outer_chain[0]);
+				});
+				It("should return the wrapped object if it satisfies the predicate", [this]()
+				{
+					auto testing_obj = TOptionalPtr<UMockUObject>(m_outer_chain.Last())
+						.Walk(&UObject::GetOuter, [](const UObject*) { return true; });
+					TestEqual<UObject*>("", testing_obj.Get(), m_outer_chain.Last());
+				});
+				It("should keep constness of the wrapped object", [this]()
+				{
+					auto testing_obj = TOptionalPtr<const UMockUObject>(m_outer_chain.Last())
+						.Walk(&UObject::GetOuter, [](const UObject*) { return false; });
+					TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<const UObject>>::value);
+				});
+				It("should return empty optional if no outer satisfies the predicate", [this]()
+				{
+					auto testing_obj = TOptionalPtr<UMockUObject>(m_outer_chain.Last())
+						.Walk(&UObject::GetOuter, [](const UObject*) { return false; });
+					TestFalse("", testing_obj.IsSet());
+				});
+				It("should return empty optional if max depth is reached", [this]()
+				{
+					const UObject* root = m_outer_chain[0];
+					auto testing_obj = TOptionalPtr<UMockUObject>(m_outer_chain.Last())
+						.Walk(&UObject::GetOuter, [root](const UObject* obj) { return obj == root; }, 2);
+					TestFalse("", testing_obj.IsSet());
+				});
+				It("should stop at an outer which is not valid", [this]()
+				{
+					const UObject* root = m_outer_chain[0];
+					m_outer_chain[1]->MarkPendingKill();
+					auto testing_obj = TOptionalPtr<UMockUObject>(m_outer_chain.Last())
+						.Walk(&UObject::GetOuter, [root](const UObject* obj) { return obj == root; });
+					TestFalse("", testing_obj.IsSet());
+				});
+				It("should find the closest outer of the given type", [this]()
+				{
+					auto testing_obj = TOptionalPtr<UMockUObject>(m_outer_chain.Last()).FindAncestor<UMockAncestorUObject>();
+					TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<UMockAncestorUObject>>::value);
+					TestEqual<UMockUObject*>("", testing_obj.Get(), m_outer_chain[1]);
+				});
+				It("should not consider the wrapped object its own ancestor", [this]()
+				{
+					auto testing_obj = TOptionalPtr<UMockUObject>(m_outer_chain[1]).FindAncestor<UMockAncestorUObject>();
+					TestFalse("", testing_obj.IsSet());
+				});
+				It("should not find the outer of the given type beyond max depth", [this]()
+				{
+					auto testing_obj = TOptionalPtr<UMockUObject>(m_outer_chain.Last()).FindAncestor<UMockAncestorUObject>(1);
+					TestFalse("", testing_obj.IsSet());
+				});
+			});
+
+			Describe("when not valid", [this]()
+			{
+				It("should return empty optional", [this]()
+				{
+					auto testing_obj = TOptionalPtr<UMockUObject>(nullptr).Walk(&UObject::GetOuter, [](const UObject*) { return true; });
+					TestFalse("", testing_obj.IsSet());
+				});
+				It("should not find any ancestor", [this]()
+				{
+					TestFalse("", TOptionalPtr<UMockUObject>(nullptr).FindAncestor<UMockAncestorUObject>().IsSet());
+				});
+			});
+		});
+
+		Describe("when given a wrapped non-UObject pointer", [this]()
+		{
+			Describe("when valid", [this]()
+			{
+				BeforeEach([this]()
+				{
+					CreateLinkChain();
+				});
+				AfterEach([this]()
+				{
+					for (const auto node : m_link_chain)
+					{
+						delete node;
+					}
+					m_link_chain.Reset();
+				});
+
+				It("should follow a method link and return the first node satisfying the predicate", [this]()
+				{
+					auto testing_obj = TOptionalPtr<MockLinkNode>(m_link_chain.Last())
+						.Walk(&MockLinkNode::GetNext, [](const MockLinkNode* node) { return node->HasValue(2); });
+					TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<MockLinkNode>>::value);
+					TestEqual("", testing_obj.Get(), m_link_chain[1]);
+				});
+				It("should follow a field link and return the first node satisfying the predicate", [this]()
+				{
+					auto testing_obj = TOptionalPtr<MockLinkNode>(m_link_chain.Last())
+						.Walk(&MockLinkNode::m_next, [](const MockLinkNode* node) { return node->HasValue(3); });
+					TestEqual("", testing_obj.Get(), m_link_chain[0]);
+				});
+				It("should return empty optional if the chain ends before the predicate is satisfied", [this]()
+				{
+					auto testing_obj = TOptionalPtr<MockLinkNode>(m_link_chain.Last())
+						.Walk(&MockLinkNode::m_next, [](const MockLinkNode* node) { return node->HasValue(4); });
+					TestFalse("", testing_obj.IsSet());
+				});
+				It("should return empty optional if max depth is reached", [this]()
+				{
+					auto testing_obj = TOptionalPtr<MockLinkNode>(m_link_chain.Last())
+						.Walk(&MockLinkNode::m_next, [](const MockLinkNode* node) { return node->HasValue(3); }, 2);
+					TestFalse("", testing_obj.IsSet());
+				});
+				It("should not follow the link from the found node or past max depth", [this]()
+				{
+					TOptionalPtr<MockLinkNode>(m_link_chain.Last())
+						.Walk(&MockLinkNode::GetCountingNext, [](const MockLinkNode* node) { return node->HasValue(2); });
+					TestEqual("", m_link_chain[1]->m_num_next_calls, 0);
+					TestEqual("", m_link_chain[2]->m_num_next_calls, 1);
+
+					TOptionalPtr<MockLinkNode>(m_link_chain.Last())
+						.Walk(&MockLinkNode::GetCountingNext, [](const MockLinkNode*) { return false; }, 1);
+					TestEqual("", m_link_chain[2]->m_num_next_calls, 1);
+					TestEqual("", m_link_chain[3]->m_num_next_calls, 2);
+				});
+				It("should validate the hops by the policy of the chain", [this]()
+				{
+					m_link_chain[1]->m_value = -1;
+					auto testing_obj = TOptionalPtr<MockLinkNode, FMockNonNegativePolicy>(m_link_chain.Last())
+						.Walk(&MockLinkNode::m_next, [](const MockLinkNode* node) { return node->HasValue(3); });
+					TestFalse("", testing_obj.IsSet());
+					TestFalse("", TOptionalPtr<MockLinkNode, FMockNonNegativePolicy>(m_link_chain.Last())
+						.FindAncestor<MockAncestorLinkNode>(&MockLinkNode::m_next).IsSet());
+				});
+				It("should find the closest ancestor of the given type", [this]()
+				{
+					auto testing_obj = TOptionalPtr<MockLinkNode>(m_link_chain.Last()).FindAncestor<MockAncestorLinkNode>(&MockLinkNode::GetNext);
+					TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<MockAncestorLinkNode>>::value);
+					TestEqual<MockLinkNode*>("", testing_obj.Get(), m_link_chain[1]);
+				});
+				It("should not consider the wrapped object its own ancestor", [this]()
+				{
+					auto testing_obj = TOptionalPtr<MockLinkNode>(m_link_chain[1]).FindAncestor<MockAncestorLinkNode>(&MockLinkNode::m_next);
+					TestFalse("", testing_obj.IsSet());
+				});
+			});
+
+			Describe("when not valid", [this]()
+			{
+				It("should return empty optional", [this]()
+				{
+					auto testing_obj = TOptionalPtr<MockLinkNode>(nullptr).Walk(&MockLinkNode::m_next, [](const MockLinkNode*) { return true; });
+					TestFalse("", testing_obj.IsSet());
+				});
+			});
+		});
+	});
+	Describe("AncestorCache", [this]()
+	{
+		Describe("when given a UObject", [this]()
+		{
+			BeforeEach([this]()
+			{
+				CreateOuterChain();
+			});
+			AfterEach([this]()
+			{
+				for (const auto obj : m_outer_chain)
+				{
+					obj->Destroy();
+				}
+				m_outer_chain.Reset();
+			});
+
+			It("should find the closest outer of the given type", [this]()
+			{
+				TOptionalPtrAncestorCache<UObject> cache;
+				auto testing_obj = cache.FindAncestor<UMockAncestorUObject>(m_outer_chain.Last());
+				TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<UMockAncestorUObject>>::value);
+				TestEqual<UObject*>("", testing_obj.Get(), m_outer_chain[1]);
+			});
+			It("should cache the result for all the objects on the path", [this]()
+			{
+				TOptionalPtrAncestorCache<UObject> cache;
+				cache.FindAncestor<UMockAncestorUObject>(m_outer_chain.Last());
+				TestEqual("", cache.Num(), 2);
+				TestEqual<UObject*>("", cache.FindAncestor<UMockAncestorUObject>(m_outer_chain[2]).Get(), m_outer_chain[1]);
+				TestEqual("", cache.Num(), 2);
+			});
+			It("should cache missing ancestor", [this]()
+			{
+				TOptionalPtrAncestorCache<UObject> cache;
+				TestFalse("", cache.FindAncestor<UMockAncestorUObject>(m_outer_chain[1]).IsSet());
+				TestEqual("", cache.Num(), 2);
+				TestFalse("", cache.FindAncestor<UMockAncestorUObject>(m_outer_chain[1]).IsSet());
+			});
+		});
+
+		Describe("when given a non-UObject", [this]()
+		{
+			BeforeEach([this]()
+			{
+				CreateLinkChain();
+			});
+			AfterEach([this]()
+			{
+				for (const auto node : m_link_chain)
+				{
+					delete node;
+				}
+				m_link_chain.Reset();
+			});
+
+			It("should find the closest ancestor of the given type", [this]()
+			{
+				TOptionalPtrAncestorCache<MockLinkNode> cache;
+				auto testing_obj = cache.FindAncestor<MockAncestorLinkNode>(m_link_chain.Last(), &MockLinkNode::m_next);
+				TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<MockAncestorLinkNode>>::value);
+				TestEqual<MockLinkNode*>("", testing_obj.Get(), m_link_chain[1]);
+			});
+			It("should keep the cached result until invalidated", [this]()
+			{
+				TOptionalPtrAncestorCache<MockLinkNode> cache;
+				cache.FindAncestor<MockAncestorLinkNode>(m_link_chain.Last(), &MockLinkNode::GetNext);
+				m_link_chain[2]->m_next = nullptr;
+				TestEqual<MockLinkNode*>("", cache.FindAncestor<MockAncestorLinkNode>(m_link_chain.Last(), &MockLinkNode::GetNext).Get(), m_link_chain[1]);
+
+				cache.Invalidate();
+				TestFalse("", cache.FindAncestor<MockAncestorLinkNode>(m_link_chain.Last(), &MockLinkNode::GetNext).IsSet());
+			});
+			It("should invalidate only the entries resolved through the invalidated object", [this]()
+			{
+				TOptionalPtrAncestorCache<MockLinkNode> cache;
+				MockLinkNode other(4);
+				other.m_next = m_link_chain[2];
+				cache.FindAncestor<MockAncestorLinkNode>(m_link_chain.Last(), &MockLinkNode::m_next);
+				cache.FindAncestor<MockAncestorLinkNode>(&other, &MockLinkNode::m_next);
+				m_link_chain[3]->m_next = nullptr;
+				other.m_next = nullptr;
+
+				cache.Invalidate(m_link_chain[3]);
+				TestFalse("", cache.FindAncestor<MockAncestorLinkNode>(m_link_chain.Last(), &MockLinkNode::m_next).IsSet());
+				TestEqual<MockLinkNode*>("", cache.FindAncestor<MockAncestorLinkNode>(&other, &MockLinkNode::m_next).Get(), m_link_chain[1]);
+
+				m_link_chain[2]->m_next = &other;
+				cache.Invalidate(m_link_chain[2]);
+				TestFalse("", cache.FindAncestor<MockAncestorLinkNode>(&other, &MockLinkNode::m_next).IsSet());
+			});
+			It("should invalidate all the entries once too many objects are invalidated", [this]()
+			{
+				using FCache = TOptionalPtrAncestorCache<MockLinkNode>;
+				FCache cache(2 * FCache::BytesPerEntry + FCache::BytesPerInvalidation);
+				TestEqual("", cache.GetInvalidatedCapacity(), 1);
+				MockLinkNode unrelated[2];
+				cache.FindAncestor<MockAncestorLinkNode>(m_link_chain.Last(), &MockLinkNode::m_next);
+				m_link_chain[2]->m_next = nullptr;
+
+				cache.Invalidate(&unrelated[0]);
+				cache.Invalidate(&unrelated[0]);
+				TestEqual<MockLinkNode*>("", cache.FindAncestor<MockAncestorLinkNode>(m_link_chain.Last(), &MockLinkNode::m_next).Get(), m_link_chain[1]);
+
+				cache.Invalidate(&unrelated[1]);
+				TestFalse("", cache.FindAncestor<MockAncestorLinkNode>(m_link_chain.Last(), &MockLinkNode::m_next).IsSet());
+			});
+			It("should evict entries exceeding the memory budget", [this]()
+			{
+				using FCache = TOptionalPtrAncestorCache<MockLinkNode>;
+				FCache cache(2 * FCache::BytesPerEntry + FCache::BytesPerInvalidation);
+				TestEqual("", cache.GetCapacity(), 2);
+				for (const auto node : m_link_chain)
+				{
+					cache.FindAncestor<MockAncestorLinkNode>(node, &MockLinkNode::m_next);
+				}
+				TestEqual("", cache.Num(), 2);
+				TestEqual<MockLinkNode*>("", cache.FindAncestor<MockAncestorLinkNode>(m_link_chain.Last(), &MockLinkNode::m_next).Get(), m_link_chain[1]);
+			});
+			It("should not cache lookup cut by max depth", [this]()
+			{
+				TOptionalPtrAncestorCache<MockLinkNode> cache;
+				TestFalse("", cache.FindAncestor<MockAncestorLinkNode>(m_link_chain.Last(), &MockLinkNode::m_next, 1).IsSet());
+				TestEqual("", cache.Num(), 0);
+				TestTrue("", cache.FindAncestor<MockAncestorLinkNode>(m_link_chain.Last(), &MockLinkNode::m_next).IsSet());
+			});
+		});
+
+		Describe("when given nullptr", [this]()
+		{
+			It("should return empty optional", [this]()
+			{
+				TOptionalPtrAncestorCache<MockLinkNode> cache;
+				TestFalse("", cache.FindAncestor<MockAncestorLinkNode>(nullptr, &MockLinkNode::m_next).IsSet());
+			});
+		});
+	});
+	Describe("Chain", [this]()
+	{
+		Describe("when given a UObject", [this]()
+		{
+			BeforeEach([this]()
+			{
+				CreateOuterChain();
+			});
+			AfterEach([this]()
+			{
+				for (const auto obj : m_outer_chain)
+				{
+					obj->Destroy();
+				}
+				m_outer_chain.Reset();
+			});
+
+			It("should follow getters and casts", [this]()
+			{
+				const auto chain = TOptionalPtrChainBuilder<UMockUObject>()
+					.Map(&UObject::GetOuter)
+					.Cast<UMockAncestorUObject>()
+					.Build();
+				auto testing_obj = chain.Execute(m_outer_chain[2]);
+				TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<UMockAncestorUObject>>::value);
+				TestEqual<UObject*>("", testing_obj.Get(), m_outer_chain[1]);
+				TestFalse("", chain.Execute(m_outer_chain[3]).IsSet());
+			});
+			It("should build multiple chains from one builder", [this]()
+			{
+				const auto builder = TOptionalPtrChainBuilder<UMockUObject>()
+					.Map(&UObject::GetOuter);
+				const auto outer_chain = builder.Build();
+				const auto outer_of_outer_chain = builder
+					.Map(&UObject::GetOuter)
+					.Build();
+				TestEqual<UObject*>("", outer_chain.Execute(m_outer_chain[3]).Get(), m_outer_chain[2]);
+				TestEqual<UObject*>("", outer_of_outer_chain.Execute(m_outer_chain[3]).Get(), m_outer_chain[1]);
+				TestFalse("", outer_chain.Execute(nullptr).IsSet());
+				TestFalse("", outer_of_outer_chain.Execute(nullptr).IsSet());
+			});
+			It("should load fields of any base", [this]()
+			{
+				const auto chain = TOptionalPtrChainBuilder<UMockUObject>()
+					.Map(&MockObject::m_field)
+					.Build();
+				TestEqual("", chain.Execute(m_outer_chain[0]).Get(), m_outer_chain[0]->m_field);
+			});
+			It("should return empty optional if any object on the way is not valid", [this]()
+			{
+				const auto chain = TOptionalPtrChainBuilder<UMockUObject>()
+					.Map(&UObject::GetOuter)
+					.Map(&UObject::GetOuter)
+					.Build();
+				TestEqual<UObject*>("", chain.Execute(m_outer_chain[3]).Get(), m_outer_chain[1]);
+				m_outer_chain[1]->MarkPendingKill();
+				TestFalse("", chain.Execute(m_outer_chain[1]).IsSet());
+				TestFalse("", chain.Execute(m_outer_chain[2]).IsSet());
+				TestFalse("", chain.Execute(m_outer_chain[3]).IsSet());
+			});
+		});
+
+		Describe("when given a non-UObject", [this]()
+		{
+			BeforeEach([this]()
+			{
+				CreateLinkChain();
+			});
+			AfterEach([this]()
+			{
+				for (const auto node : m_link_chain)
+				{
+					delete node;
+				}
+				m_link_chain.Reset();
+			});
+
+			It("should follow fields and getters", [this]()
+			{
+				const auto chain = TOptionalPtrChainBuilder<MockLinkNode>()
+					.Map(&MockLinkNode::m_next)
+					.Map(&MockLinkNode::GetNext)
+					.Build();
+				TestEqual("", chain.Execute(m_link_chain[3]).Get(), m_link_chain[1]);
+				TestFalse("", chain.Execute(m_link_chain[1]).IsSet());
+				TestFalse("", chain.Execute(nullptr).IsSet());
+			});
+			It("should return default value if any object on the way is null", [this]()
+			{
+				const auto chain = TOptionalPtrChainBuilder<MockLinkNode>()
+					.Map(&MockLinkNode::m_next)
+					.Map(&MockLinkNode::GetNext)
+					.Build(m_link_chain[0]);
+				TestEqual("", chain.Execute(m_link_chain[3]).Get(), m_link_chain[1]);
+				TestEqual("", chain.Execute(m_link_chain[0]).Get(), m_link_chain[0]);
+				TestEqual("", chain.Execute(nullptr).Get(), m_link_chain[0]);
+			});
+			It("should access elements of arrays", [this]()
+			{
+				MockNonUObject* obj = new MockNonUObject();
+				TestEqual("", TOptionalPtrChainBuilder<MockNonUObject>().MapAt(&MockObject::m_items, 0).Build().Execute(obj).Get(), obj->m_items[0]);
+				TestFalse("", TOptionalPtrChainBuilder<MockNonUObject>().MapAt(&MockObject::m_items, 1).Build().Execute(obj).IsSet());
+				TestFalse("", TOptionalPtrChainBuilder<MockNonUObject>().MapAt(&MockObject::GetItems, 2).Build().Execute(obj).IsSet());
+				TestEqual("", TOptionalPtrChainBuilder<MockNonUObject>().MapAt(&MockObject::m_values, 0).Build().Execute(obj).Get(), &obj->m_values[0]);
+				obj->Destroy();
+			});
+			It("should cast", [this]()
+			{
+				const auto chain = TOptionalPtrChainBuilder<MockLinkNode>()
+					.Map(&MockLinkNode::m_next)
+					.Cast<MockAncestorLinkNode>()
+					.Build();
+				TestEqual<MockLinkNode*>("", chain.Execute(m_link_chain[2]).Get(), m_link_chain[1]);
+				TestFalse("", chain.Execute(m_link_chain[3]).IsSet());
+			});
+		});
+	});
+	Describe("PathResolver", [this]()
+	{
+		Describe("when given a valid root", [this]()
+		{
+			BeforeEach([this]()
+			{
+				CreateReflectedWorld();
+			});
+			AfterEach([this]()
+			{
+				DestroyReflectedWorld();
+			});
+
+			It("should resolve value through fields and getters", [this]()
+			{
+				TOptionalPtrPathResolver<FOptionalPtrMockReflection> resolver;
+				m_world->m_first_player_controller->m_pawn->m_health_component->m_health = 42.f;
+				TestEqual("", resolver.ResolveValue(m_world, TEXT("FirstPlayerController.Pawn.HealthComponent.Health"), -1.f), 42.f);
+				TestEqual("", resolver.ResolveValue(m_world, TEXT("NumPlayers"), 0), 1);
+			});
+			It("should resolve object", [this]()
+			{
+				TOptionalPtrPathResolver<FOptionalPtrMockReflection> resolver;
+				auto testing_obj = resolver.ResolveObject<MockPawn>(m_world, TEXT("FirstPlayerController.Pawn"));
+				TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<MockPawn>>::value);
+				TestEqual("", testing_obj.Get(), m_world->m_first_player_controller->m_pawn);
+			});
+			It("should return default value if any object on the path is null", [this]()
+			{
+				TOptionalPtrPathResolver<FOptionalPtrMockReflection> resolver;
+				delete m_world->m_first_player_controller->m_pawn->m_health_component;
+				m_world->m_first_player_controller->m_pawn->m_health_component = nullptr;
+				TestEqual("", resolver.ResolveValue(m_world, TEXT("FirstPlayerController.Pawn.HealthComponent.Health"), -1.f), -1.f);
+			});
+			It("should return default value if the path doesn't compile", [this]()
+			{
+				TOptionalPtrPathResolver<FOptionalPtrMockReflection> resolver;
+				TestEqual("", resolver.ResolveValue(m_world, TEXT("FirstPlayerController.Character.Health"), -1.f), -1.f);
+				TestEqual("", resolver.ResolveValue(m_world, TEXT("NumPlayers.Health"), -1.f), -1.f);
+				TestFalse("", resolver.ResolveObject<MockPawn>(m_world, TEXT("NumPlayers")).IsSet());
+				TestEqual("", resolver.Num(), 4);
+			});
+			It("should return default value if the value is of different type", [this]()
+			{
+				TOptionalPtrPathResolver<FOptionalPtrMockReflection> resolver;
+				TestEqual("", resolver.ResolveValue(m_world, TEXT("FirstPlayerController.Pawn.HealthComponent.Health"), -1.0), -1.0);
+				TestEqual("", resolver.ResolveValue(m_world, TEXT("FirstPlayerController.Pawn.HealthComponent.Health"), -1), -1);
+				TestEqual("", resolver.ResolveValue(m_world, TEXT("NumPlayers"), -1.f), -1.f);
+			});
+			It("should resolve members of the type the object has at run-time", [this]()
+			{
+				TOptionalPtrPathResolver<FOptionalPtrMockReflection> resolver;
+				MockPawn* pawn = m_world->m_first_player_controller->m_pawn;
+				MockArmoredPawn armored_pawn;
+				armored_pawn.m_health_component = pawn->m_health_component;
+				TestEqual("", resolver.ResolveValue(m_world, TEXT("FirstPlayerController.Pawn.Armor"), -1), -1);
+
+				m_world->m_first_player_controller->m_pawn = &armored_pawn;
+				TestEqual("", resolver.ResolveValue(m_world, TEXT("FirstPlayerController.Pawn.Armor"), -1), 50);
+				TestEqual("", resolver.ResolveValue(m_world, TEXT("FirstPlayerController.Pawn.HealthComponent.Health"), -1.f), 100.f);
+				TestEqual("", resolver.ResolveValue(m_world, TEXT("FirstPlayerController.Pawn.Armor.Health"), -1.f), -1.f);
+				m_world->m_first_player_controller->m_pawn = pawn;
+			});
+			It("should return empty optional if the object is of different type", [this]()
+			{
+				TOptionalPtrPathResolver<FOptionalPtrMockReflection> resolver;
+				TestFalse("", resolver.ResolveObject<MockPlayerController>(m_world, TEXT("FirstPlayerController.Pawn")).IsSet());
+			});
+			It("should compile the path only once", [this]()
+			{
+				TOptionalPtrPathResolver<FOptionalPtrMockReflection> resolver;
+				const FOptionalPtrPath* plan = resolver.FindOrCompile(m_world, TEXT("FirstPlayerController.Pawn.HealthComponent.Health"));
+				TestNotNull("", plan);
+				TestEqual("", plan->Steps.Num(), 4);
+				TestEqual("", resolver.FindOrCompile(m_world, TEXT("FirstPlayerController.Pawn.HealthComponent.Health")), plan);
+				TestEqual("", resolver.Num(), 1);
+				TestEqual("", resolver.EvaluateValue(*plan, m_world, -1.f), 100.f);
+			});
+			It("should not evaluate the plan against root of different type", [this]()
+			{
+				TOptionalPtrPathResolver<FOptionalPtrMockReflection> resolver;
+				const FOptionalPtrPath* plan = resolver.FindOrCompile(m_world, TEXT("FirstPlayerController.Pawn"));
+				TestFalse("", resolver.EvaluateObject<MockPawn>(*plan, m_world->m_first_player_controller).IsSet());
+			});
+		});
+
+		Describe("when given nullptr", [this]()
+		{
+			It("should return default value", [this]()
+			{
+				TOptionalPtrPathResolver<FOptionalPtrMockReflection> resolver;
+				TestEqual("", resolver.ResolveValue<int32>(nullptr, TEXT("NumPlayers"), 0), 0);
+				TestFalse("", resolver.ResolveObject<MockPawn>(nullptr, TEXT("FirstPlayerController.Pawn")).IsSet());
+				TestEqual("", resolver.Num(), 0);
+			});
+		});
+
+		Describe("when given a UObject", [this]()
+		{
+			BeforeEach([this]()
+			{
+				CreateReflectedPlayerController();
+			});
+
+			It("should resolve properties of the subclass the object has at run-time", [this]()
+			{
+				TOptionalPtrPathResolver<> resolver;
+				Cast<UMockCharacter>(m_player_controller->Pawn)->HealthComponent->Health = 42.f;
+				TestEqual("", resolver.ResolveValue(m_player_controller, TEXT("Pawn.HealthComponent.Health"), -1.f), 42.f);
+				TestEqual("", resolver.ResolveValue(m_player_controller, TEXT("Pawn.Armor"), -1), 50);
+				TestEqual<UObject*>("", resolver.ResolveObject<UMockHealthComponent>(m_player_controller, TEXT("Pawn.HealthComponent")).Get(),
+					Cast<UMockCharacter>(m_player_controller->Pawn)->HealthComponent);
+			});
+			It("should resolve getters with and without the Get prefix", [this]()
+			{
+				TOptionalPtrPathResolver<> resolver;
+				TestEqual<UObject*>("", resolver.ResolveObject<UMockPawn>(m_player_controller, TEXT("ControlledPawn")).Get(), m_player_controller->Pawn);
+				TestEqual("", resolver.ResolveValue(m_player_controller, TEXT("GetControlledPawn.HealthComponent.Health"), -1.f), 100.f);
+			});
+			It("should return default value if the property is of different type", [this]()
+			{
+				TOptionalPtrPathResolver<> resolver;
+				TestEqual("", resolver.ResolveValue(m_player_controller, TEXT("Pawn.HealthComponent.Health"), -1), -1);
+				TestEqual("", resolver.ResolveValue(m_player_controller, TEXT("Pawn.Armor"), -1.f), -1.f);
+				TestEqual("", resolver.ResolveValue(m_player_controller, TEXT("Pawn.HealthComponent.Health"), -1.0), -1.0);
+			});
+			It("should return default value if any object on the path is pending kill", [this]()
+			{
+				TOptionalPtrPathResolver<> resolver;
+				Cast<UMockCharacter>(m_player_controller->Pawn)->HealthComponent->MarkPendingKill();
+				TestEqual("", resolver.ResolveValue(m_player_controller, TEXT("Pawn.HealthComponent.Health"), -1.f), -1.f);
+				TestFalse("", resolver.ResolveObject<UMockHealthComponent>(m_player_controller, TEXT("ControlledPawn.HealthComponent")).IsSet());
+			});
+		});
+	});
+	Describe("WeakPtr", [this]()
+	{
+		Describe("when given a UObject", [this]()
+		{
+			BeforeEach([this]()
+			{
+				CreateOuterChain();
+				for (int32 i = 1; i < m_outer_chain.Num(); ++i)
+				{
+					m_outer_chain[i]->m_weak_link = m_outer_chain[i - 1];
+				}
+			});
+			AfterEach([this]()
+			{
+				for (const auto obj : m_outer_chain)
+				{
+					obj->Destroy();
+				}
+				m_outer_chain.Reset();
+			});
+
+			It("should resolve weak fields and getters", [this]()
+			{
+				auto testing_obj = TOptionalPtr<UMockUObject>(m_outer_chain[3])
+					.Map(&UMockUObject::m_weak_link)
+					.Map(&UMockUObject::GetWeakLink);
+				TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<UMockUObject, TOptionalPtrResolvedPolicy<>>>::value);
+				TestEqual("", testing_obj.Get(), m_outer_chain[1]);
+			});
+			It("should return empty optional if weak pointer is stale", [this]()
+			{
+				m_outer_chain[1]->MarkPendingKill();
+				TestFalse("", TOptionalPtr<UMockUObject>(m_outer_chain[2]).Map(&UMockUObject::m_weak_link).IsSet());
+				TestFalse("", TOptionalPtr<UMockUObject>(m_outer_chain[3]).Map(&UMockUObject::m_weak_link).Map(&UMockUObject::m_weak_link).IsSet());
+			});
+			It("should be constructed from weak pointer", [this]()
+			{
+				TestEqual("", TOptionalPtr<UMockUObject>(m_outer_chain[3]->m_weak_link).Get(), m_outer_chain[2]);
+				auto testing_obj = MakeOptionalPtr(m_outer_chain[3]->m_weak_link);
+				TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<UMockUObject, TOptionalPtrResolvedPolicy<>>>::value);
+				TestEqual("", testing_obj.Get(), m_outer_chain[2]);
+				TestFalse("", MakeOptionalPtr(TWeakObjectPtr<UMockUObject>()).IsSet());
+			});
+			It("should validate objects not resolved from weak pointers", [this]()
+			{
+				auto testing_obj = MakeOptionalPtr(m_outer_chain[3]->m_weak_link).Map(&UObject::GetOuter);
+				TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<UObject>>::value);
+				TestEqual<UObject*>("", testing_obj.Get(), m_outer_chain[1]);
+				m_outer_chain[1]->MarkPendingKill();
+				TestFalse("", MakeOptionalPtr(m_outer_chain[3]->m_weak_link).Map(&UObject::GetOuter).IsSet());
+			});
+		});
+
+		Describe("when given a non-UObject", [this]()
+		{
+			It("should resolve std::weak_ptr fields", [this]()
+			{
+				TArray<std::shared_ptr<MockLinkNode>> nodes;
+				for (int32 i = 0; i < 3; ++i)
+				{
+					nodes.Add(std::make_shared<MockLinkNode>(i));
+					if (i > 0)
+					{
+						nodes[i]->m_weak_next = nodes[i - 1];
+					}
+				}
+				TestEqual("", TOptionalPtr<MockLinkNode>(nodes[2].get()).Map(&MockLinkNode::m_weak_next).Map(&MockLinkNode::m_weak_next).Get(), nodes[0].get());
+				TestEqual("", MakeOptionalPtr(nodes[2]->m_weak_next).Get(), nodes[1].get());
+
+				nodes[0].reset();
+				TestFalse("", TOptionalPtr<MockLinkNode>(nodes[2].get()).Map(&MockLinkNode::m_weak_next).Map(&MockLinkNode::m_weak_next).IsSet());
+			});
+			It("should resolve each weak pointer only once", [this]()
+			{
+				MockLinkNode nodes[3];
+				nodes[2].m_counted_next.m_obj = &nodes[1];
+				nodes[1].m_counted_next.m_obj = &nodes[0];
+				MockWeakPtr<MockLinkNode>::NumResolves = 0;
+
+				auto testing_obj = TOptionalPtr<MockLinkNode>(&nodes[2])
+					.Map(&MockLinkNode::m_counted_next)
+					.Map(&MockLinkNode::GetCountedNext);
+				TestTrue("", testing_obj.IsSet());
+				TestEqual("", testing_obj.Get(), &nodes[0]);
+				TestEqual("", MockWeakPtr<MockLinkNode>::NumResolves, 2);
+
+				MockWeakPtr<MockLinkNode>::NumResolves = 0;
+				TestFalse("", TOptionalPtr<MockLinkNode>(&nodes[1])
+					.Map(&MockLinkNode::m_counted_next)
+					.Map(&MockLinkNode::m_counted_next)
+					.Map(&MockLinkNode::m_counted_next)
+					.IsSet());
+				TestEqual("", MockWeakPtr<MockLinkNode>::NumResolves, 2);
+			});
+		});
+	});
+	Describe("ObjectPtr", [this]()
+	{
+		BeforeEach([this]()
+		{
+			CreateOuterChain();
+			for (int32 i = 1; i < m_outer_chain.Num(); ++i)
+			{
+				m_outer_chain[i]->m_handle_link.m_obj = m_outer_chain[i - 1];
+#if ENGINE_MAJOR_VERSION >= 5
+				m_outer_chain[i]->m_object_link = m_outer_chain[i - 1];
+#endif
+			}
+			MockObjectPtr<UMockUObject>::NumResolves = 0;
+		});
+		AfterEach([this]()
+		{
+			for (const auto obj : m_outer_chain)
+			{
+				obj->Destroy();
+			}
+			m_outer_chain.Reset();
+		});
+
+		It("should resolve each handle only once", [this]()
+		{
+			auto testing_obj = TOptionalPtr<UMockUObject>(m_outer_chain[3])
+				.Map(&UMockUObject::m_handle_link)
+				.Map(&UMockUObject::GetHandleLink);
+			TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<UMockUObject>>::value);
+			TestTrue("", testing_obj.IsSet());
+			TestEqual("", testing_obj.Get(), m_outer_chain[1]);
+			TestEqual("", MockObjectPtr<UMockUObject>::NumResolves, 2);
+		});
+		It("should validate resolved objects", [this]()
+		{
+			m_outer_chain[2]->MarkPendingKill();
+			TestFalse("", TOptionalPtr<UMockUObject>(m_outer_chain[3])
+				.Map(&UMockUObject::m_handle_link)
+				.Map(&UMockUObject::m_handle_link)
+				.IsSet());
+			TestEqual("", MockObjectPtr<UMockUObject>::NumResolves, 1);
+		});
+		It("should resolve each handle only once per chain execution", [this]()
+		{
+			const auto chain = TOptionalPtrChainBuilder<UMockUObject>()
+				.Map(&UMockUObject::m_handle_link)
+				.Map(&UMockUObject::GetHandleLink)
+				.Build();
+			TestEqual("", chain.Execute(m_outer_chain[3]).Get(), m_outer_chain[1]);
+			TestEqual("", MockObjectPtr<UMockUObject>::NumResolves, 2);
+			TestFalse("", chain.Execute(m_outer_chain[1]).IsSet());
+			TestEqual("", MockObjectPtr<UMockUObject>::NumResolves, 4);
+		});
+#if ENGINE_MAJOR_VERSION >= 5
+		It("should follow TObjectPtr fields", [this]()
+		{
+			TestEqual("", TOptionalPtr<UMockUObject>(m_outer_chain[3])
+				.Map(&UMockUObject::m_object_link)
+				.Map(&UMockUObject::m_object_link)
+				.Get(), m_outer_chain[1]);
+			TestEqual("", TOptionalPtrChainBuilder<UMockUObject>()
+				.Map(&UMockUObject::m_object_link)
+				.Build()
+				.Execute(m_outer_chain[1]).Get(), m_outer_chain[0]);
+		});
+#endif
+	});
+	Describe("SharedPtr", [this]()
+	{
+		It("should borrow shared and unique pointer fields and getters", [this]()
+		{
+			MockLinkNode root;
+			root.m_shared_next = MakeShared<MockLinkNode, ESPMode::ThreadSafe>(1);
+			root.m_shared_next->m_std_shared_next = std::make_shared<MockLinkNode>(2);
+			root.m_shared_next->m_std_shared_next->m_unique_next = MakeUnique<MockLinkNode>(3);
+
+			auto testing_obj = TOptionalPtr<MockLinkNode>(&root)
+				.Map(&MockLinkNode::GetSharedNext)
+				.Map(&MockLinkNode::m_std_shared_next)
+				.Map(&MockLinkNode::m_unique_next);
+			TestTrue("", std::is_same<decltype(testing_obj), TOptionalPtr<MockLinkNode>>::value);
+			TestEqual("", testing_obj.Get(), root.m_shared_next->m_std_shared_next->m_unique_next.Get());
+			TestEqual("", root.m_shared_next.GetSharedReferenceCount(), 1);
+			TestTrue("", root.m_shared_next->m_std_shared_next.use_count() == 1);
+			TestFalse("", TOptionalPtr<MockLinkNode>(&root).Map(&MockLinkNode::m_unique_next).Map(&MockLinkNode::m_shared_next).IsSet());
+
+			const TSharedRef<MockLinkNode> ref = MakeShared<MockLinkNode>(4);
+			TestEqual("", TOptionalPtrResolver<TSharedRef<MockLinkNode>>::Resolve(ref), &ref.Get());
+		});
+		It("should not change reference counts", [this]()
+		{
+			MockLinkNode nodes[3];
+			nodes[2].m_counted_shared_next.m_obj = &nodes[1];
+			nodes[1].m_counted_shared_next.m_obj = &nodes[0];
+			MockSharedPtr<MockLinkNode>::NumRefCountChanges = 0;
+
+			TestEqual("", TOptionalPtr<MockLinkNode>(&nodes[2])
+				.Map(&MockLinkNode::m_counted_shared_next)
+				.Map(&MockLinkNode::GetCountedSharedNext)
+				.Get(), &nodes[0]);
+			TestEqual("", MockSharedPtr<MockLinkNode>::NumRefCountChanges, 0);
+
+			nodes[1].m_counted_shared_next.m_obj = nullptr;
+		});
+	});
+	Describe("OPT_TRY", [this]()
+	{
+		BeforeEach([this]()
+		{
+			CreateOuterChain();
+			m_try_steps = 0;
+		});
+		AfterEach([this]()
+		{
+			for (const auto obj : m_outer_chain)
+			{
+				obj->Destroy();
+			}
+			m_outer_chain.Reset();
+		});
+
+		It("should continue with the object if valid", [this]()
+		{
+			TestEqual<UObject*>("", TryGetOuterOfOuter(m_outer_chain[3]), m_outer_chain[1]);
+			TestEqual("", m_try_steps, 2);
+		});
+		It("should return from the function right away if the object is not valid", [this]()
+		{
+			m_outer_chain[2]->MarkPendingKill();
+			TestNull("", TryGetOuterOfOuter(m_outer_chain[3]));
+			TestEqual("", m_try_steps, 0);
+			TestNull("", TryGetOuterOfOuter(m_outer_chain[1]));
+			TestEqual("", m_try_steps, 1);
+			TestNull("", TryGetOuterOfOuter(nullptr));
+			TestEqual("", m_try_steps, 1);
+		});
+		It("should resolve weak pointers", [this]()
+		{
+			m_outer_chain[3]->m_weak_link = m_outer_chain[2];
+			TestEqual("", TryGetWeakLink(m_outer_chain[3]).Get(), m_outer_chain[2]);
+			m_outer_chain[2]->MarkPendingKill();
+			TestFalse("", TryGetWeakLink(m_outer_chain[3]).IsSet());
+			TestFalse("", TryGetWeakLink(nullptr).IsSet());
+		});
+		It("should return the fallback if the object is not valid", [this]()
+		{
+			TestTrue("", TryHasOuter(m_outer_chain[1]));
+			TestFalse("", TryHasOuter(m_outer_chain[0]));
+			TestFalse("", TryHasOuter(nullptr));
+		});
+		It("should return from void function if the object is not valid", [this]()
+		{
+			TryCountOuter(m_outer_chain[1]);
+			TryCountOuter(m_outer_chain[0]);
+			TestEqual("", m_try_steps, 1);
+		});
+	});
+#if defined(__cpp_impl_coroutine)
+	Describe("Coroutine", [this]()
+	{
+		BeforeEach([this]()
+		{
+			CreateOuterChain();
+			m_coroutine_steps = 0;
+		});
+		AfterEach([this]()
+		{
+			for (const auto obj : m_outer_chain)
+			{
+				obj->Destroy();
+			}
+			m_outer_chain.Reset();
+		});
+
+		It("should return the result if all awaited objects are valid", [this]()
+		{
+			auto testing_obj = CoroutineGetOuterOfOuter(m_outer_chain[3]);
+			TestEqual<UObject*>("", testing_obj.Get(), m_outer_chain[1]);
+			TestEqual("", m_coroutine_steps, 2);
+		});
+		It("should finish right away with empty optional if any awaited object is not valid", [this]()
+		{
+			m_outer_chain[2]->MarkPendingKill();
+			TestFalse("", CoroutineGetOuterOfOuter(m_outer_chain[3]).IsSet());
+			TestEqual("", m_coroutine_steps, 0);
+			TestFalse("", CoroutineGetOuterOfOuter(m_outer_chain[1]).IsSet());
+			TestEqual("", m_coroutine_steps, 1);
+			TestFalse("", CoroutineGetOuterOfOuter(nullptr).IsSet());
+			TestEqual("", m_coroutine_steps, 1);
+		});
+		It("should place frames in the coroutine stack of the thread", [this]()
+		{
+			MockLinkNode nodes[3];
+			nodes[2].m_next = &nodes[1];
+			nodes[1].m_next = &nodes[0];
+
+			SIZE_T used_stack = 0;
+			TestEqual("", CoroutineGetNextOfNext(&nodes[2], used_stack).Get(), &nodes[0]);
+			TestTrue("", used_stack > 0);
+			TestEqual("", FOptionalPtrCoroutineStack::Get().GetUsed(), static_cast<SIZE_T>(0));
+			TestFalse("", CoroutineGetNextOfNext(&nodes[0], used_stack).IsSet());
+			TestEqual("", FOptionalPtrCoroutineStack::Get().GetUsed(), static_cast<SIZE_T>(0));
+		});
+		It("should convert the result to TOptionalPtr", [this]()
+		{
+			TOptionalPtr<UObject> testing_obj = CoroutineGetOuterOfOuter(m_outer_chain[3]);
+			TestEqual<UObject*>("", testing_obj.Map(&UObject::GetOuter).Get(), m_outer_chain[0]);
+			TOptionalPtr<UObject> empty_obj = CoroutineGetOuterOfOuter(nullptr);
+			TestFalse("", empty_obj.IsSet());
+		});
+		It("should await other coroutines", [this]()
+		{
+			MockLinkNode nodes[4];
+			nodes[3].m_next = &nodes[2];
+			nodes[2].m_next = &nodes[1];
+			nodes[1].m_next = &nodes[0];
+
+			SIZE_T used_stack = 0;
+			TestEqual("", CoroutineGetNextOfNextOfNext(&nodes[3], used_stack).Get(), &nodes[0]);
+			TestFalse("", CoroutineGetNextOfNextOfNext(&nodes[1], used_stack).IsSet());
+			TestEqual("", FOptionalPtrCoroutineStack::Get().GetUsed(), static_cast<SIZE_T>(0));
+		});
+	});
+#endif
+	Describe("MapAsync", [this]()
+	{
+		BeforeEach([this]()
+		{
+			CreateOuterChain();
+			m_outer_chain[3]->m_soft_link = TSoftObjectPtr<UMockUObject>(FSoftObjectPath(TEXT("/Game/Mock/Asset.Asset")));
+			m_outer_chain[2]->m_soft_link = TSoftObjectPtr<UMockUObject>(FSoftObjectPath(TEXT("/Game/Mock/Asset.Asset")));
+			m_outer_chain[0]->m_soft_link = TSoftObjectPtr<UMockUObject>(FSoftObjectPath(TEXT("/Game/Mock/Other.Other")));
+		});
+		AfterEach([this]()
+		{
+			for (const auto obj : m_outer_chain)
+			{
+				obj->Destroy();
+			}
+			m_outer_chain.Reset();
+		});
+
+		It("should resume the chain when the asset is loaded", [this]()
+		{
+			TOptionalPtrAsyncLoader<FOptionalPtrMockLoader> loader;
+			loader.GetLoader().Assets.Add(FSoftObjectPath(TEXT("/Game/Mock/Asset.Asset")), m_outer_chain[0]);
+			loader.GetLoader().Latency = 2;
+
+			auto future = TOptionalPtr<UMockUObject>(m_outer_chain[3])
+				.MapAsync(&UMockUObject::m_soft_link, loader)
+				.Map(&MockObject::m_field);
+			TestTrue("", std::is_same<decltype(future), TOptionalPtrFuture<SimpleObject>>::value);
+			TestFalse("", future.IsReady());
+			loader.GetLoader().Tick();
+			TestFalse("", future.IsReady());
+			loader.GetLoader().Tick();
+			TestTrue("", future.IsReady());
+
+			SimpleObject* result = nullptr;
+			future.Then([&result](TOptionalPtr<SimpleObject> obj)
+			{
+				result = obj.Get();
+			});
+			TestEqual("", result, m_outer_chain[0]->m_field);
+		});
+		It("should request identical outstanding loads only once", [this]()
+		{
+			TOptionalPtrAsyncLoader<FOptionalPtrMockLoader> loader;
+			loader.GetLoader().Assets.Add(FSoftObjectPath(TEXT("/Game/Mock/Asset.Asset")), m_outer_chain[0]);
+
+			int32 num_loaded = 0;
+			const auto count_loaded = [&num_loaded](TOptionalPtr<UMockUObject> asset)
+			{
+				num_loaded += asset.IsSet();
+			};
+			TOptionalPtr<UMockUObject>(m_outer_chain[3]).MapAsync(&UMockUObject::m_soft_link, loader).Then(count_loaded);
+			TOptionalPtr<UMockUObject>(m_outer_chain[2]).MapAsync(&UMockUObject::m_soft_link, loader).Then(count_loaded);
+			TestEqual("", loader.GetLoader().NumRequests, 1);
+			TestEqual("", loader.NumPending(), 1);
+
+			loader.GetLoader().Tick();
+			TestEqual("", num_loaded, 2);
+			TestEqual("", loader.NumPending(), 0);
+		});
+		It("should continue with another async step", [this]()
+		{
+			TOptionalPtrAsyncLoader<FOptionalPtrMockLoader> loader;
+			loader.GetLoader().Assets.Add(FSoftObjectPath(TEXT("/Game/Mock/Asset.Asset")), m_outer_chain[0]);
+			loader.GetLoader().Assets.Add(FSoftObjectPath(TEXT("/Game/Mock/Other.Other")), m_outer_chain[1]);
+
+			auto future = TOptionalPtr<UMockUObject>(m_outer_chain[3])
+				.MapAsync(&UMockUObject::m_soft_link, loader)
+				.MapAsync(&UMockUObject::m_soft_link, loader);
+			loader.GetLoader().Tick();
+			TestFalse("", future.IsReady());
+			TestEqual("", loader.GetLoader().NumRequests, 2);
+			loader.GetLoader().Tick();
+			TestTrue("", future.IsReady());
+
+			UMockUObject* result = nullptr;
+			future.Then([&result](TOptionalPtr<UMockUObject> asset)
+			{
+				result = asset.Get();
+			});
+			TestEqual("", result, m_outer_chain[1]);
+		});
+		It("should return empty optional if the asset fails to load", [this]()
+		{
+			TOptionalPtrAsyncLoader<FOptionalPtrMockLoader> loader;
+			auto future = TOptionalPtr<UMockUObject>(m_outer_chain[3]).MapAsync(&UMockUObject::m_soft_link, loader);
+			loader.GetLoader().Tick();
+			TestTrue("", future.IsReady());
+
+			bool is_set = true;
+			future.Then([&is_set](TOptionalPtr<UMockUObject> asset)
+			{
+				is_set = asset.IsSet();
+			});
+			TestFalse("", is_set);
+		});
+		It("should be ready right away if wrapped object is not valid", [this]()
+		{
+			TOptionalPtrAsyncLoader<FOptionalPtrMockLoader> loader;
+			m_outer_chain[3]->MarkPendingKill();
+			TestTrue("", TOptionalPtr<UMockUObject>(m_outer_chain[3]).MapAsync(&UMockUObject::m_soft_link, loader).IsReady());
+			TestTrue("", TOptionalPtr<UMockUObject>(m_outer_chain[1]).MapAsync(&UMockUObject::m_soft_link, loader).IsReady());
+			TestEqual("", loader.GetLoader().NumRequests, 0);
+		});
+		LatentIt("should run the continuation on the given thread", [this](const FDoneDelegate& done)
+		{
+			TOptionalPtrAsyncLoader<FOptionalPtrMockLoader> loader;
+			loader.GetLoader().Assets.Add(FSoftObjectPath(TEXT("/Game/Mock/Asset.Asset")), m_outer_chain[0]);
+
+			UMockUObject* const expected = m_outer_chain[0];
+			TOptionalPtr<UMockUObject>(m_outer_chain[3])
+				.MapAsync(&UMockUObject::m_soft_link, loader)
+				.Then(ENamedThreads::AnyBackgroundThreadNormalTask, [this, done, expected](TOptionalPtr<UMockUObject> asset)
+				{
+					TestFalse("", IsInGameThread());
+					TestEqual("", asset.Get(), expected);
+					done.Execute();
+				});
+			loader.GetLoader().Tick();
+		});
+	});
+	Describe("GetResult", [this]()
+	{
+		BeforeEach([this]()
+		{
+			CreateOuterChain();
+		});
+		AfterEach([this]()
+		{
+			for (const auto obj : m_outer_chain)
+			{
+				obj->Destroy();
+			}
+			m_outer_chain.Reset();
+		});
+
+		It("should return the object if the chain succeeded", [this]()
+		{
+			const auto result = TOptionalPtr<UMockUObject, TOptionalPtrStepPolicy<>>(m_outer_chain[3])
+				.Map(&UObject::GetOuter)
+				.Map(&UObject::GetOuter)
+				.GetResult();
+			TestTrue("", result.IsSet());
+			TestEqual<UObject*>("", result.Get(), m_outer_chain[1]);
+			TestEqual("", result.GetFailedStep(), INDEX_NONE);
+		});
+		It("should return the failed step if the wrapped object is not valid", [this]()
+		{
+			const auto result = TOptionalPtr<UMockUObject, TOptionalPtrStepPolicy<>>(nullptr).Map(&UObject::GetOuter).GetResult();
+			TestFalse("", result.IsSet());
+			TestNull("", result.Get());
+			TestEqual("", result.GetFailedStep(), 0);
+
+			uint8 byte = 0;
+			TestEqual("", TOptionalPtr<uint8, TOptionalPtrStepPolicy<>>(&byte).GetResult().Get(), &byte);
+			TestEqual("", TOptionalPtr<uint8, TOptionalPtrStepPolicy<>>(nullptr).GetResult().GetFailedStep(), 0);
+		});
+		It("should return the first step which didn't return valid object", [this]()
+		{
+			TestEqual("", TOptionalPtr<UMockUObject, TOptionalPtrStepPolicy<>>(m_outer_chain[1])
+				.Map(&UObject::GetOuter)
+				.Map(&UObject::GetOuter)
+				.Map(&UObject::GetOuter)
+				.GetResult().GetFailedStep(), 2);
+
+			m_outer_chain[2]->MarkPendingKill();
+			const auto result = TOptionalPtr<UMockUObject, TOptionalPtrStepPolicy<>>(m_outer_chain[3])
+				.Map(&UObject::GetOuter)
+				.Map(&UObject::GetOuter)
+				.GetResult();
+			TestNull("", result.Get());
+			TestEqual("", result.GetFailedStep(), 1);
+		});
+		It("should count the steps of all operations", [this]()
+		{
+			TestEqual("", TOptionalPtr<UMockUObject, TOptionalPtrStepPolicy<>>(m_outer_chain[3])
+				.MapAt(&MockObject::m_items, 1)
+				.GetResult().GetFailedStep(), 1);
+			TestEqual("", TOptionalPtr<UMockUObject, TOptionalPtrStepPolicy<>>(m_outer_chain[3])
+				.MapAt(&MockObject::m_items, 2)
+				.GetResult().GetFailedStep(), 1);
+			TestEqual("", TOptionalPtr<UMockUObject, TOptionalPtrStepPolicy<>>(m_outer_chain[1])
+				.FindAncestor<UMockAncestorUObject>()
+				.Map(&UObject::GetOuter)
+				.GetResult().GetFailedStep(), 1);
+		});
+		It("should count the steps past the maximum as the maximum", [this]()
+		{
+			MockLinkNode node;
+			node.m_next = &node;
+			TOptionalPtr<MockLinkNode, TOptionalPtrStepPolicy<>> chain(&node);
+			for (int32 i = 0; i < 300; ++i)
+			{
+				chain = chain.Map(&MockLinkNode::m_next);
+			}
+			TestEqual("", chain.Map(&MockLinkNode::m_unique_next).Map(&MockLinkNode::m_next).GetResult().GetFailedStep(), 255);
+		});
+		It("should be as big as the pointer", [this]()
+		{
+			TestEqual("", sizeof(TOptionalResult<UMockUObject>), sizeof(UMockUObject*));
+#if !OPTIONAL_PTR_STATS
+			TestEqual("", sizeof(TOptionalPtr<UMockUObject>), sizeof(UMockUObject*));
+			TestEqual("", sizeof(TOptionalPtr<UMockUObject, TOptionalPtrResolvedPolicy<>>), sizeof(UMockUObject*));
+#endif
+		});
+	});
+	Describe("IfPresentDeferred", [this]()
+	{
+		It("should execute the method once the buffer is flushed", [this]()
+		{
+			FOptionalPtrCommandBuffer buffer;
+			MockLinkNode node(1);
+			TOptionalPtr<MockLinkNode>(&node).IfPresentDeferred(buffer, &MockLinkNode::AddValue, 2);
+			TestEqual("", node.m_value, 1);
+			TestEqual("", buffer.Num(), 1);
+
+			TestEqual("", buffer.Flush(), 1);
+			TestEqual("", node.m_value, 3);
+			TestEqual("", buffer.Num(), 0);
+		});
+		It("should not record the method if the wrapped object is not valid", [this]()
+		{
+			FOptionalPtrCommandBuffer buffer;
+			TOptionalPtr<MockLinkNode>(nullptr).IfPresentDeferred(buffer, &MockLinkNode::AddValue, 2);
+			TestEqual("", buffer.Num(), 0);
+		});
+		It("should skip the objects which are not valid anymore when flushed", [this]()
+		{
+			FOptionalPtrCommandBuffer buffer;
+			UMockUObject* obj = NewObject<UMockUObject>();
+			int32 num_calls = 0;
+			TOptionalPtr<UMockUObject>(obj).IfPresentDeferred(buffer, &MockObject::MethodWithParamPointerCounter, &num_calls);
+			TOptionalPtr<UMockUObject>(obj).IfPresentDeferred(buffer, &MockObject::MethodWithParamPointerCounter, &num_calls);
+			obj->MarkPendingKill();
+
+			TestEqual("", buffer.Flush(), 0);
+			TestEqual("", num_calls, 0);
+			obj->Destroy();
+		});
+		It("should execute the methods in the order of the objects, keeping the order of methods of the same object", [this]()
+		{
+			FOptionalPtrCommandBuffer buffer;
+			MockLinkNode nodes[3];
+			for (int32 i = 0; i < 3; ++i)
+			{
+				nodes[i].m_value = i;
+			}
+			TArray<int32> log;
+			TOptionalPtr<MockLinkNode>(&nodes[2]).IfPresentDeferred(buffer, &MockLinkNode::LogValue, &log);
+			TOptionalPtr<MockLinkNode>(&nodes[0]).IfPresentDeferred(buffer, &MockLinkNode::LogValue, &log);
+			TOptionalPtr<MockLinkNode>(&nodes[0]).IfPresentDeferred(buffer, &MockLinkNode::AddValue, 10);
+			TOptionalPtr<MockLinkNode>(&nodes[0]).IfPresentDeferred(buffer, &MockLinkNode::LogValue, &log);
+			TOptionalPtr<MockLinkNode>(&nodes[1]).IfPresentDeferred(buffer, &MockLinkNode::LogValue, &log);
+
+			TestEqual("", buffer.Flush(), 5);
+			TestTrue("", log == TArray<int32>({0, 10, 1, 2}));
+		});
+		It("should execute the methods in the order of recording", [this]()
+		{
+			FOptionalPtrCommandBuffer buffer;
+			MockLinkNode nodes[2];
+			for (int32 i = 0; i < 2; ++i)
+			{
+				nodes[i].m_value = i;
+			}
+			TArray<int32> log;
+			TOptionalPtr<MockLinkNode>(&nodes[1]).IfPresentDeferred(buffer, &MockLinkNode::LogValue, &log);
+			TOptionalPtr<MockLinkNode>(&nodes[0]).IfPresentDeferred(buffer, &MockLinkNode::LogValue, &log);
+
+			buffer.Flush(EOptionalPtrCommandOrder::Recorded);
+			TestTrue("", log == TArray<int32>({1, 0}));
+		});
+		It("should execute all the calls of the same method together", [this]()
+		{
+			FOptionalPtrCommandBuffer buffer;
+			MockLinkNode nodes[2];
+			for (int32 i = 0; i < 2; ++i)
+			{
+				nodes[i].m_value = i;
+			}
+			TArray<int32> log;
+			for (MockLinkNode& node : nodes)
+			{
+				TOptionalPtr<MockLinkNode>(&node).IfPresentDeferred(buffer, &MockLinkNode::LogValue, &log);
+				TOptionalPtr<MockLinkNode>(&node).IfPresentDeferred(buffer, &MockLinkNode::AddValue, 5);
+			}
+
+			buffer.Flush(EOptionalPtrCommandOrder::Member);
+			TestTrue("", log == TArray<int32>({0, 1}) || log == TArray<int32>({5, 6}));
+		});
+		It("should discard the calls when reset", [this]()
+		{
+			FOptionalPtrCommandBuffer buffer;
+			MockLinkNode node(1);
+			TOptionalPtr<MockLinkNode>(&node).IfPresentDeferred(buffer, &MockLinkNode::AddValue, 2);
+			buffer.Reset();
+
+			TestEqual("", buffer.Flush(), 0);
+			TestEqual("", node.m_value, 1);
+		});
+	});
+	Describe("RequestQueue", [this]()
+	{
+		BeforeEach([this]()
+		{
+			CreateOuterChain();
+		});
+		AfterEach([this]()
+		{
+			for (const auto obj : m_outer_chain)
+			{
+				obj->Destroy();
+			}
+			m_outer_chain.Reset();
+		});
+
+		It("should execute the request when drained", [this]()
+		{
+			const auto chain = TOptionalPtrChainBuilder<UMockUObject>()
+				.Map(&UObject::GetOuter)
+				.Map(&UObject::GetOuter)
+				.Build();
+			FOptionalPtrRequestQueue queue;
+			TOptionalPtrRequest<UObject> request;
+			queue.Enqueue(chain, m_outer_chain[3], request);
+			TestFalse("", request.IsReady());
+			TestFalse("", queue.IsEmpty());
+
+			TestEqual("", queue.Drain(), 1);
+			TestTrue("", request.IsReady());
+			TestTrue("", queue.IsEmpty());
+			TestEqual<UObject*>("", request.Get().Get(), m_outer_chain[1]);
+		});
+		It("should return empty optional if any object on the way is not valid", [this]()
+		{
+			const auto chain = TOptionalPtrChainBuilder<UMockUObject>()
+				.Map(&UObject::GetOuter)
+				.Map(&UObject::GetOuter)
+				.Build();
+			FOptionalPtrRequestQueue queue;
+			TOptionalPtrRequest<UObject> request;
+			queue.Enqueue(chain, m_outer_chain[1], request);
+			queue.Drain();
+			TestTrue("", request.IsReady());
+			TestFalse("", request.Get().IsSet());
+		});
+		It("should not validate the result again when read", [this]()
+		{
+			const auto chain = TOptionalPtrChainBuilder<UMockUObject>()
+				.Map(&UObject::GetOuter)
+				.Build();
+			FOptionalPtrRequestQueue queue;
+			TOptionalPtrRequest<UObject> request;
+			queue.Enqueue(chain, m_outer_chain[3], request);
+			queue.Drain();
+			m_outer_chain[2]->MarkPendingKill();
+			TestEqual<UObject*>("", request.Get().Get(), m_outer_chain[2]);
+		});
+		It("should execute duplicate requests only once", [this]()
+		{
+			const auto chain = TOptionalPtrChainBuilder<UMockUObject>()
+				.Map(&UObject::GetOuter)
+				.Build();
+			FOptionalPtrRequestQueue queue;
+			TOptionalPtrRequest<UObject> requests[3];
+			queue.Enqueue(chain, m_outer_chain[3], requests[0]);
+			queue.Enqueue(chain, m_outer_chain[2], requests[1]);
+			queue.Enqueue(chain, m_outer_chain[3], requests[2]);
+
+			TestEqual("", queue.Drain(), 2);
+			TestEqual<UObject*>("", requests[0].Get().Get(), m_outer_chain[2]);
+			TestEqual<UObject*>("", requests[1].Get().Get(), m_outer_chain[1]);
+			TestEqual<UObject*>("", requests[2].Get().Get(), m_outer_chain[2]);
+
+			queue.Enqueue(chain, m_outer_chain[3], requests[0]);
+			TestFalse("", requests[0].IsReady());
+			TestEqual("", queue.Drain(), 1);
+		});
+		It("should accept requests from multiple threads", [this]()
+		{
+			const auto chain = TOptionalPtrChainBuilder<UMockUObject>()
+				.Map(&UObject::GetOuter)
+				.Build();
+			FOptionalPtrRequestQueue queue;
+			const int32 num_threads = 8;
+			const int32 num_requests = 1000;
+			TOptionalPtrRequest<UObject>* requests = new TOptionalPtrRequest<UObject>[num_threads * num_requests];
+			ParallelFor(num_threads, [&](int32 thread)
+			{
+				for (int32 i = 0; i < num_requests; ++i)
+				{
+					queue.Enqueue(chain, m_outer_chain[1 + i % 3], requests[thread * num_requests + i]);
+				}
+			});
+
+			TestEqual("", queue.Drain(), 3);
+			int32 num_correct = 0;
+			for (int32 i = 0; i < num_threads * num_requests; ++i)
+			{
+				num_correct += requests[i].IsReady() && requests[i].Get().Get() == m_outer_chain[i % num_requests % 3];
+			}
+			TestEqual("", num_correct, num_threads * num_requests);
+			delete[] requests;
+		});
+	});
+	Describe("IfPresentAll", [this]()
+	{
+		const int32 num_owners = 32;
+		const int32 num_nodes = OptionalPtrParallelBuckets * OptionalPtrParallelMinObjectsPerBucket * 2;
+
+		It("should apply function to all valid objects", [this, num_nodes]()
+		{
+			MockLinkNode* nodes = new MockLinkNode[num_nodes];
+			TArray<MockLinkNode*> objects;
+			for (int32 i = 0; i < num_nodes; ++i)
+			{
+				objects.Add(&nodes[i]);
+				objects.Add(nullptr);
+			}
+
+			const int32 num_called = IfPresentAll(objects, [](MockLinkNode* node) { return node; },
+				EOptionalPtrParallelOrder::Any, &MockLinkNode::AddValue, 2);
+			TestEqual("", num_called, num_nodes);
+			int32 num_correct = 0;
+			for (int32 i = 0; i < num_nodes; ++i)
+			{
+				num_correct += nodes[i].m_value == 2;
+			}
+			TestEqual("", num_correct, num_nodes);
+			delete[] nodes;
+		});
+		for (const auto order : {EOptionalPtrParallelOrder::Any, EOptionalPtrParallelOrder::Deterministic})
+		{
+			It(FString::Printf(TEXT("should call objects with the same key in order for order %d"), static_cast<int32>(order)),
+				[this, num_owners, num_nodes, order]()
+			{
+				MockLinkNode owners[num_owners];
+				MockLinkNode* nodes = new MockLinkNode[num_nodes];
+				TArray<MockLinkNode*> objects;
+				for (int32 i = 0; i < num_nodes; ++i)
+				{
+					nodes[i].m_value = i;
+					nodes[i].m_next = &owners[i % num_owners];
+					objects.Add(&nodes[i]);
+				}
+
+				IfPresentAll(objects, [](MockLinkNode* node) { return node->GetNext(); }, order, &MockLinkNode::LogValueToNext);
+				int32 num_correct = 0;
+				for (int32 owner = 0; owner < num_owners; ++owner)
+				{
+					bool ordered = owners[owner].m_log.Num() == num_nodes / num_owners;
+					for (int32 i = 0; ordered && i < owners[owner].m_log.Num(); ++i)
+					{
+						ordered = owners[owner].m_log[i] == i * num_owners + owner;
+					}
+					num_correct += ordered;
+				}
+				TestEqual("", num_correct, num_owners);
+				delete[] nodes;
+			});
+		}
+		It("should call objects on the calling thread if there are only few of them", [this]()
+		{
+			MockLinkNode owner;
+			MockLinkNode nodes[3];
+			TArray<MockLinkNode*> objects;
+			for (int32 i = 0; i < 3; ++i)
+			{
+				nodes[i].m_value = i;
+				nodes[i].m_next = &owner;
+				objects.Add(&nodes[i]);
+			}
+
+			TestEqual("", IfPresentAll(objects, [](MockLinkNode* node) { return node; },
+				EOptionalPtrParallelOrder::Deterministic, &MockLinkNode::LogValueToNext), 3);
+			TestEqual("", owner.m_log, TArray<int32>{0, 1, 2});
+		});
+	});
+	Describe("TimeSlicer", [this]()
+	{
+		BeforeEach([this]()
+		{
+			CreateOuterChain();
+		});
+		AfterEach([this]()
+		{
+			for (const auto obj : m_outer_chain)
+			{
+				obj->Destroy();
+			}
+			m_outer_chain.Reset();
+		});
+
+		It("should process all elements within budget", [this]()
+		{
+			const auto chain = TOptionalPtrChainBuilder<UMockUObject>()
+				.Map(&UObject::GetOuter)
+				.Build();
+			TOptionalPtrTimeSlicer<UMockUObject, UObject> slicer(chain, m_outer_chain);
+			TArray<UObject*> results;
+			results.SetNumZeroed(m_outer_chain.Num());
+			TestTrue("", slicer.Tick(1000000.0, [&](int32 index, TOptionalPtr<UObject> result)
+			{
+				results[index] = result.IsSet() ? result.Get() : nullptr;
+			}));
+			TestTrue("", slicer.IsDone());
+			TestEqual("", slicer.GetProgress(), 1.f);
+			TestEqual("", slicer.GetStats().NumProcessed, static_cast<int64>(m_outer_chain.Num()));
+			TestEqual("", results, TArray<UObject*>{nullptr, m_outer_chain[0], m_outer_chain[1], m_outer_chain[2]});
+		});
+		It("should resume from the cursor if out of budget", [this]()
+		{
+			const auto chain = TOptionalPtrChainBuilder<UMockUObject>()
+				.Map(&UObject::GetOuter)
+				.Build();
+			TOptionalPtrTimeSlicer<UMockUObject, UObject> slicer(chain, m_outer_chain);
+			TArray<int32> processed;
+			const auto log_index = [&](int32 index, TOptionalPtr<UObject>) { processed.Add(index); };
+			TestFalse("", slicer.Tick(0.0, log_index));
+			TestEqual("", slicer.GetProgress(), 0.25f);
+			TestFalse("", slicer.Tick(0.0, log_index));
+			TestFalse("", slicer.Tick(0.0, log_index));
+			TestTrue("", slicer.Tick(0.0, log_index));
+			TestTrue("", slicer.Tick(0.0, log_index));
+			TestEqual("", processed, TArray<int32>{0, 1, 2, 3});
+			TestEqual("", slicer.GetStats().NumTicks, 4);
+
+			slicer.Restart();
+			TestFalse("", slicer.IsDone());
+			TestEqual("", slicer.GetProgress(), 0.f);
+		});
+		It("should process dirty elements first if prioritized", [this]()
+		{
+			const auto chain = TOptionalPtrChainBuilder<UMockUObject>()
+				.Map(&UObject::GetOuter)
+				.Build();
+			TOptionalPtrTimeSlicer<UMockUObject, UObject> slicer(chain, m_outer_chain);
+			TArray<int32> processed;
+			const auto log_index = [&](int32 index, TOptionalPtr<UObject>) { processed.Add(index); };
+			slicer.Tick(0.0, log_index);
+			slicer.MarkDirty(0);
+			slicer.MarkDirty(3);
+			slicer.MarkDirty(0);
+			while (!slicer.Tick(0.0, log_index)) {}
+			TestEqual("", processed, TArray<int32>{0, 0, 3, 1, 2, 3});
+		});
+		It("should process dirty elements after the pass if not prioritized", [this]()
+		{
+			const auto chain = TOptionalPtrChainBuilder<UMockUObject>()
+				.Map(&UObject::GetOuter)
+				.Build();
+			TOptionalPtrTimeSlicer<UMockUObject, UObject> slicer(chain, m_outer_chain, false);
+			TArray<int32> processed;
+			const auto log_index = [&](int32 index, TOptionalPtr<UObject>) { processed.Add(index); };
+			slicer.Tick(0.0, log_index);
+			slicer.MarkDirty(0);
+			slicer.MarkDirty(3);
+			while (!slicer.Tick(0.0, log_index)) {}
+			TestEqual("", processed, TArray<int32>{0, 1, 2, 3, 0});
+		});
+		It("should drop dirty elements removed from the roots", [this]()
+		{
+			const auto chain = TOptionalPtrChainBuilder<UMockUObject>()
+				.Map(&UObject::GetOuter)
+				.Build();
+			TArray<UMockUObject*> roots = m_outer_chain;
+			TOptionalPtrTimeSlicer<UMockUObject, UObject> slicer(chain, roots);
+			TArray<int32> processed;
+			const auto log_index = [&](int32 index, TOptionalPtr<UObject>) { processed.Add(index); };
+			while (!slicer.Tick(0.0, log_index)) {}
+			slicer.MarkDirty(3);
+			slicer.MarkDirty(1);
+			slicer.MarkDirty(2);
+
+			roots.SetNum(2);
+			slicer.MarkDirty(0);
+			while (!slicer.Tick(0.0, log_index)) {}
+			TestEqual("", processed, TArray<int32>{0, 1, 2, 3, 1, 0});
+
+			roots = m_outer_chain;
+			slicer.MarkDirty(3);
+			while (!slicer.Tick(0.0, log_index)) {}
+			TestEqual("", processed.Last(), 3);
+		});
+	});
+	Describe("Binding", [this]()
+	{
+		It("should evaluate all hops on the first update", [this]()
+		{
+			MockVersionedNode nodes[3];
+			nodes[0].SetNext(&nodes[1]);
+			nodes[1].SetNext(&nodes[2]);
+			auto binding = MakeOptionalPtrBinding(&nodes[0], &MockVersionedNode::GetNext, &MockVersionedNode::GetNext);
+			TestFalse("", binding.Get().IsSet());
+			TestTrue("", binding.Update());
+			TestEqual("", binding.GetNumFollowedHops(), 2);
+			TestEqual("", binding.Get().Get(), &nodes[2]);
+		});
+		It("should reuse hops from versioned objects which didn't change", [this]()
+		{
+			MockVersionedNode nodes[3];
+			nodes[0].SetNext(&nodes[1]);
+			nodes[1].SetNext(&nodes[2]);
+			auto binding = MakeOptionalPtrBinding(&nodes[0], &MockVersionedNode::GetNext, &MockVersionedNode::GetNext);
+			binding.Update();
+			TestFalse("", binding.Update());
+			TestEqual("", binding.GetNumFollowedHops(), 0);
+			TestEqual("", binding.Get().Get(), &nodes[2]);
+		});
+		It("should follow hops from versioned objects which changed", [this]()
+		{
+			MockVersionedNode nodes[4];
+			nodes[0].SetNext(&nodes[1]);
+			nodes[1].SetNext(&nodes[2]);
+			auto binding = MakeOptionalPtrBinding(&nodes[0], &MockVersionedNode::GetNext, &MockVersionedNode::GetNext);
+			binding.Update();
+			nodes[1].SetNext(&nodes[3]);
+			TestTrue("", binding.Update());
+			TestEqual("", binding.GetNumFollowedHops(), 1);
+			TestEqual("", binding.Get().Get(), &nodes[3]);
+
+			nodes[0].SetNext(nullptr);
+			TestTrue("", binding.Update());
+			TestEqual("", binding.GetNumFollowedHops(), 2);
+			TestFalse("", binding.Get().IsSet());
+		});
+		It("should follow hops from objects which are not versioned", [this]()
+		{
+			CreateLinkChain();
+			auto binding = MakeOptionalPtrBinding(m_link_chain[3], &MockLinkNode::m_next, &MockLinkNode::GetNext);
+			TestTrue("", binding.Update());
+			TestFalse("", binding.Update());
+			TestEqual("", binding.GetNumFollowedHops(), 2);
+			TestEqual("", binding.Get().Get(), m_link_chain[1]);
+
+			for (const auto node : m_link_chain)
+			{
+				delete node;
+			}
+			m_link_chain.Reset();
+		});
+		It("should return empty optional if reused object is not valid anymore", [this]()
+		{
+			CreateOuterChain();
+			auto binding = MakeOptionalPtrBinding(m_outer_chain[3], &UObject::GetOuter, &UObject::GetOuter);
+			binding.Update();
+			TestEqual<UObject*>("", binding.Get().Get(), m_outer_chain[1]);
+
+			m_outer_chain[1]->MarkPendingKill();
+			TestTrue("", binding.Update());
+			TestFalse("", binding.Get().IsSet());
+
+			for (const auto obj : m_outer_chain)
+			{
+				obj->Destroy();
+			}
+			m_outer_chain.Reset();
+		});
+		It("should return empty optional if versioned object is not valid anymore", [this]()
+		{
+			CreateOuterChain();
+			UMockVersionedUObject* const root = NewObject<UMockVersionedUObject>(m_outer_chain[3]);
+			auto binding = MakeOptionalPtrBinding(root, &UObject::GetOuter);
+			binding.Update();
+			TestEqual<UObject*>("", binding.Get().Get(), m_outer_chain[3]);
+
+			root->MarkPendingKill();
+			TestTrue("", binding.Update());
+			TestFalse("", binding.Get().IsSet());
+
+			root->Destroy();
+			for (const auto obj : m_outer_chain)
+			{
+				obj->Destroy();
+			}
+			m_outer_chain.Reset();
+		});
+		It("should notify subscribers only when the result changes", [this]()
+		{
+			MockVersionedNode nodes[3];
+			nodes[0].SetNext(&nodes[1]);
+			auto binding = MakeOptionalPtrBinding(&nodes[0], &MockVersionedNode::GetNext);
+			TArray<MockVersionedNode*> notified;
+			const int32 handle = binding.Subscribe([&](TOptionalPtr<MockVersionedNode> result)
+			{
+				notified.Add(result.IsSet() ? result.Get() : nullptr);
+			});
+			binding.Update();
+			binding.Update();
+			nodes[0].SetNext(&nodes[1]);
+			binding.Update();
+			nodes[0].SetNext(&nodes[2]);
+			binding.Update();
+			binding.Unsubscribe(handle);
+			nodes[0].SetNext(nullptr);
+			binding.Update();
+			TestEqual("", notified, TArray<MockVersionedNode*>{&nodes[1], &nodes[2]});
+		});
+		It("should reuse handles of the unsubscribed subscribers", [this]()
+		{
+			MockVersionedNode nodes[2];
+			nodes[0].SetNext(&nodes[1]);
+			auto binding = MakeOptionalPtrBinding(&nodes[0], &MockVersionedNode::GetNext);
+			TArray<int32> notified;
+			const int32 first = binding.Subscribe([&](TOptionalPtr<MockVersionedNode>) { notified.Add(0); });
+			const int32 second = binding.Subscribe([&](TOptionalPtr<MockVersionedNode>) { notified.Add(1); });
+			binding.Unsubscribe(first);
+			TestEqual("", binding.Subscribe([&](TOptionalPtr<MockVersionedNode>) { notified.Add(2); }), first);
+			TestEqual("", binding.Subscribe([&](TOptionalPtr<MockVersionedNode>) { notified.Add(3); }), second + 1);
+			binding.Update();
+			TestEqual("", notified, TArray<int32>{2, 1, 3});
+		});
+	});
+	Describe("EpochDomain", [this]()
+	{
+		It("should map through objects inside a guard", [this]()
+		{
+			MockReclaimedNode nodes[3];
+			nodes[0].m_next = &nodes[1];
+			nodes[1].m_next = &nodes[2];
+			FOptionalPtrEpochGuard guard;
+			auto result = TOptionalPtr<MockReclaimedNode, TOptionalPtrEpochPolicy<>>(&nodes[0])
+				.Map(&MockReclaimedNode::GetNext)
+				.Map(&MockReclaimedNode::GetNext);
+			TestEqual("", result.Get(), &nodes[2]);
+			TestFalse("", TOptionalPtr<MockReclaimedNode, TOptionalPtrEpochPolicy<>>(&nodes[2]).Map(&MockReclaimedNode::GetNext).IsSet());
+		});
+		It("should stay in the guard until the outermost one ends", [this]()
+		{
+			FOptionalPtrEpochDomain& domain = FOptionalPtrEpochDomain::Get();
+			TestFalse("", domain.IsInGuard());
+			{
+				FOptionalPtrEpochGuard guard;
+				{
+					FOptionalPtrEpochGuard nested_guard;
+				}
+				TestTrue("", domain.IsInGuard());
+			}
+			TestFalse("", domain.IsInGuard());
+		});
+		It("should delete retired object only after all guards end", [this]()
+		{
+			FOptionalPtrEpochDomain& domain = FOptionalPtrEpochDomain::Get();
+			std::atomic<int32> num_destroyed{0};
+			MockReclaimedNode* node = new MockReclaimedNode();
+			node->m_num_destroyed = &num_destroyed;
+			{
+				FOptionalPtrEpochGuard guard;
+				domain.Retire(node);
+				for (int32 i = 0; i < 3; ++i)
+				{
+					domain.Reclaim();
+				}
+				TestEqual("", num_destroyed.load(), 0);
+			}
+			int32 num_deleted = 0;
+			for (int32 i = 0; i < 3; ++i)
+			{
+				num_deleted += domain.Reclaim();
+			}
+			TestEqual("", num_deleted, 1);
+			TestEqual("", num_destroyed.load(), 1);
+		});
+		It("should not delete objects read by other threads", [this]()
+		{
+			ReclamationTest(FOptionalPtrEpochDomain::Get(), [](MockReclaimedNode& root, MockReclaimedNode* next)
+			{
+				return root.m_next.exchange(next);
+			}, [](MockReclaimedNode& root)
+			{
+				FOptionalPtrEpochGuard guard;
+				auto next = TOptionalPtr<MockReclaimedNode, TOptionalPtrEpochPolicy<>>(&root).Map(&MockReclaimedNode::GetNext);
+				return next.IsSet() && next.Get()->m_value != 1;
+			});
+		});
+	});
+	Describe("HazardDomain", [this]()
+	{
+		It("should map through hazard pointer fields and getters", [this]()
+		{
+			MockReclaimedNode nodes[3];
+			nodes[0].m_hazard_next.Store(&nodes[1]);
+			nodes[1].m_hazard_next.Store(&nodes[2]);
+			FOptionalPtrHazardScope scope;
+			auto result = TOptionalPtr<MockReclaimedNode, TOptionalPtrHazardPolicy<>>(&nodes[0])
+				.Map(&MockReclaimedNode::m_hazard_next)
+				.Map(&MockReclaimedNode::GetHazardNext);
+			TestEqual("", result.Get(), &nodes[2]);
+			TestFalse("", TOptionalPtr<MockReclaimedNode, TOptionalPtrHazardPolicy<>>(&nodes[2]).Map(&MockReclaimedNode::m_hazard_next).IsSet());
+		});
+		It("should not delete retired objects in hazard slots", [this]()
+		{
+			FOptionalPtrHazardDomain& domain = FOptionalPtrHazardDomain::Get();
+			std::atomic<int32> num_destroyed{0};
+			MockReclaimedNode root;
+			MockReclaimedNode* const nodes[3] = {new MockReclaimedNode(), new MockReclaimedNode(), new MockReclaimedNode()};
+			for (MockReclaimedNode* node : nodes)
+			{
+				node->m_num_destroyed = &num_destroyed;
+			}
+			root.m_hazard_next.Store(nodes[0]);
+			nodes[0]->m_hazard_next.Store(nodes[1]);
+			{
+				FOptionalPtrHazardScope scope;
+				TOptionalPtr<MockReclaimedNode, TOptionalPtrHazardPolicy<>>(&root).Map(&MockReclaimedNode::m_hazard_next).Map(&MockReclaimedNode::m_hazard_next);
+				root.m_hazard_next.Store(nullptr);
+				domain.Retire(nodes[0]);
+				domain.Retire(nodes[1]);
+				domain.Retire(nodes[2]);
+				TestEqual("", domain.Reclaim(), 1);
+				TestEqual("", domain.GetNumRetired(), 2);
+			}
+			TestEqual("", domain.Reclaim(), 2);
+			TestEqual("", num_destroyed.load(), 3);
+		});
+		It("should not delete objects read by other threads", [this]()
+		{
+			ReclamationTest(FOptionalPtrHazardDomain::Get(), [](MockReclaimedNode& root, MockReclaimedNode* next)
+			{
+				return root.m_hazard_next.Exchange(next);
+			}, [](MockReclaimedNode& root)
+			{
+				FOptionalPtrHazardScope scope;
+				auto next = TOptionalPtr<MockReclaimedNode, TOptionalPtrHazardPolicy<>>(&root).Map(&MockReclaimedNode::m_hazard_next);
+				return next.IsSet() && next.Get()->m_value != 1;
+			});
+		});
+		It("should keep objects of the outer scope protected after nested scope ends", [this]()
+		{
+			FOptionalPtrHazardDomain& domain = FOptionalPtrHazardDomain::Get();
+			std::atomic<int32> num_destroyed{0};
+			MockReclaimedNode root;
+			MockReclaimedNode* const nodes[3] = {new MockReclaimedNode(), new MockReclaimedNode(), new MockReclaimedNode()};
+			for (MockReclaimedNode* node : nodes)
+			{
+				node->m_num_destroyed = &num_destroyed;
+			}
+			root.m_hazard_next.Store(nodes[0]);
+			nodes[0]->m_hazard_next.Store(nodes[1]);
+			nodes[1]->m_hazard_next.Store(nodes[2]);
+			{
+				FOptionalPtrHazardScope scope;
+				auto next = TOptionalPtr<MockReclaimedNode, TOptionalPtrHazardPolicy<>>(&root).Map(&MockReclaimedNode::m_hazard_next);
+				{
+					FOptionalPtrHazardScope nested_scope;
+					TOptionalPtr<MockReclaimedNode, TOptionalPtrHazardPolicy<>>(next.Get())
+						.Map(&MockReclaimedNode::m_hazard_next)
+						.Map(&MockReclaimedNode::m_hazard_next);
+					TestTrue("", domain.IsInScope());
+				}
+				TestTrue("", domain.IsInScope());
+				root.m_hazard_next.Store(nullptr);
+				domain.Retire(nodes[0]);
+				domain.Retire(nodes[1]);
+				domain.Retire(nodes[2]);
+				TestEqual("", domain.Reclaim(), 2);
+				TestEqual("", next.Get()->m_value, 1);
+			}
+			TestFalse("", domain.IsInScope());
+			TestEqual("", domain.Reclaim(), 1);
+			TestEqual("", num_destroyed.load(), 3);
+		});
+	});
+	Describe("Snapshot", [this]()
+	{
+		It("should copy registered fields of objects reachable from the roots", [this]()
+		{
+			MockHealthComponent health_component;
+			MockPawn pawn;
+			pawn.m_health_component = &health_component;
+			MockPlayerController controllers[2];
+			controllers[0].m_pawn = &pawn;
+			controllers[1].m_pawn = &pawn;
+			MockWorld worlds[2];
+			worlds[0].m_first_player_controller = &controllers[0];
+			worlds[0].m_num_players = 2;
+			worlds[1].m_first_player_controller = &controllers[1];
+			FOptionalPtrSnapshotSchema schema;
+			schema.Add(&MockWorld::GetFirstPlayerController)
+				.Add(&MockWorld::m_num_players)
+				.Add(&MockPlayerController::m_pawn)
+				.Add(&MockPawn::GetHealthComponent)
+				.Add(&MockHealthComponent::m_health);
+			const TUniquePtr<FOptionalPtrSnapshot> snapshot = schema.Build(TArray<MockWorld*>{&worlds[0], nullptr, &worlds[1]});
+
+			health_component.m_health = 0.f;
+			worlds[0].m_num_players = 0;
+			controllers[1].m_pawn = nullptr;
+			TestEqual("", snapshot->NumRoots(), 3);
+			TestEqual("", snapshot->NumObjects(), 6);
+			const TOptionalPtrSnapshotPtr<MockWorld> world = snapshot->GetRoot<MockWorld>(0);
+			TestEqual("", world.GetSourceId(), static_cast<const void*>(&worlds[0]));
+			TestEqual("", world.MapToValue(0, &MockWorld::m_num_players), 2);
+			TestEqual("", world
+				.Map(&MockWorld::GetFirstPlayerController)
+				.Map(&MockPlayerController::m_pawn)
+				.Map(&MockPawn::GetHealthComponent)
+				.MapToValue(0.f, &MockHealthComponent::m_health), 100.f);
+			TestEqual("", snapshot->GetRoot<MockWorld>(2)
+				.Map(&MockWorld::GetFirstPlayerController)
+				.Map(&MockPlayerController::m_pawn)
+				.GetSourceId(), static_cast<const void*>(&pawn));
+			TestFalse("", snapshot->GetRoot<MockWorld>(1).IsSet());
+			TestEqual("", snapshot->GetRoot<MockWorld>(1).MapToValue(-1, &MockWorld::m_num_players), -1);
+		});
+		It("should not copy objects which are not valid", [this]()
+		{
+			CreateOuterChain();
+			m_outer_chain[2]->MarkPendingKill();
+			FOptionalPtrSnapshotSchema schema;
+			schema.Add(&UObject::GetOuter);
+			const TUniquePtr<FOptionalPtrSnapshot> snapshot = schema.Build(TArray<UObject*>{m_outer_chain[3]});
+
+			TestEqual("", snapshot->NumObjects(), 1);
+			TestTrue("", snapshot->GetRoot<UObject>(0).IsSet());
+			TestFalse("", snapshot->GetRoot<UObject>(0).Map(&UObject::GetOuter).IsSet());
+
+			for (const auto obj : m_outer_chain)
+			{
+				obj->Destroy();
+			}
+			m_outer_chain.Reset();
+		});
+		It("should keep acquired snapshot until the guard ends", [this]()
+		{
+			MockWorld world;
+			FOptionalPtrSnapshotSchema schema;
+			schema.Add(&MockWorld::m_num_players);
+			FOptionalPtrSnapshotPublisher publisher;
+			{
+				FOptionalPtrEpochGuard guard;
+				TestNull("", publisher.Acquire());
+			}
+			publisher.Publish(schema.Build(TArray<MockWorld*>{&world}));
+
+			FOptionalPtrEpochGuard guard;
+			const FOptionalPtrSnapshot* const acquired = publisher.Acquire();
+			world.m_num_players = 2;
+			publisher.Publish(schema.Build(TArray<MockWorld*>{&world}));
+			TestEqual("", acquired->GetRoot<MockWorld>(0).MapToValue(0, &MockWorld::m_num_players), 1);
+			TestEqual("", publisher.Acquire()->GetRoot<MockWorld>(0).MapToValue(0, &MockWorld::m_num_players), 2);
+		});
+		It("should publish consistent snapshots to other threads", [this]()
+		{
+			const int32 num_threads = 4;
+			const int32 num_frames = 500;
+			MockHealthComponent health_component;
+			MockPawn pawn;
+			pawn.m_health_component = &health_component;
+			MockPlayerController controller;
+			controller.m_pawn = &pawn;
+			MockWorld world;
+			world.m_first_player_controller = &controller;
+			FOptionalPtrSnapshotSchema schema;
+			schema.Add(&MockWorld::GetFirstPlayerController)
+				.Add(&MockWorld::m_num_players)
+				.Add(&MockPlayerController::m_pawn)
+				.Add(&MockPawn::GetHealthComponent)
+				.Add(&MockHealthComponent::m_health);
+			FOptionalPtrSnapshotPublisher publisher;
+			publisher.Publish(schema.Build(TArray<MockWorld*>{&world}));
+			std::atomic<bool> finished{false};
+			std::atomic<int32> num_inconsistent_reads{0};
+			ParallelFor(num_threads, [&](int32 thread)
+			{
+				if (thread == 0)
+				{
+					//each frame changes the live objects and publishes their snapshot
+					for (int32 frame = 1; frame <= num_frames; ++frame)
+					{
+						world.m_num_players = frame;
+						health_component.m_health = static_cast<float>(frame);
+						publisher.Publish(schema.Build(TArray<MockWorld*>{&world}));
+					}
+					finished = true;
+					return;
+				}
+				while (!finished)
+				{
+					FOptionalPtrEpochGuard guard;
+					const TOptionalPtrSnapshotPtr<MockWorld> root = publisher.Acquire()->GetRoot<MockWorld>(0);
+					const int32 num_players = root.MapToValue(0, &MockWorld::m_num_players);
+					const float health = root
+						.Map(&MockWorld::GetFirstPlayerController)
+						.Map(&MockPlayerController::m_pawn)
+						.Map(&MockPawn::GetHealthComponent)
+						.MapToValue(0.f, &MockHealthComponent::m_health);
+					num_inconsistent_reads += num_players != 1 && health != static_cast<float>(num_players);
+				}
+			});
+
+			TestEqual("", num_inconsistent_reads.load(), 0);
+		});
+	});
+	Describe("MapAtomic", [this]()
+	{
+		It("should map through atomic pointer fields", [this]()
+		{
+			MockAtomicNode nodes[3];
+			nodes[0].m_next = &nodes[1];
+			nodes[0].m_unreal_next = &nodes[1];
+			nodes[1].m_next = &nodes[2];
+			nodes[1].m_unreal_next = &nodes[2];
+			TestEqual("", TOptionalPtr<MockAtomicNode>(&nodes[0]).Map(&MockAtomicNode::m_next).Map(&MockAtomicNode::m_next).Get(), &nodes[2]);
+			TestEqual("", TOptionalPtr<MockAtomicNode>(&nodes[0]).MapAcquire(&MockAtomicNode::m_next).MapRelaxed(&MockAtomicNode::m_next).Get(), &nodes[2]);
+			TestEqual("", TOptionalPtr<MockAtomicNode>(&nodes[0]).MapConsume(&MockAtomicNode::m_next).MapAcquire(&MockAtomicNode::m_next).Get(), &nodes[2]);
+			TestEqual("", TOptionalPtr<MockAtomicNode>(&nodes[0]).Map(&MockAtomicNode::m_unreal_next).MapRelaxed(&MockAtomicNode::m_unreal_next).Get(), &nodes[2]);
+			TestEqual("", TOptionalPtr<const MockAtomicNode>(&nodes[0]).MapConsume(&MockAtomicNode::m_unreal_next).MapAcquire(&MockAtomicNode::m_next).Get(), &nodes[2]);
+			TestFalse("", TOptionalPtr<MockAtomicNode>(&nodes[1]).MapAcquire(&MockAtomicNode::m_next).MapAcquire(&MockAtomicNode::m_next).IsSet());
+			TestEqual("", TOptionalPtr<MockAtomicNode, TOptionalPtrStepPolicy<>>(&nodes[2]).MapRelaxed(&MockAtomicNode::m_next).GetResult().GetFailedStep(), 1);
+		});
+		It("should see fields written before the pointer was published", [this]()
+		{
+			const int32 num_threads = 4;
+			const int32 num_nodes = 20000;
+			TUniquePtr<MockAtomicNode[]> nodes{new MockAtomicNode[num_nodes]};
+			MockAtomicNode root;
+			std::atomic<int32> num_started{0};
+			std::atomic<bool> published{false};
+			std::atomic<int32> num_reads{0};
+			std::atomic<int32> num_stale_reads{0};
+			ParallelFor(num_threads, [&](int32 thread)
+			{
+				if (thread == 0)
+				{
+					while (num_started < num_threads - 1)
+					{
+						FPlatformProcess::Yield();
+					}
+					for (int32 i = 0; i < num_nodes; ++i)
+					{
+						nodes[i].m_value = i + 1;
+						root.m_next.store(&nodes[i], std::memory_order_release);
+						root.m_unreal_next = &nodes[i];
+					}
+					published = true;
+					return;
+				}
+
+				int32 thread_reads = 0;
+				int32 thread_stale_reads = 0;
+				auto read = [&](MockAtomicNode* node)
+				{
+					if (node != nullptr)
+					{
+						++thread_reads;
+						thread_stale_reads += node->m_value != static_cast<int32>(node - nodes.Get()) + 1;
+					}
+				};
+				++num_started;
+				do
+				{
+					read(TOptionalPtr<MockAtomicNode>(&root).Map(&MockAtomicNode::m_next).Get());
+					read(TOptionalPtr<MockAtomicNode>(&root).MapAcquire(&MockAtomicNode::m_next).Get());
+					read(TOptionalPtr<MockAtomicNode>(&root).MapConsume(&MockAtomicNode::m_next).Get());
+					read(TOptionalPtr<MockAtomicNode>(&root).MapAcquire(&MockAtomicNode::m_unreal_next).Get());
+				}
+				while (!published);
+				num_reads += thread_reads;
+				num_stale_reads += thread_stale_reads;
+			});
+
+			TestTrue("", num_reads.load() > 0);
+			TestEqual("", num_stale_reads.load(), 0);
+		});
+	});
+	Describe("MapSnapshot", [this]()
+	{
+		It("should read the fields of valid object", [this]()
+		{
+			MockKinematicObject root;
+			MockKinematicObject object;
+			root.m_next = &object;
+			object.Write(3);
+			const auto values = TOptionalPtr<MockKinematicObject>(&root)
+				.Map(&MockKinematicObject::m_next)
+				.MapSnapshot(&MockKinematicObject::m_seq_lock, &MockKinematicObject::m_position, &MockKinematicObject::m_timestamp);
+			TestTrue("", values.IsSet());
+			TestEqual("", std::get<0>(*values), 3.0);
+			TestEqual("", std::get<1>(*values), static_cast<int64>(3));
+			TestEqual("", object.m_seq_lock.GetSequence(), static_cast<uint32>(2));
+			TestFalse("", TOptionalPtr<MockKinematicObject>(&object)
+				.Map(&MockKinematicObject::m_next)
+				.MapSnapshot(&MockKinematicObject::m_seq_lock, &MockKinematicObject::m_velocity).IsSet());
+		});
+		It("should not read fields torn by other thread", [this]()
+		{
+			const int32 num_threads = 4;
+			const int64 num_writes = 20000;
+			MockKinematicObject object;
+			std::atomic<int32> num_started{0};
+			std::atomic<bool> written{false};
+			std::atomic<int32> num_reads{0};
+			std::atomic<int32> num_torn_reads{0};
+			ParallelFor(num_threads, [&](int32 thread)
+			{
+				if (thread == 0)
+				{
+					while (num_started < num_threads - 1)
+					{
+						FPlatformProcess::Yield();
+					}
+					for (int64 timestamp = 1; timestamp <= num_writes; ++timestamp)
+					{
+						object.Write(timestamp);
+					}
+					written = true;
+					return;
+				}
+
+				++num_started;
+				int32 thread_reads = 0;
+				int32 thread_torn_reads = 0;
+				do
+				{
+					const auto values = TOptionalPtr<MockKinematicObject>(&object).MapSnapshot(&MockKinematicObject::m_seq_lock,
+						&MockKinematicObject::m_position, &MockKinematicObject::m_velocity, &MockKinematicObject::m_timestamp);
+					++thread_reads;
+					const double timestamp = static_cast<double>(std::get<2>(*values));
+					thread_torn_reads += std::get<0>(*values) != timestamp || std::get<1>(*values) != timestamp;
+				}
+				while (!written);
+				num_reads += thread_reads;
+				num_torn_reads += thread_torn_reads;
+			});
+
+			TestTrue("", num_reads.load() > 0);
+			TestEqual("", num_torn_reads.load(), 0);
+		});
+	});
+	Describe("MockArena", [this]()
+	{
+		It("should allocate objects from multiple threads", [this]()
+		{
+			const int32 num_threads = 8;
+			const int32 num_allocations = 1000;
+			MockNonUObject object;
+			TArray<SimpleObject*> allocated[num_threads];
+			ParallelFor(num_threads, [&](int32 thread)
+			{
+				for (int32 i = 0; i < num_allocations; ++i)
+				{
+					allocated[thread].Add(i % 2 ? object.Method() : object.MethodConst());
+				}
+			});
+
+			TSet<SimpleObject*> unique;
+			bool correct = true;
+			for (const TArray<SimpleObject*>& thread_allocated : allocated)
+			{
+				for (int32 i = 0; i < thread_allocated.Num(); ++i)
+				{
+					unique.Add(thread_allocated[i]);
+					correct &= thread_allocated[i]->func_name == (i % 2 ? MethodEnum::Method : MethodEnum::MethodConst);
+				}
+			}
+			TestTrue("", correct);
+			TestEqual("", unique.Num(), num_threads * num_allocations);
+		});
+	});
+#if OPTIONAL_PTR_STATS
+	Describe("Stats", [this]()
+	{
+		It("should count evaluations, steps and failures of the call site", [this]()
+		{
+			MockLinkNode nodes[3];
+			nodes[0].m_next = &nodes[1];
+			nodes[1].m_next = &nodes[2];
+			nodes[2].m_value = 5;
+			const FOptionalPtrSiteStats before = FindStatsSite(m_stats_chain_line);
+			TestEqual("", StatsChainValue(&nodes[0]), 5);
+			TestEqual("", StatsChainValue(&nodes[1]), -1);
+			TestEqual("", StatsChainValue(nullptr), -1);
+			const FOptionalPtrSiteStats after = FindStatsSite(m_stats_chain_line);
+
+			TestEqual("", after.NumEvaluations - before.NumEvaluations, static_cast<uint64>(3));
+			TestEqual("", after.NumSteps - before.NumSteps, static_cast<uint64>(4));
+			TestEqual("", after.NumFailures - before.NumFailures, static_cast<uint64>(2));
+			TestEqual("", after.FailuresAtDepth[0] - before.FailuresAtDepth[0], static_cast<uint64>(1));
+			TestEqual("", after.FailuresAtDepth[1] - before.FailuresAtDepth[1], static_cast<uint64>(0));
+			TestEqual("", after.FailuresAtDepth[2] - before.FailuresAtDepth[2], static_cast<uint64>(1));
+		});
+		It("should count failures of chains ending in Get or GetOrElse", [this]()
+		{
+			MockLinkNode nodes[2];
+			nodes[0].m_next = &nodes[1];
+			const FOptionalPtrSiteStats get_before = FindStatsSite(m_stats_get_line);
+			const FOptionalPtrSiteStats get_or_else_before = FindStatsSite(m_stats_get_or_else_line);
+			TestEqual("", StatsChainGet(&nodes[0]), &nodes[1]);
+			TestNull("", StatsChainGet(&nodes[1]));
+			TestEqual("", StatsChainGetOrElse(&nodes[1], &nodes[0]), &nodes[0]);
+			const FOptionalPtrSiteStats get_after = FindStatsSite(m_stats_get_line);
+			const FOptionalPtrSiteStats get_or_else_after = FindStatsSite(m_stats_get_or_else_line);
+
+			TestEqual("", get_after.NumEvaluations - get_before.NumEvaluations, static_cast<uint64>(2));
+			TestEqual("", get_after.NumFailures - get_before.NumFailures, static_cast<uint64>(1));
+			TestEqual("", get_after.FailuresAtDepth[1] - get_before.FailuresAtDepth[1], static_cast<uint64>(1));
+			TestEqual("", get_or_else_after.NumFailures - get_or_else_before.NumFailures, static_cast<uint64>(1));
+			TestEqual("", get_or_else_after.FailuresAtDepth[1] - get_or_else_before.FailuresAtDepth[1], static_cast<uint64>(1));
+		});
+		It("should not count chains started by the helpers as call sites", [this]()
+		{
+			CreateOuterChain();
+			TOptionalPtr<UMockUObject>(m_outer_chain[3]).FindAncestor<UMockAncestorUObject>();
+			auto binding = MakeOptionalPtrBinding(m_outer_chain[3], &UObject::GetOuter, &UObject::GetOuter);
+			binding.Update();
+			binding.Get().IsSet();
+			const auto chain = TOptionalPtrChainBuilder<UMockUObject>()
+				.Map(&UObject::GetOuter)
+				.Build();
+			chain.Execute(m_outer_chain[3]).IsSet();
+
+			bool only_spec_sites = true;
+			for (const FOptionalPtrSiteStats& site : FOptionalPtrStats::Collect())
+			{
+				only_spec_sites &= FCStringAnsi::Strcmp(site.File, __FILE__) == 0;
+			}
+			TestTrue("", only_spec_sites);
+
+			for (const auto obj : m_outer_chain)
+			{
+				obj->Destroy();
+			}
+			m_outer_chain.Reset();
+		});
+		It("should merge counters of multiple threads", [this]()
+		{
+			const int32 num_threads = 8;
+			const int32 num_chains = 1000;
+			MockLinkNode node;
+			const FOptionalPtrSiteStats before = FindStatsSite(m_stats_chain_line);
+			ParallelFor(num_threads, [&](int32)
+			{
+				for (int32 i = 0; i < num_chains; ++i)
+				{
+					StatsChainValue(&node);
+				}
+			});
+			const FOptionalPtrSiteStats after = FindStatsSite(m_stats_chain_line);
+
+			TestEqual("", after.NumEvaluations - before.NumEvaluations, static_cast<uint64>(num_threads * num_chains));
+			TestEqual("", after.FailuresAtDepth[1] - before.FailuresAtDepth[1], static_cast<uint64>(num_threads * num_chains));
+		});
+		It("should sort sites by failure rate and by total cost", [this]()
+		{
+			MockLinkNode node;
+			StatsChainValue(&node);
+			TOptionalPtr<MockLinkNode>(&node).Map(&MockLinkNode::m_next).IsSet();
+
+			const TArray<FOptionalPtrSiteStats> by_failure_rate = FOptionalPtrStats::Collect(EOptionalPtrStatsSort::FailureRate);
+			const TArray<FOptionalPtrSiteStats> by_total_cost = FOptionalPtrStats::Collect(EOptionalPtrStatsSort::TotalCost);
+			bool sorted = by_failure_rate.Num() >= 2 && by_failure_rate.Num() == by_total_cost.Num();
+			for (int32 i = 1; i < by_failure_rate.Num(); ++i)
+			{
+				sorted &= by_failure_rate[i - 1].GetFailureRate() >= by_failure_rate[i].GetFailureRate();
+				sorted &= by_total_cost[i - 1].NumSteps >= by_total_cost[i].NumSteps;
+			}
+			TestTrue("", sorted);
+			const FString dump = FOptionalPtrStats::Dump(EOptionalPtrStatsSort::FailureRate, by_failure_rate.Num());
+			TestTrue("", dump.Contains(FString::Printf(TEXT(":%u "), m_stats_chain_line)));
+		});
+	});
+#endif
+}
+
+BEGIN_DEFINE_SPEC(FOptionalPtrPerformanceSpec, "OptionalPtr.Performance", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+
+//https://stackoverflow.com/a/33900479
+typedef std::chrono::high_resolution_clock::time_point TimeVar;
+
+template<typename MockType, typename = std::enable_if_t<std::is_base_of<UObject, MockType>::value>>
+MockType* GetObject()
+{
+	return NewObject<MockType>();
+}
+
+template<typename MockType, typename = std::enable_if_t<!std::is_base_of<UObject, MockType>::value>>
+MockType* GetObject(bool dont_set = false)
+{
+	return new MockType();
+}
+
+template<typename MockType, typename F>
+double GetExecutionTime(uint32 reps, F func){
+	using namespace std::chrono;
+
+	MockType* obj1 = GetObject<MockType>();
+	MockType* obj2 = GetObject<MockType>();
+
+	const TimeVar time_now = high_resolution_clock::now();
+	for (uint32 i = 0; i < reps; ++i)
+	{
+		//has to be member function template, specialized static function template won't compile on PS4 
+		(this->*func)(obj1, obj2);
+	}
+	const auto exec_time = duration_cast<nanoseconds>(high_resolution_clock::now() - time_now).count();
+	
+	obj1->Destroy();
+	obj2->Destroy();
+	
+	return exec_time;
+}
+//END
+
+template<typename F>
+double MeasureExecutionTime(uint32 reps, F&& func)
+{
+	using namespace std::chrono;
+
+	const TimeVar time_now = high_resolution_clock::now();
+	for (uint32 i = 0; i < reps; ++i)
+	{
+		func();
+	}
+	return duration_cast<nanoseconds>(high_resolution_clock::now() - time_now).count();
+}
+
+template<uint8 NumOfCalls>
+UMockUObject* RegularFlowUObject(UMockUObject* obj1, UMockUObject* obj2);
+
+template<>
+UMockUObject* RegularFlowUObject<1>(UMockUObject* obj1, UMockUObject* obj2)
+{
+	UMockUObject* obj = obj1;
+	UMockUObject* result = nullptr;
+
+	if (IsValid(obj))
+		result = obj->GetRandomObject(obj1, obj2);
+
+	return result;
+}
+
+template<>
+UMockUObject* RegularFlowUObject<2>(UMockUObject* obj1, UMockUObject* obj2)
+{
+	UMockUObject* obj = obj1;
+	UMockUObject* result = nullptr;
+
+	if (!IsValid(obj))
+		return nullptr;
+		
+	auto result1 = obj->GetRandomObject(obj1, obj2);
+	if (!IsValid(result1))
+		return nullptr;
+		
+	result = result1->GetRandomObject(obj1, obj2);
+
+	return result;
+}
+
+template<>
+UMockUObject* RegularFlowUObject<3>(UMockUObject* obj1, UMockUObject* obj2)
+{
+	UMockUObject* obj = obj1;
+	UMockUObject* result = nullptr;
+
+	if (!IsValid(obj))
+		return nullptr;
+		
+	auto result1 = obj->GetRandomObject(obj1, obj2);
+	if (!IsValid(result1))
+		return nullptr;
+		
+	auto result2 = result1->GetRandomObject(obj1, obj2);
+	if (!IsValid(result2))
+		return nullptr;
+
+	result = result2->GetRandomObject(obj1, obj2);
+
+	return result;
+}
+
+template<>
+UMockUObject* RegularFlowUObject<4>(UMockUObject* obj1, UMockUObject* obj2)
+{
+	UMockUObject* obj = obj1;
+	UMockUObject* result = nullptr;
+
+	if (!IsValid(obj))
+		return nullptr;
+	
+	auto result1 = obj->GetRandomObject(obj1, obj2);
+	if (!IsValid(result1))
+		return nullptr;
+	
+	auto result2 = result1->GetRandomObject(obj1, obj2);
+	if (!IsValid(result2))
+		return nullptr;
+
+	auto result3 = result2->GetRandomObject(obj1, obj2);
+	if (!IsValid(result3))
+		return nullptr;
+	
+	result = result3->GetRandomObject(obj1, obj2);
+
+	return result;
+}
+
+template<uint8 NumOfCalls>
+MockNonUObject* RegularFlowNonUObject(MockNonUObject* obj1, MockNonUObject* obj2);
+
+template<>
+MockNonUObject* RegularFlowNonUObject<1>(MockNonUObject* obj1, MockNonUObject* obj2)
+{
+	MockNonUObject* obj = obj1;
+	MockNonUObject* result = nullptr;
+
+	if (obj != nullptr)
+		result = obj->GetRandomObject(obj1, obj2);
+
+	return result;
+}
+
+template<>
+MockNonUObject* RegularFlowNonUObject<2>(MockNonUObject* obj1, MockNonUObject* obj2)
+{
+	MockNonUObject* obj = obj1;
+
+	if (obj == nullptr)
+		return nullptr;
+		
+	auto result1 = obj->GetRandomObject(obj1, obj2);
+	if (result1 == nullptr)
+		return nullptr;
+		
+	return result1->GetRandomObject(obj1, obj2);
+}
+
+template<>
+MockNonUObject* RegularFlowNonUObject<3>(MockNonUObject* obj1, MockNonUObject* obj2)
+{
+	MockNonUObject* obj = obj1;
+
+	if (obj == nullptr)
+		return nullptr;
+		
+	auto result1 = obj->GetRandomObject(obj1, obj2);
+	if (result1 == nullptr)
+		return nullptr;
+	
+	auto result2 = obj->GetRandomObject(obj1, obj2);
+	if (result2 == nullptr)
+		return nullptr;
+		
+	return result2->GetRandomObject(obj1, obj2);
+}
+
+template<>
+MockNonUObject* RegularFlowNonUObject<4>(MockNonUObject* obj1, MockNonUObject* obj2)
+{
+	MockNonUObject* obj = obj1;
+
+	if (obj == nullptr)
+		return nullptr;
+		
+	auto result1 = obj->GetRandomObject(obj1, obj2);
+	if (result1 == nullptr)
+		return nullptr;
+	
+	auto result2 = obj->GetRandomObject(obj1, obj2);
+	if (result2 == nullptr)
+		return nullptr;
+	
+	auto result3 = obj->GetRandomObject(obj1, obj2);
+	if (result3 == nullptr)
+		return nullptr;
+		
+	return result3->GetRandomObject(obj1, obj2);
+}
+
+template<uint8 NumOfCalls>
+UMockUObject* MapFlowUObject(UMockUObject* obj1, UMockUObject* obj2);
+
+template<>
+UMockUObject* MapFlowUObject<1>(UMockUObject* obj1, UMockUObject* obj2)
+{
+	return TOptionalPtr<UMockUObject>(obj1).Map(&UMockUObject::GetRandomObject, obj1, obj2).Get();
+}
+
+template<>
+UMockUObject* MapFlowUObject<2>(UMockUObject* obj1, UMockUObject* obj2)
+{
+	return TOptionalPtr<UMockUObject>(obj1)
+		.Map(&UMockUObject::GetRandomObject, obj1, obj2)
+		.Map(&UMockUObject::GetRandomObject, obj1, obj2).Get();
+}
+
+template<>
+UMockUObject* MapFlowUObject<3>(UMockUObject* obj1, UMockUObject* obj2)
+{
+	return TOptionalPtr<UMockUObject>(obj1)
+		.Map(&UMockUObject::GetRandomObject, obj1, obj2)
+		.Map(&UMockUObject::GetRandomObject, obj1, obj2)
+		.Map(&UMockUObject::GetRandomObject, obj1, obj2).Get();
+}
+
+template<>
+UMockUObject* MapFlowUObject<4>(UMockUObject* obj1, UMockUObject* obj2)
+{
+	return TOptionalPtr<UMockUObject>(obj1)
+		.Map(&UMockUObject::GetRandomObject, obj1, obj2)
+		.Map(&UMockUObject::GetRandomObject, obj1, obj2)
+		.Map(&UMockUObject::GetRandomObject, obj1, obj2)
+		.Map(&UMockUObject::GetRandomObject, obj1, obj2).Get();
+}
+
+template<uint8 NumOfCalls>
+MockNonUObject* MapFlowNonUObject(MockNonUObject* obj1, MockNonUObject* obj2);
+
+template<>
+MockNonUObject* MapFlowNonUObject<1>(MockNonUObject* obj1, MockNonUObject* obj2)
+{
+	return TOptionalPtr<MockNonUObject>(obj1).Map(&MockNonUObject::GetRandomObject, obj1, obj2).Get();
+}
+
+template<>
+MockNonUObject* MapFlowNonUObject<2>(MockNonUObject* obj1, MockNonUObject* obj2)
+{
+	return TOptionalPtr<MockNonUObject>(obj1)
+		.Map(&MockNonUObject::GetRandomObject, obj1, obj2)
+		.Map(&MockNonUObject::GetRandomObject, obj1, obj2).Get();
+}
+
+template<>
+MockNonUObject* MapFlowNonUObject<3>(MockNonUObject* obj1, MockNonUObject* obj2)
+{
+	return TOptionalPtr<MockNonUObject>(obj1)
+		.Map(&MockNonUObject::GetRandomObject, obj1, obj2)
+		.Map(&MockNonUObject::GetRandomObject, obj1, obj2)
+		.Map(&MockNonUObject::GetRandomObject, obj1, obj2).Get();
+}
+
+template<>
+MockNonUObject* MapFlowNonUObject<4>(MockNonUObject* obj1, MockNonUObject* obj2)
+{
+	return TOptionalPtr<MockNonUObject>(obj1)
+		.Map(&MockNonUObject::GetRandomObject, obj1, obj2)
+		.Map(&MockNonUObject::GetRandomObject, obj1, obj2)
+		.Map(&MockNonUObject::GetRandomObject, obj1, obj2)
+		.Map(&MockNonUObject::GetRandomObject, obj1, obj2).Get();
+}
+
+template<uint8 NumOfCalls>
+UMockUObject* TryFlowUObject(UMockUObject* obj1, UMockUObject* obj2);
+
+template<>
+UMockUObject* TryFlowUObject<1>(UMockUObject* obj1, UMockUObject* obj2)
+{
+	OPT_TRY(obj, obj1);
+	return obj->GetRandomObject(obj1, obj2);
+}
+
+template<>
+UMockUObject* TryFlowUObject<2>(UMockUObject* obj1, UMockUObject* obj2)
+{
+	OPT_TRY(obj, obj1);
+	OPT_TRY(result1, obj->GetRandomObject(obj1, obj2));
+	return result1->GetRandomObject(obj1, obj2);
+}
+
+template<>
+UMockUObject* TryFlowUObject<3>(UMockUObject* obj1, UMockUObject* obj2)
+{
+	OPT_TRY(obj, obj1);
+	OPT_TRY(result1, obj->GetRandomObject(obj1, obj2));
+	OPT_TRY(result2, result1->GetRandomObject(obj1, obj2));
+	return result2->GetRandomObject(obj1, obj2);
+}
+
+template<>
+UMockUObject* TryFlowUObject<4>(UMockUObject* obj1, UMockUObject* obj2)
+{
+	OPT_TRY(obj, obj1);
+	OPT_TRY(result1, obj->GetRandomObject(obj1, obj2));
+	OPT_TRY(result2, result1->GetRandomObject(obj1, obj2));
+	OPT_TRY(result3, result2->GetRandomObject(obj1, obj2));
+	return result3->GetRandomObject(obj1, obj2);
+}
+
+template<uint8 NumOfCalls>
+MockNonUObject* TryFlowNonUObject(MockNonUObject* obj1, MockNonUObject* obj2);
+
+template<>
+MockNonUObject* TryFlowNonUObject<1>(MockNonUObject* obj1, MockNonUObject* obj2)
+{
+	OPT_TRY(obj, obj1);
+	return obj->GetRandomObject(obj1, obj2);
+}
+
+template<>
+MockNonUObject* TryFlowNonUObject<2>(MockNonUObject* obj1, MockNonUObject* obj2)
+{
+	OPT_TRY(obj, obj1);
+	OPT_TRY(result1, obj->GetRandomObject(obj1, obj2));
+	return result1->GetRandomObject(obj1, obj2);
+}
+
+template<>
+MockNonUObject* TryFlowNonUObject<3>(MockNonUObject* obj1, MockNonUObject* obj2)
+{
+	OPT_TRY(obj, obj1);
+	OPT_TRY(result1, obj->GetRandomObject(obj1, obj2));
+	OPT_TRY(result2, result1->GetRandomObject(obj1, obj2));
+	return result2->GetRandomObject(obj1, obj2);
+}
+
+template<>
+MockNonUObject* TryFlowNonUObject<4>(MockNonUObject* obj1, MockNonUObject* obj2)
+{
+	OPT_TRY(obj, obj1);
+	OPT_TRY(result1, obj->GetRandomObject(obj1, obj2));
+	OPT_TRY(result2, result1->GetRandomObject(obj1, obj2));
+	OPT_TRY(result3, result2->GetRandomObject(obj1, obj2));
+	return result3->GetRandomObject(obj1, obj2);
+}
+
+const static uint32 num_of_repetitions = 100000;
+
+template<uint8 NumOfCalls, bool IsUObject, typename MockType, typename = std::enable_if_t<IsUObject>>
+double GetExecTimeInternal()
+{
+	return GetExecutionTime<MockType>(num_of_repetitions, &FOptionalPtrPerformanceSpec::RegularFlowUObject<NumOfCalls>);
+}
+
+template<uint8 NumOfCalls, bool IsUObject, typename MockType, typename = std::enable_if_t<!IsUObject>>
+double GetExecTimeInternal(bool dont_set = false)
+{
+	return GetExecutionTime<MockType>(num_of_repetitions, &FOptionalPtrPerformanceSpec::RegularFlowNonUObject<NumOfCalls>);
+}
+
+template<uint8 NumOfCalls, bool IsUObject = true, typename = std::enable_if_t<IsUObject>>
+void CompareExecutionTimes()
+{
+	const auto map_exec_time = GetExecutionTime<UMockUObject>(num_of_repetitions, &FOptionalPtrPerformanceSpec::MapFlowUObject<NumOfCalls>);
+	AddInfo(FString::Printf(TEXT("Execution time for Map approach: %f ns"), map_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for regular approach: %f ns"),
+		GetExecTimeInternal<NumOfCalls, IsUObject, UMockUObject>()));
+	AddInfo(FString::Printf(TEXT("Execution time for OPT_TRY approach: %f ns"),
+		GetExecutionTime<UMockUObject>(num_of_repetitions, &FOptionalPtrPerformanceSpec::TryFlowUObject<NumOfCalls>)));
+}
+
+template<uint8 NumOfCalls, bool IsUObject = true, typename = std::enable_if_t<!IsUObject>>
+void CompareExecutionTimes(bool dont_set = false)
+{
+	const auto map_exec_time = GetExecutionTime<MockNonUObject>(num_of_repetitions, &FOptionalPtrPerformanceSpec::MapFlowNonUObject<NumOfCalls>);
+	AddInfo(FString::Printf(TEXT("Execution time for Map approach: %f ns"), map_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for regular approach: %f ns"),
+		GetExecTimeInternal<NumOfCalls, IsUObject, MockNonUObject>()));
+	AddInfo(FString::Printf(TEXT("Execution time for OPT_TRY approach: %f ns"),
+		GetExecutionTime<MockNonUObject>(num_of_repetitions, &FOptionalPtrPerformanceSpec::TryFlowNonUObject<NumOfCalls>)));
+}
+
+template<typename MockType>
+void CompareResultExecutionTimes()
+{
+	MockType* obj1 = GetObject<MockType>();
+	MockType* obj2 = GetObject<MockType>();
+	uint32 found = 0;
+
+	//the result of Get has to be validated by the caller the same way GetResult does
+	const auto get_exec_time = MeasureExecutionTime(num_of_repetitions, [&]()
+	{
+		MockType* const result = TOptionalPtr<MockType>(obj1)
+			.Map(&MockType::GetRandomObject, obj1, obj2)
+			.Map(&MockType::GetRandomObject, obj1, obj2)
+			.Map(&MockType::GetRandomObject, obj1, obj2)
+			.Map(&MockType::GetRandomObject, obj1, obj2).Get();
+		found += TOptionalPtr<MockType>(result).IsSet();
+	});
+	const auto result_exec_time = MeasureExecutionTime(num_of_repetitions, [&]()
+	{
+		found += TOptionalPtr<MockType, TOptionalPtrStepPolicy<>>(obj1)
+			.Map(&MockType::GetRandomObject, obj1, obj2)
+			.Map(&MockType::GetRandomObject, obj1, obj2)
+			.Map(&MockType::GetRandomObject, obj1, obj2)
+			.Map(&MockType::GetRandomObject, obj1, obj2).GetResult().IsSet();
+	});
+
+	TestEqual("", found, 2 * num_of_repetitions);
+	AddInfo(FString::Printf(TEXT("Execution time for Get approach: %f ns"), get_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for GetResult approach: %f ns"), result_exec_time));
+
+	obj1->Destroy();
+	obj2->Destroy();
+}
+
+const static int32 walk_chain_length = 10000;
+const static uint32 walk_repetitions = 1000;
+
+//nodes are linked in random order so each hop is likely a cache miss
+TArray<MockLinkNode*> CreateScatteredLinkChain(int32 length)
+{
+	TArray<MockLinkNode*> nodes;
+	for (int32 i = 0; i < length; ++i)
+	{
+		nodes.Add(new MockLinkNode(i));
+	}
+	for (int32 i = length - 1; i > 0; --i)
+	{
+		const int32 swap_index = FMath::RandRange(0, i);
+		std::swap(nodes[i], nodes[swap_index]);
+	}
+	for (int32 i = 0; i < length - 1; ++i)
+	{
+		nodes[i]->m_next = nodes[i + 1];
+	}
+	return nodes;
+}
+
+void CompareWalkExecutionTimes()
+{
+	const auto nodes = CreateScatteredLinkChain(walk_chain_length);
+	const int32 searched_value = nodes.Last()->m_value;
+	uint32 found = 0;
+
+	const auto walk_exec_time = MeasureExecutionTime(walk_repetitions, [&]()
+	{
+		found += TOptionalPtr<MockLinkNode>(nodes[0])
+			.Walk(&MockLinkNode::m_next, [searched_value](const MockLinkNode* node) { return node->HasValue(searched_value); }, walk_chain_length)
+			.IsSet();
+	});
+	const auto regular_exec_time = MeasureExecutionTime(walk_repetitions, [&]()
+	{
+		MockLinkNode* node = nodes[0];
+		for (int32 depth = 0; node != nullptr && depth <= walk_chain_length; ++depth, node = node->m_next)
+		{
+			if (node->HasValue(searched_value))
+				break;
+		}
+		found += node != nullptr;
+	});
+
+	TestEqual("", found, 2 * walk_repetitions);
+	AddInfo(FString::Printf(TEXT("Execution time for Walk approach: %f ns"), walk_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for regular approach: %f ns"), regular_exec_time));
+
+	for (const auto node : nodes)
+	{
+		delete node;
+	}
+}
+
+const static int32 deferred_calls = 100000;
+const static uint32 deferred_repetitions = 10;
+
+void CompareDeferredExecutionTimes()
+{
+	//nodes are visited in random order, so the immediate calls are likely cache misses
+	const auto nodes = CreateScatteredLinkChain(deferred_calls);
+	FOptionalPtrCommandBuffer buffer;
+
+	const auto immediate_exec_time = MeasureExecutionTime(deferred_repetitions, [&]()
+	{
+		for (const auto node : nodes)
+		{
+			TOptionalPtr<MockLinkNode>(node).IfPresent(&MockLinkNode::AddValue, 1);
+		}
+	});
+	const auto deferred_exec_time = MeasureExecutionTime(deferred_repetitions, [&]()
+	{
+		for (const auto node : nodes)
+		{
+			TOptionalPtr<MockLinkNode>(node).IfPresentDeferred(buffer, &MockLinkNode::AddValue, 1);
+		}
+		buffer.Flush();
+	});
+
+	int32 num_updated = 0;
+	for (const auto node : nodes)
+	{
+		num_updated += node->m_value >= static_cast<int32>(2 * deferred_repetitions);
+	}
+	TestEqual("", num_updated, deferred_calls);
+	AddInfo(FString::Printf(TEXT("Execution time for immediate approach: %f ns"), immediate_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for deferred approach: %f ns"), deferred_exec_time));
+
+	for (const auto node : nodes)
+	{
+		delete node;
+	}
+}
+
+const static int32 request_threads = 8;
+const static int32 requests_per_thread = 100000;
+const static int32 request_roots = 100;
+
+void CompareRequestQueueExecutionTimes()
+{
+	TArray<UMockUObject*> roots;
+	for (int32 i = 0; i < request_roots; ++i)
+	{
+		roots.Add(NewObject<UMockUObject>(NewObject<UMockUObject>()));
+	}
+	const auto chain = TOptionalPtrChainBuilder<UMockUObject>()
+		.Map(&UObject::GetOuter)
+		.Build();
+	const int32 num_requests = request_threads * requests_per_thread;
+	TOptionalPtrRequest<UObject>* requests = new TOptionalPtrRequest<UObject>[num_requests];
+	UObject** results = new UObject*[num_requests];
+
+	//each request allocates a task and takes a lock, the same way AsyncTask to the game thread does
+	FCriticalSection tasks_lock;
+	TArray<TUniqueFunction<void()>> tasks;
+	const auto task_exec_time = MeasureExecutionTime(1, [&]()
+	{
+		ParallelFor(request_threads, [&](int32 thread)
+		{
+			for (int32 i = 0; i < requests_per_thread; ++i)
+			{
+				UMockUObject* const root = roots[i % request_roots];
+				UObject** const result = &results[thread * requests_per_thread + i];
+				FScopeLock lock(&tasks_lock);
+				tasks.Add([&chain, root, result]() { *result = chain.Execute(root).Get(); });
+			}
+		});
+		for (auto& task : tasks)
+		{
+			task();
+		}
+	});
+	const auto queue_exec_time = MeasureExecutionTime(1, [&]()
+	{
+		FOptionalPtrRequestQueue queue;
+		ParallelFor(request_threads, [&](int32 thread)
+		{
+			for (int32 i = 0; i < requests_per_thread; ++i)
+			{
+				queue.Enqueue(chain, roots[i % request_roots], requests[thread * requests_per_thread + i]);
+			}
+		});
+		queue.Drain();
+	});
+
+	int32 num_correct = 0;
+	for (int32 i = 0; i < num_requests; ++i)
+	{
+		num_correct += results[i] == requests[i].Get().Get();
+	}
+	TestEqual("", num_correct, num_requests);
+	AddInfo(FString::Printf(TEXT("Execution time for task per request approach: %f ns"), task_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for request queue approach: %f ns"), queue_exec_time));
+
+	delete[] requests;
+	delete[] results;
+	for (const auto root : roots)
+	{
+		root->GetOuter()->ConditionalBeginDestroy();
+		root->Destroy();
+	}
+}
+
+const static int32 parallel_max_objects = 100000;
+const static int32 parallel_owners = 1000;
+
+void CompareParallelExecutionTimes(int32 num_objects)
+{
+	MockLinkNode* owners = new MockLinkNode[parallel_owners];
+	MockLinkNode* nodes = new MockLinkNode[num_objects];
+	TArray<MockLinkNode*> objects;
+	for (int32 i = 0; i < num_objects; ++i)
+	{
+		nodes[i].m_next = &owners[i % parallel_owners];
+		objects.Add(&nodes[i]);
+	}
+	const auto owner_key = [](MockLinkNode* node) { return node->GetNext(); };
+
+	const auto serial_exec_time = MeasureExecutionTime(10, [&]()
+	{
+		for (MockLinkNode* node : objects)
+		{
+			TOptionalPtr<MockLinkNode>(node).IfPresent(&MockLinkNode::LogValueToNext);
+		}
+	});
+	const auto any_exec_time = MeasureExecutionTime(10, [&]()
+	{
+		IfPresentAll(objects, owner_key, EOptionalPtrParallelOrder::Any, &MockLinkNode::LogValueToNext);
+	});
+	const auto deterministic_exec_time = MeasureExecutionTime(10, [&]()
+	{
+		IfPresentAll(objects, owner_key, EOptionalPtrParallelOrder::Deterministic, &MockLinkNode::LogValueToNext);
+	});
+
+	int32 num_logged = 0;
+	for (int32 i = 0; i < parallel_owners; ++i)
+	{
+		num_logged += owners[i].m_log.Num();
+	}
+	TestEqual("", num_logged, num_objects * 30);
+	AddInfo(FString::Printf(TEXT("Execution time for serial IfPresent approach with %d objects: %f ns"), num_objects, serial_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for IfPresentAll approach with %d objects: %f ns"), num_objects, any_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for deterministic IfPresentAll approach with %d objects: %f ns"), num_objects, deterministic_exec_time));
+
+	delete[] owners;
+	delete[] nodes;
+}
+
+const static int32 time_sliced_elements = 50000;
+const static int32 time_slice_budget_us = 500;
+
+void CompareTimeSlicedExecutionTimes()
+{
+	TArray<UMockUObject*> roots;
+	for (int32 i = 0; i < time_sliced_elements; ++i)
+	{
+		roots.Add(NewObject<UMockUObject>(NewObject<UMockUObject>()));
+	}
+	const auto chain = TOptionalPtrChainBuilder<UMockUObject>()
+		.Map(&UObject::GetOuter)
+		.Build();
+	TArray<UObject*> results;
+	results.SetNumZeroed(time_sliced_elements);
+	const auto store_result = [&](int32 index, TOptionalPtr<UObject> result)
+	{
+		results[index] = result.IsSet() ? result.Get() : nullptr;
+	};
+
+	const auto single_exec_time = MeasureExecutionTime(1, [&]()
+	{
+		for (int32 i = 0; i < roots.Num(); ++i)
+		{
+			store_result(i, chain.Execute(roots[i]));
+		}
+	});
+
+	TOptionalPtrTimeSlicer<UMockUObject, UObject> slicer(chain, roots);
+	while (!slicer.Tick(time_slice_budget_us, store_result)) {}
+	const FOptionalPtrTimeSliceStats& stats = slicer.GetStats();
+
+	TestEqual("", stats.NumProcessed, static_cast<int64>(time_sliced_elements));
+	AddInfo(FString::Printf(TEXT("Execution time for single frame approach: %f ns"), single_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for time sliced approach: %f ns in %d ticks"), stats.TotalMicroseconds * 1000.0, stats.NumTicks));
+	AddInfo(FString::Printf(TEXT("Time sliced approach processed %f elements/ms, worst overrun of %d us budget: %f us"),
+		stats.GetElementsPerMillisecond(), time_slice_budget_us, stats.WorstOverrunMicroseconds));
+
+	for (const auto root : roots)
+	{
+		root->GetOuter()->ConditionalBeginDestroy();
+		root->Destroy();
+	}
+}
+
+const static int32 num_bindings = 10000;
+const static int32 binding_frames = 100;
+const static int32 binding_changes_per_frame = num_bindings / 100;
+const static int32 binding_children = 8;
+
+template<typename LinkType>
+void CompareBindingExecutionTimes(LinkType link, const TCHAR* link_name)
+{
+	//each binding follows root -> first -> second -> third, 1% of the first nodes switch their next node every frame
+	MockVersionedNode* nodes = new MockVersionedNode[num_bindings * 5];
+	for (int32 i = 0; i < num_bindings * 5; ++i)
+	{
+		for (int32 child = 0; child < binding_children - 2; ++child)
+		{
+			nodes[i].AddChild(&nodes[(i + num_bindings + child) % (num_bindings * 5)]);
+		}
+	}
+	for (int32 i = 0; i < num_bindings; ++i)
+	{
+		for (int32 hop = 0; hop < 3; ++hop)
+		{
+			MockVersionedNode& node = nodes[i * 5 + hop];
+			MockVersionedNode* const next = &nodes[i * 5 + (hop == 2 ? 4 : hop + 1)];
+			node.AddChild(next);
+			node.SetNext(next);
+		}
+		nodes[i * 5 + 1].AddChild(&nodes[i * 5 + 3]);
+		nodes[i * 5 + 3].AddChild(&nodes[i * 5 + 4]);
+		nodes[i * 5 + 3].SetNext(&nodes[i * 5 + 4]);
+	}
+	const auto change_nodes = [&](int32 frame)
+	{
+		for (int32 i = 0; i < binding_changes_per_frame; ++i)
+		{
+			const int32 binding = (frame * binding_changes_per_frame + i) * 7 % num_bindings;
+			MockVersionedNode& first = nodes[binding * 5 + 1];
+			first.SetNext(first.GetNext() == &nodes[binding * 5 + 2] ? &nodes[binding * 5 + 3] : &nodes[binding * 5 + 2]);
+		}
+	};
+
+	TArray<MockVersionedNode*> results;
+	results.SetNumZeroed(num_bindings);
+	int32 full_changes = 0;
+	const auto full_exec_time = MeasureExecutionTime(binding_frames, [&, frame = 0]() mutable
+	{
+		change_nodes(frame++);
+		for (int32 i = 0; i < num_bindings; ++i)
+		{
+			MockVersionedNode* const result = GetValidOptionalPtr(TOptionalPtr<MockVersionedNode>(&nodes[i * 5])
+				.Map(LinkType{link})
+				.Map(LinkType{link})
+				.Map(LinkType{link}));
+			full_changes += result != results[i];
+			results[i] = result;
+		}
+	});
+
+	using FBinding = decltype(MakeOptionalPtrBinding(nodes, link, link, link));
+	TArray<FBinding> bindings;
+	bindings.Reserve(num_bindings);
+	for (int32 i = 0; i < num_bindings; ++i)
+	{
+		bindings.Add(MakeOptionalPtrBinding(&nodes[i * 5], link, link, link));
+		bindings.Last().Update();
+	}
+	int32 binding_changes = 0;
+	const auto binding_exec_time = MeasureExecutionTime(binding_frames, [&, frame = 0]() mutable
+	{
+		change_nodes(frame++);
+		for (FBinding& binding : bindings)
+		{
+			binding_changes += binding.Update();
+		}
+	});
+
+	TestEqual("", binding_changes, full_changes - num_bindings);
+	AddInfo(FString::Printf(TEXT("Execution time for full re-evaluation approach with %s: %f ns"), link_name, full_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for binding approach with %s: %f ns"), link_name, binding_exec_time));
+
+	delete[] nodes;
+}
+
+const static int32 epoch_threads = 16;
+const static int32 epoch_reads_per_thread = 100000;
+
+void CompareEpochExecutionTimes(int32 num_threads)
+{
+	MockReclaimedNode nodes[4];
+	for (int32 i = 0; i < 3; ++i)
+	{
+		nodes[i].m_next = &nodes[i + 1];
+	}
+	std::atomic<int32> found{0};
+	const auto unguarded_exec_time = MeasureExecutionTime(1, [&]()
+	{
+		ParallelFor(num_threads, [&](int32)
+		{
+			int32 thread_found = 0;
+			for (int32 i = 0; i < epoch_reads_per_thread; ++i)
+			{
+				thread_found += TOptionalPtr<MockReclaimedNode>(&nodes[0])
+					.Map(&MockReclaimedNode::GetNext)
+					.Map(&MockReclaimedNode::GetNext)
+					.Map(&MockReclaimedNode::GetNext)
+					.IsSet();
+			}
+			found += thread_found;
+		});
+	});
+	FRWLock lock;
+	const auto lock_exec_time = MeasureExecutionTime(1, [&]()
+	{
+		ParallelFor(num_threads, [&](int32)
+		{
+			int32 thread_found = 0;
+			for (int32 i = 0; i < epoch_reads_per_thread; ++i)
+			{
+				FReadScopeLock read_lock(lock);
+				thread_found += TOptionalPtr<MockReclaimedNode>(&nodes[0])
+					.Map(&MockReclaimedNode::GetNext)
+					.Map(&MockReclaimedNode::GetNext)
+					.Map(&MockReclaimedNode::GetNext)
+					.IsSet();
+			}
+			found += thread_found;
+		});
+	});
+	const auto epoch_exec_time = MeasureExecutionTime(1, [&]()
+	{
+		ParallelFor(num_threads, [&](int32)
+		{
+			int32 thread_found = 0;
+			for (int32 i = 0; i < epoch_reads_per_thread; ++i)
+			{
+				FOptionalPtrEpochGuard guard;
+				thread_found += TOptionalPtr<MockReclaimedNode, TOptionalPtrEpochPolicy<>>(&nodes[0])
+					.Map(&MockReclaimedNode::GetNext)
+					.Map(&MockReclaimedNode::GetNext)
+					.Map(&MockReclaimedNode::GetNext)
+					.IsSet();
+			}
+			found += thread_found;
+		});
+	});
+
+	TestEqual("", found.load(), 3 * num_threads * epoch_reads_per_thread);
+	AddInfo(FString::Printf(TEXT("Execution time for unguarded approach with %d threads: %f ns"), num_threads, unguarded_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for shared lock approach with %d threads: %f ns"), num_threads, lock_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for epoch guard approach with %d threads: %f ns"), num_threads, epoch_exec_time));
+}
+
+const static int32 hazard_reads = 1000000;
+const static int32 hazard_retired_objects = 1000;
+const static int32 hazard_stall_ms = 100;
+
+void CompareHazardExecutionTimes()
+{
+	MockReclaimedNode nodes[4];
+	for (int32 i = 0; i < 3; ++i)
+	{
+		nodes[i].m_hazard_next.Store(&nodes[i + 1]);
+		nodes[i].m_next = &nodes[i + 1];
+	}
+
+	int32 found = 0;
+	const auto unguarded_exec_time = MeasureExecutionTime(hazard_reads, [&]()
+	{
+		found += TOptionalPtr<MockReclaimedNode>(&nodes[0])
+			.Map(&MockReclaimedNode::GetNext)
+			.Map(&MockReclaimedNode::GetNext)
+			.Map(&MockReclaimedNode::GetNext)
+			.IsSet();
+	});
+	const auto epoch_exec_time = MeasureExecutionTime(hazard_reads, [&]()
+	{
+		FOptionalPtrEpochGuard guard;
+		found += TOptionalPtr<MockReclaimedNode, TOptionalPtrEpochPolicy<>>(&nodes[0])
+			.Map(&MockReclaimedNode::GetNext)
+			.Map(&MockReclaimedNode::GetNext)
+			.Map(&MockReclaimedNode::GetNext)
+			.IsSet();
+	});
+	const auto hazard_exec_time = MeasureExecutionTime(hazard_reads, [&]()
+	{
+		FOptionalPtrHazardScope scope;
+		found += TOptionalPtr<MockReclaimedNode, TOptionalPtrHazardPolicy<>>(&nodes[0])
+			.Map(&MockReclaimedNode::m_hazard_next)
+			.Map(&MockReclaimedNode::m_hazard_next)
+			.Map(&MockReclaimedNode::m_hazard_next)
+			.IsSet();
+	});
+
+	TestEqual("", found, 3 * hazard_reads);
+	AddInfo(FString::Printf(TEXT("Execution time for unguarded approach: %f ns"), unguarded_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for epoch guard approach: %f ns"), epoch_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for hazard pointer approach: %f ns"), hazard_exec_time));
+}
+
+template<typename DomainType, typename ReadFuncType>
+void LogStalledReclamation(DomainType& domain, ReadFuncType&& read, const TCHAR* approach)
+{
+	std::atomic<bool> stalled{false};
+	std::atomic<int32> num_destroyed{0};
+	double latency_ms = 0.0;
+	int32 max_retired = 0;
+	ParallelFor(2, [&](int32 thread)
+	{
+		if (thread == 0)
+		{
+			//the reader stalls in the middle of its chain
+			read([&]()
+			{
+				stalled = true;
+				FPlatformProcess::Sleep(hazard_stall_ms / 1000.f);
+			});
+			return;
+		}
+
+		while (!stalled)
+		{
+			FPlatformProcess::Yield();
+		}
+		const double start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < hazard_retired_objects; ++i)
+		{
+			MockReclaimedNode* const node = new MockReclaimedNode();
+			node->m_num_destroyed = &num_destroyed;
+			domain.Retire(node);
+			max_retired = FMath::Max(max_retired, i + 1 - num_destroyed.load());
+		}
+		while (num_destroyed < hazard_retired_objects)
+		{
+			domain.Reclaim();
+		}
+		latency_ms = (FPlatformTime::Seconds() - start) * 1000.0;
+	});
+
+	TestEqual("", num_destroyed.load(), hazard_retired_objects);
+	AddInfo(FString::Printf(TEXT("Reclamation of %d objects with reader stalled for %d ms by %s approach: %f ms, at most %d objects retired"),
+		hazard_retired_objects, hazard_stall_ms, approach, latency_ms, max_retired));
+}
+
+void CompareStalledReclamation()
+{
+	MockReclaimedNode nodes[2];
+	nodes[0].m_hazard_next.Store(&nodes[1]);
+	nodes[0].m_next = &nodes[1];
+
+	LogStalledReclamation(FOptionalPtrEpochDomain::Get(), [&](auto&& stall)
+	{
+		FOptionalPtrEpochGuard guard;
+		TOptionalPtr<MockReclaimedNode, TOptionalPtrEpochPolicy<>>(&nodes[0]).Map(&MockReclaimedNode::GetNext);
+		stall();
+	}, TEXT("epoch guard"));
+	LogStalledReclamation(FOptionalPtrHazardDomain::Get(), [&](auto&& stall)
+	{
+		FOptionalPtrHazardScope scope;
+		TOptionalPtr<MockReclaimedNode, TOptionalPtrHazardPolicy<>>(&nodes[0]).Map(&MockReclaimedNode::m_hazard_next);
+		stall();
+	}, TEXT("hazard pointer"));
+}
+
+const static int32 scaling_max_threads = 8;
+const static int32 scaling_chains_per_thread = 200000;
+const static int32 scaling_allocations_per_thread = 50000;
+
+//counters of the threads next to each other, so the threads writing them invalidate the same cache lines
+struct FUnpaddedScalingCounter
+{
+	std::atomic<int64> Value{0};
+};
+
+struct alignas(64) FPaddedScalingCounter
+{
+	std::atomic<int64> Value{0};
+};
+
+template<typename CounterType, typename FuncType>
+double MeasureScalingExecutionTime(int32 num_threads, int32 chains_per_thread, FuncType&& func)
+{
+	CounterType counters[scaling_max_threads];
+	const double exec_time = MeasureExecutionTime(1, [&]()
+	{
+		ParallelFor(num_threads, [&](int32 thread)
+		{
+			//the counter is stored after each chain instead of being kept in a register
+			std::atomic<int64>& counter = counters[thread].Value;
+			for (int32 i = 0; i < chains_per_thread; ++i)
+			{
+				counter.store(counter.load(std::memory_order_relaxed) + func(), std::memory_order_relaxed);
+			}
+		});
+	});
+
+	int64 total = 0;
+	for (int32 thread = 0; thread < num_threads; ++thread)
+	{
+		total += counters[thread].Value.load();
+	}
+	TestEqual("", total, static_cast<int64>(num_threads) * chains_per_thread);
+	return exec_time;
+}
+
+void CompareScalingExecutionTimes()
+{
+	//the graph is shared by all the threads and only read
+	MockLinkNode nodes[4];
+	for (int32 i = 0; i < 3; ++i)
+	{
+		nodes[i].m_next = &nodes[i + 1];
+	}
+	nodes[3].m_value = 1;
+	auto chain = [&nodes]()
+	{
+		return TOptionalPtr<MockLinkNode>(&nodes[0])
+			.Map(&MockLinkNode::m_next)
+			.Map(&MockLinkNode::m_next)
+			.Map(&MockLinkNode::m_next)
+			.MapToValue(0, &MockLinkNode::m_value);
+	};
+
+	for (int32 num_threads = 1; num_threads <= scaling_max_threads; num_threads *= 2)
+	{
+		const auto unpadded_exec_time = MeasureScalingExecutionTime<FUnpaddedScalingCounter>(num_threads, scaling_chains_per_thread, chain);
+		const auto padded_exec_time = MeasureScalingExecutionTime<FPaddedScalingCounter>(num_threads, scaling_chains_per_thread, chain);
+
+		//each chain allocates the object it ends at from the arena of the thread
+		MockNonUObject object;
+		const auto allocating_exec_time = MeasureScalingExecutionTime<FPaddedScalingCounter>(num_threads, scaling_allocations_per_thread, [&object]()
+		{
+			return TOptionalPtr<MockNonUObject>(&object)
+				.Map(&MockObject::MethodConst)
+				.MapToValue(MethodEnum::Default, &SimpleObject::func_name) == MethodEnum::MethodConst;
+		});
+
+		const double chains = static_cast<double>(num_threads) * scaling_chains_per_thread;
+		const double allocations = static_cast<double>(num_threads) * scaling_allocations_per_thread;
+		AddInfo(FString::Printf(TEXT("Execution time for unpadded counters approach with %d threads: %f ns, %f chains per ms"),
+			num_threads, unpadded_exec_time, chains * 1e6 / unpadded_exec_time));
+		AddInfo(FString::Printf(TEXT("Execution time for padded counters approach with %d threads: %f ns, %f chains per ms"),
+			num_threads, padded_exec_time, chains * 1e6 / padded_exec_time));
+		AddInfo(FString::Printf(TEXT("Execution time for allocating approach with %d threads: %f ns, %f chains per ms"),
+			num_threads, allocating_exec_time, allocations * 1e6 / allocating_exec_time));
+	}
+}
+
+const static int32 seq_lock_readers = 15;
+const static int32 seq_lock_reads_per_thread = 100000;
+
+void CompareSeqLockExecutionTimes()
+{
+	MockKinematicObject object;
+	std::atomic<int32> num_finished{0};
+	std::atomic<int32> num_writes{0};
+	std::atomic<int32> consistent{0};
+	//the last thread keeps writing the object until the readers finish
+	auto write = [&](auto&& write_object)
+	{
+		num_writes = 0;
+		for (int64 timestamp = 1; num_finished < seq_lock_readers; ++timestamp)
+		{
+			write_object(timestamp);
+			++num_writes;
+		}
+		num_finished = 0;
+	};
+
+	const auto mutex_exec_time = MeasureExecutionTime(1, [&]()
+	{
+		ParallelFor(seq_lock_readers + 1, [&](int32 thread)
+		{
+			if (thread == seq_lock_readers)
+			{
+				write([&](int64 timestamp)
+				{
+					FScopeLock lock(&object.m_mutex);
+					object.m_position = static_cast<double>(timestamp);
+					object.m_velocity = static_cast<double>(timestamp);
+					object.m_timestamp = timestamp;
+				});
+				return;
+			}
+
+			int32 thread_consistent = 0;
+			for (int32 i = 0; i < seq_lock_reads_per_thread; ++i)
+			{
+				FScopeLock lock(&object.m_mutex);
+				thread_consistent += object.m_position == object.m_velocity && object.m_position == static_cast<double>(object.m_timestamp);
+			}
+			consistent += thread_consistent;
+			++num_finished;
+		});
+	});
+	const int32 mutex_writes = num_writes;
+
+	const auto seq_lock_exec_time = MeasureExecutionTime(1, [&]()
+	{
+		ParallelFor(seq_lock_readers + 1, [&](int32 thread)
+		{
+			if (thread == seq_lock_readers)
+			{
+				write([&](int64 timestamp)
+				{
+					object.Write(timestamp);
+				});
+				return;
+			}
+
+			int32 thread_consistent = 0;
+			for (int32 i = 0; i < seq_lock_reads_per_thread; ++i)
+			{
+				const auto values = TOptionalPtr<MockKinematicObject>(&object).MapSnapshot(&MockKinematicObject::m_seq_lock,
+					&MockKinematicObject::m_position, &MockKinematicObject::m_velocity, &MockKinematicObject::m_timestamp);
+				thread_consistent += std::get<0>(*values) == std::get<1>(*values) && std::get<0>(*values) == static_cast<double>(std::get<2>(*values));
+			}
+			consistent += thread_consistent;
+			++num_finished;
+		});
+	});
+	const int32 seq_lock_writes = num_writes;
+
+	TestEqual("", consistent.load(), 2 * seq_lock_readers * seq_lock_reads_per_thread);
+	AddInfo(FString::Printf(TEXT("Execution time for mutex approach: %f ns, %d writes"), mutex_exec_time, mutex_writes));
+	AddInfo(FString::Printf(TEXT("Execution time for sequence lock approach: %f ns, %d writes"), seq_lock_exec_time, seq_lock_writes));
+}
+
+const static int32 atomic_reads = 1000000;
+
+void CompareAtomicExecutionTimes()
+{
+	MockAtomicNode nodes[4];
+	for (int32 i = 0; i < 3; ++i)
+	{
+		nodes[i].m_next = &nodes[i + 1];
+		nodes[i].m_unreal_next = &nodes[i + 1];
+		nodes[i].m_raw_next = &nodes[i + 1];
+	}
+
+	int32 found = 0;
+	const auto raw_exec_time = MeasureExecutionTime(atomic_reads, [&]()
+	{
+		found += TOptionalPtr<MockAtomicNode>(&nodes[0])
+			.Map(&MockAtomicNode::m_raw_next)
+			.Map(&MockAtomicNode::m_raw_next)
+			.Map(&MockAtomicNode::m_raw_next)
+			.IsSet();
+	});
+	const auto acquire_exec_time = MeasureExecutionTime(atomic_reads, [&]()
+	{
+		found += TOptionalPtr<MockAtomicNode>(&nodes[0])
+			.MapAcquire(&MockAtomicNode::m_next)
+			.MapAcquire(&MockAtomicNode::m_next)
+			.MapAcquire(&MockAtomicNode::m_next)
+			.IsSet();
+	});
+	const auto consume_exec_time = MeasureExecutionTime(atomic_reads, [&]()
+	{
+		found += TOptionalPtr<MockAtomicNode>(&nodes[0])
+			.MapConsume(&MockAtomicNode::m_next)
+			.MapConsume(&MockAtomicNode::m_next)
+			.MapConsume(&MockAtomicNode::m_next)
+			.IsSet();
+	});
+	const auto relaxed_exec_time = MeasureExecutionTime(atomic_reads, [&]()
+	{
+		found += TOptionalPtr<MockAtomicNode>(&nodes[0])
+			.MapRelaxed(&MockAtomicNode::m_next)
+			.MapRelaxed(&MockAtomicNode::m_next)
+			.MapRelaxed(&MockAtomicNode::m_next)
+			.IsSet();
+	});
+	const auto unreal_exec_time = MeasureExecutionTime(atomic_reads, [&]()
+	{
+		found += TOptionalPtr<MockAtomicNode>(&nodes[0])
+			.Map(&MockAtomicNode::m_unreal_next)
+			.Map(&MockAtomicNode::m_unreal_next)
+			.Map(&MockAtomicNode::m_unreal_next)
+			.IsSet();
+	});
+
+	TestEqual("", found, 5 * atomic_reads);
+	AddInfo(FString::Printf(TEXT("Execution time for raw pointer approach: %f ns"), raw_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for acquire approach: %f ns"), acquire_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for consume approach: %f ns"), consume_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for relaxed approach: %f ns"), relaxed_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for sequentially consistent TAtomic approach: %f ns"), unreal_exec_time));
+}
+
+const static int32 snapshot_roots = 1000;
+const static int32 snapshot_builds = 100;
+const static int32 snapshot_threads = 4;
+const static int32 snapshot_reads_per_thread = 200000;
+
+//world of each root has its own controller, pawn and health component
+struct FSnapshotScene
+{
+	TArray<MockWorld> Worlds;
+	TArray<MockPlayerController> Controllers;
+	TArray<MockPawn> Pawns;
+	TArray<MockHealthComponent> HealthComponents;
+	TArray<MockWorld*> Roots;
+	FOptionalPtrSnapshotSchema Schema;
+
+	FSnapshotScene()
+	{
+		Worlds.SetNum(snapshot_roots);
+		Controllers.SetNum(snapshot_roots);
+		Pawns.SetNum(snapshot_roots);
+		HealthComponents.SetNum(snapshot_roots);
+		for (int32 i = 0; i < snapshot_roots; ++i)
+		{
+			Worlds[i].m_first_player_controller = &Controllers[i];
+			Controllers[i].m_pawn = &Pawns[i];
+			Pawns[i].m_health_component = &HealthComponents[i];
+			Roots.Add(&Worlds[i]);
+		}
+		Schema.Add(&MockWorld::GetFirstPlayerController)
+			.Add(&MockWorld::m_num_players)
+			.Add(&MockPlayerController::m_pawn)
+			.Add(&MockPawn::GetHealthComponent)
+			.Add(&MockHealthComponent::m_health);
+	}
+};
+
+void CompareSnapshotBuildTimes()
+{
+	FSnapshotScene scene;
+	float health = 0.f;
+	const auto live_exec_time = MeasureExecutionTime(snapshot_builds, [&]()
+	{
+		for (MockWorld* root : scene.Roots)
+		{
+			health += TOptionalPtr<MockWorld>(root)
+				.Map(&MockWorld::GetFirstPlayerController)
+				.Map(&MockPlayerController::m_pawn)
+				.Map(&MockPawn::GetHealthComponent)
+				.MapToValue(0.f, &MockHealthComponent::m_health);
+		}
+	});
+	SIZE_T snapshot_size = 0;
+	const auto snapshot_exec_time = MeasureExecutionTime(snapshot_builds, [&]()
+	{
+		const TUniquePtr<FOptionalPtrSnapshot> snapshot = scene.Schema.Build(scene.Roots);
+		snapshot_size = snapshot->GetAllocatedSize();
+	});
+
+	TestEqual("", health, 100.f * snapshot_roots * snapshot_builds);
+	AddInfo(FString::Printf(TEXT("Execution time for live chain approach: %f ns"), live_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for snapshot build approach: %f ns, %d bytes per snapshot"),
+		snapshot_exec_time, static_cast<int32>(snapshot_size)));
+}
+
+void CompareSnapshotReadTimes(int32 num_threads)
+{
+	FSnapshotScene scene;
+	std::atomic<int32> num_finished{0};
+	std::atomic<int32> num_frames{0};
+	std::atomic<int32> found{0};
+	//the last thread keeps changing the live objects until the readers finish
+	auto write = [&](auto&& update)
+	{
+		num_frames = 0;
+		for (float health = 1.f; num_finished < num_threads; health += 1.f)
+		{
+			update(health);
+			++num_frames;
+		}
+		num_finished = 0;
+	};
+
+	FRWLock lock;
+	const auto lock_exec_time = MeasureExecutionTime(1, [&]()
+	{
+		ParallelFor(num_threads + 1, [&](int32 thread)
+		{
+			if (thread == num_threads)
+			{
+				write([&](float health)
+				{
+					FWriteScopeLock write_lock(lock);
+					for (MockHealthComponent& health_component : scene.HealthComponents)
+					{
+						health_component.m_health = health;
+					}
+				});
+				return;
+			}
+
+			int32 thread_found = 0;
+			for (int32 i = 0; i < snapshot_reads_per_thread; ++i)
+			{
+				FReadScopeLock read_lock(lock);
+				thread_found += TOptionalPtr<MockWorld>(scene.Roots[i % snapshot_roots])
+					.Map(&MockWorld::GetFirstPlayerController)
+					.Map(&MockPlayerController::m_pawn)
+					.Map(&MockPawn::GetHealthComponent)
+					.MapToValue(0.f, &MockHealthComponent::m_health) > 0.f;
+			}
+			found += thread_found;
+			++num_finished;
+		});
+	});
+	const int32 lock_frames = num_frames;
+
+	FOptionalPtrSnapshotPublisher publisher;
+	publisher.Publish(scene.Schema.Build(scene.Roots));
+	const auto snapshot_exec_time = MeasureExecutionTime(1, [&]()
+	{
+		ParallelFor(num_threads + 1, [&](int32 thread)
+		{
+			if (thread == num_threads)
+			{
+				write([&](float health)
+				{
+					for (MockHealthComponent& health_component : scene.HealthComponents)
+					{
+						health_component.m_health = health;
+					}
+					publisher.Publish(scene.Schema.Build(scene.Roots));
+				});
+				return;
+			}
+
+			int32 thread_found = 0;
+			for (int32 i = 0; i < snapshot_reads_per_thread; ++i)
+			{
+				FOptionalPtrEpochGuard guard;
+				thread_found += publisher.Acquire()->GetRoot<MockWorld>(i % snapshot_roots)
+					.Map(&MockWorld::GetFirstPlayerController)
+					.Map(&MockPlayerController::m_pawn)
+					.Map(&MockPawn::GetHealthComponent)
+					.MapToValue(0.f, &MockHealthComponent::m_health) > 0.f;
+			}
+			found += thread_found;
+			++num_finished;
+		});
+	});
+	const int32 snapshot_frames = num_frames;
+
+	TestEqual("", found.load(), 2 * num_threads * snapshot_reads_per_thread);
+	AddInfo(FString::Printf(TEXT("Execution time for shared lock approach with %d readers: %f ns, %d frames written"),
+		num_threads, lock_exec_time, lock_frames));
+	AddInfo(FString::Printf(TEXT("Execution time for snapshot approach with %d readers: %f ns, %d frames written"),
+		num_threads, snapshot_exec_time, snapshot_frames));
+}
+
+const static int32 scene_graph_levels = 20;
+const static int32 scene_graph_nodes_per_level = 5000;
+const static uint32 ancestor_lookup_repetitions = 10;
+
+//only the roots are of the searched type, so each uncached lookup walks all the levels
+TArray<MockLinkNode*> CreateSceneGraph()
+{
+	TArray<MockLinkNode*> nodes;
+	for (int32 level = 0; level < scene_graph_levels; ++level)
+	{
+		for (int32 i = 0; i < scene_graph_nodes_per_level; ++i)
+		{
+			MockLinkNode* node = level == 0 ? new MockAncestorLinkNode(level) : new MockLinkNode(level);
+			if (level > 0)
+			{
+				node->m_next = nodes[(level - 1) * scene_graph_nodes_per_level + FMath::RandRange(0, scene_graph_nodes_per_level - 1)];
+			}
+			nodes.Add(node);
+		}
+	}
+	return nodes;
+}
+
+void CompareAncestorLookupExecutionTimes(SIZE_T memory_budget)
+{
+	const auto nodes = CreateSceneGraph();
+	TOptionalPtrAncestorCache<MockLinkNode> cache(memory_budget);
+	uint32 found = 0;
+
+	const auto cached_exec_time = MeasureExecutionTime(ancestor_lookup_repetitions, [&]()
+	{
+		for (const auto node : nodes)
+		{
+			found += cache.FindAncestor<MockAncestorLinkNode>(node, &MockLinkNode::m_next).IsSet();
+		}
+	});
+	const auto walk_exec_time = MeasureExecutionTime(ancestor_lookup_repetitions, [&]()
+	{
+		for (const auto node : nodes)
+		{
+			found += TOptionalPtr<MockLinkNode>(node).FindAncestor<MockAncestorLinkNode>(&MockLinkNode::m_next).IsSet();
+		}
+	});
+
+	TestEqual("", found, 2 * ancestor_lookup_repetitions * (nodes.Num() - scene_graph_nodes_per_level));
+	AddInfo(FString::Printf(TEXT("Execution time for cached approach: %f ns (%d of %d entries used)"),
+		cached_exec_time, cache.Num(), cache.GetCapacity()));
+	AddInfo(FString::Printf(TEXT("Execution time for FindAncestor approach: %f ns"), walk_exec_time));
+
+	for (const auto node : nodes)
+	{
+		delete node;
+	}
+}
+
+const static int32 map_find_objects = 100000;
+const static uint32 map_find_repetitions = 10;
+
+void CompareMapFindExecutionTimes()
+{
+	TArray<MockNonUObject*> objects;
+	for (int32 i = 0; i < map_find_objects; ++i)
+	{
+		objects.Add(new MockNonUObject());
+	}
+	const FString key = TEXT("Method");
+	const TOptionalPtrHashedKey<FString> hashed_key(key);
+	uint32 found = 0;
+
+	const auto name_exec_time = MeasureExecutionTime(map_find_repetitions, [&]()
+	{
+		for (const auto obj : objects)
+		{
+			found += TOptionalPtr<MockNonUObject>(obj).MapFind<"Method"_h>(&MockObject::m_named_entries).IsSet();
+		}
+	});
+	const auto hashed_exec_time = MeasureExecutionTime(map_find_repetitions, [&]()
+	{
+		for (const auto obj : objects)
+		{
+			found += TOptionalPtr<MockNonUObject>(obj).MapFind(&MockObject::m_entries, hashed_key).IsSet();
+		}
+	});
+	const auto map_find_exec_time = MeasureExecutionTime(map_find_repetitions, [&]()
+	{
+		for (const auto obj : objects)
+		{
+			found += TOptionalPtr<MockNonUObject>(obj).MapFind(&MockObject::m_entries, key).IsSet();
+		}
+	});
+	const auto regular_exec_time = MeasureExecutionTime(map_find_repetitions, [&]()
+	{
+		for (const auto obj : objects)
+		{
+			if (obj == nullptr)
+				continue;
+
+			SimpleObject* const* value = obj->m_entries.Find(key);
+			found += value != nullptr && *value != nullptr;
+		}
+	});
+
+	TestEqual("", found, 4 * map_find_repetitions * map_find_objects);
+	AddInfo(FString::Printf(TEXT("Execution time for MapFind with literal name approach: %f ns"), name_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for MapFind with hashed key approach: %f ns"), hashed_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for MapFind approach: %f ns"), map_find_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for regular approach: %f ns"), regular_exec_time));
+
+	for (const auto obj : objects)
+	{
+		obj->Destroy();
+	}
+}
+
+const static uint32 chain_repetitions = 1000000;
+
+void CompareChainExecutionTimes()
+{
+	TArray<MockLinkNode*> nodes;
+	for (int32 i = 0; i < 5; ++i)
+	{
+		nodes.Add(new MockLinkNode(i));
+		if (i > 0)
+		{
+			nodes[i]->m_next = nodes[i - 1];
+		}
+	}
+	MockLinkNode* root = nodes.Last();
+	uint32 found = 0;
+
+	const auto chain = TOptionalPtrChainBuilder<MockLinkNode>()
+		.Map(&MockLinkNode::m_next)
+		.Map(&MockLinkNode::GetNext)
+		.Map(&MockLinkNode::m_next)
+		.Map(&MockLinkNode::GetNext)
+		.Build();
+	const auto chain_exec_time = MeasureExecutionTime(chain_repetitions, [&]()
+	{
+		found += chain.Execute(root).IsSet();
+	});
+
+	TArray<TFunction<MockLinkNode*(MockLinkNode*)>> steps;
+	steps.Add([](MockLinkNode* node) { return node->m_next; });
+	steps.Add([](MockLinkNode* node) { return node->GetNext(); });
+	steps.Add([](MockLinkNode* node) { return node->m_next; });
+	steps.Add([](MockLinkNode* node) { return node->GetNext(); });
+	const auto function_exec_time = MeasureExecutionTime(chain_repetitions, [&]()
+	{
+		MockLinkNode* node = root;
+		for (const auto& step : steps)
+		{
+			if (node == nullptr)
+				break;
+			node = step(node);
+		}
+		found += node != nullptr;
+	});
+
+	const auto map_exec_time = MeasureExecutionTime(chain_repetitions, [&]()
+	{
+		found += TOptionalPtr<MockLinkNode>(root)
+			.Map(&MockLinkNode::m_next)
+			.Map(&MockLinkNode::GetNext)
+			.Map(&MockLinkNode::m_next)
+			.Map(&MockLinkNode::GetNext)
+			.IsSet();
+	});
+
+	TestEqual("", found, 3 * chain_repetitions);
+	AddInfo(FString::Printf(TEXT("Execution time for bytecode chain approach: %f ns"), chain_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for TFunction chain approach: %f ns"), function_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for Map approach: %f ns"), map_exec_time));
+
+	for (const auto node : nodes)
+	{
+		delete node;
+	}
+}
+
+const static uint32 path_resolve_repetitions = 100000;
+
+void ComparePathResolveExecutionTimes()
+{
+	MockHealthComponent health_component;
+	MockPawn pawn;
+	pawn.m_health_component = &health_component;
+	MockPlayerController controller;
+	controller.m_pawn = &pawn;
+	MockWorld world;
+	world.m_first_player_controller = &controller;
+
+	const FString path = TEXT("FirstPlayerController.Pawn.HealthComponent.Health");
+	TOptionalPtrPathResolver<FOptionalPtrMockReflection> resolver;
+	float health = 0.f;
+
+	const auto first_resolve_exec_time = MeasureExecutionTime(path_resolve_repetitions, [&]()
+	{
+		resolver.Empty();
+		health += resolver.ResolveValue(&world, path, 0.f);
+	});
+	const auto cached_exec_time = MeasureExecutionTime(path_resolve_repetitions, [&]()
+	{
+		health += resolver.ResolveValue(&world, path, 0.f);
+	});
+	const FOptionalPtrPath* plan = resolver.FindOrCompile(&world, path);
+	const auto plan_exec_time = MeasureExecutionTime(path_resolve_repetitions, [&]()
+	{
+		health += resolver.EvaluateValue(*plan, &world, 0.f);
+	});
+	const auto map_exec_time = MeasureExecutionTime(path_resolve_repetitions, [&]()
+	{
+		health += TOptionalPtr<MockWorld>(&world)
+			.Map(&MockWorld::GetFirstPlayerController)
+			.Map(&MockPlayerController::m_pawn)
+			.Map(&MockPawn::GetHealthComponent)
+			.MapToValue(0.f, &MockHealthComponent::m_health);
+	});
+
+	TestEqual("", health, 4 * path_resolve_repetitions * health_component.m_health);
+	AddInfo(FString::Printf(TEXT("Execution time for first resolve approach: %f ns"), first_resolve_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for cached plan approach: %f ns"), cached_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for kept plan approach: %f ns"), plan_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for Map approach: %f ns"), map_exec_time));
+}
+
+const static uint32 weak_map_repetitions = 1000000;
+
+void CompareWeakMapExecutionTimes()
+{
+	TArray<UMockUObject*> objects;
+	for (int32 i = 0; i < 4; ++i)
+	{
+		objects.Add(NewObject<UMockUObject>(i > 0 ? objects[i - 1] : nullptr));
+		if (i > 0)
+		{
+			objects[i]->m_weak_link = objects[i - 1];
+		}
+	}
+	UMockUObject* root = objects.Last();
+	uint32 found = 0;
+
+	const auto raw_exec_time = MeasureExecutionTime(weak_map_repetitions, [&]()
+	{
+		found += TOptionalPtr<UObject>(root)
+			.Map(&UObject::GetOuter)
+			.Map(&UObject::GetOuter)
+			.Map(&UObject::GetOuter)
+			.IsSet();
+	});
+
+	const auto get_weak_link = [](UMockUObject* obj) { return obj->m_weak_link.Get(); };
+	const auto get_exec_time = MeasureExecutionTime(weak_map_repetitions, [&]()
+	{
+		found += TOptionalPtr<UMockUObject>(root)
+			.MapStatic(get_weak_link)
+			.MapStatic(get_weak_link)
+			.MapStatic(get_weak_link)
+			.IsSet();
+	});
+
+	const auto weak_exec_time = MeasureExecutionTime(weak_map_repetitions, [&]()
+	{
+		found += TOptionalPtr<UMockUObject>(root)
+			.Map(&UMockUObject::m_weak_link)
+			.Map(&UMockUObject::m_weak_link)
+			.Map(&UMockUObject::m_weak_link)
+			.IsSet();
+	});
+
+	TestEqual("", found, 3 * weak_map_repetitions);
+	AddInfo(FString::Printf(TEXT("Execution time for raw pointer Map approach: %f ns"), raw_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for weak pointer Get approach: %f ns"), get_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for weak pointer Map approach: %f ns"), weak_exec_time));
+
+	for (const auto obj : objects)
+	{
+		obj->Destroy();
+	}
+}
+
+const static uint32 shared_map_repetitions = 1000000;
+const static int32 shared_map_threads = 8;
+
+void CompareSharedMapExecutionTimes()
+{
+	TArray<TSharedPtr<MockLinkNode, ESPMode::ThreadSafe>> nodes;
+	for (int32 i = 0; i < 4; ++i)
+	{
+		nodes.Add(MakeShared<MockLinkNode, ESPMode::ThreadSafe>(i));
+		if (i > 0)
+		{
+			nodes[i]->m_shared_next = nodes[i - 1];
+		}
+	}
+	MockLinkNode* root = nodes.Last().Get();
+	std::atomic<uint32> found{0};
+
+	//all threads go through the same nodes, so copies contend on the same reference counts
+	const auto measure_on_all_threads = [&](auto&& func)
+	{
+		return MeasureExecutionTime(1, [&]()
+		{
+			ParallelFor(shared_map_threads, [&](int32)
+			{
+				uint32 thread_found = 0;
+				for (uint32 i = 0; i < shared_map_repetitions; ++i)
+				{
+					thread_found += func();
+				}
+				found += thread_found;
+			});
+		});
+	};
+
+	const auto get_shared_next = [](MockLinkNode* node) { return node->m_shared_next.Get(); };
+	const auto get_exec_time = measure_on_all_threads([&]()
+	{
+		return TOptionalPtr<MockLinkNode>(root)
+			.MapStatic(get_shared_next)
+			.MapStatic(get_shared_next)
+			.MapStatic(get_shared_next)
+			.IsSet();
+	});
+
+	const auto copy_shared_next = [](MockLinkNode* node)
+	{
+		const TSharedPtr<MockLinkNode, ESPMode::ThreadSafe> next = node->m_shared_next;
+		return next.Get();
+	};
+	const auto copy_exec_time = measure_on_all_threads([&]()
+	{
+		return TOptionalPtr<MockLinkNode>(root)
+			.MapStatic(copy_shared_next)
+			.MapStatic(copy_shared_next)
+			.MapStatic(copy_shared_next)
+			.IsSet();
+	});
+
+	const auto map_exec_time = measure_on_all_threads([&]()
+	{
+		return TOptionalPtr<MockLinkNode>(root)
+			.Map(&MockLinkNode::m_shared_next)
+			.Map(&MockLinkNode::m_shared_next)
+			.Map(&MockLinkNode::m_shared_next)
+			.IsSet();
+	});
+
+	TestEqual("", found.load(), 3 * shared_map_threads * shared_map_repetitions);
+	AddInfo(FString::Printf(TEXT("Execution time for shared pointer Get approach: %f ns"), get_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for shared pointer copy approach: %f ns"), copy_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for shared pointer Map approach: %f ns"), map_exec_time));
+}
+
+#if defined(__cpp_impl_coroutine)
+const static uint32 coroutine_repetitions = 1000000;
+
+static MockLinkNode* RegularFlowNextOfNext(MockLinkNode* node)
+{
+	if (node == nullptr)
+		return nullptr;
+	MockLinkNode* next = node->m_next;
+	if (next == nullptr)
+		return nullptr;
+	MockLinkNode* next_of_next = next->GetNext();
+	if (next_of_next == nullptr)
+		return nullptr;
+	return next_of_next->m_next;
+}
+
+static TOptionalPtrCoroutine<MockLinkNode> CoroutineNextOfNext(MockLinkNode* node)
+{
+	MockLinkNode* checked_node = co_await node;
+	MockLinkNode* next = co_await checked_node->m_next;
+	MockLinkNode* next_of_next = co_await next->GetNext();
+	co_return next_of_next->m_next;
+}
+
+void CompareCoroutineExecutionTimes()
+{
+	TArray<MockLinkNode*> nodes;
+	for (int32 i = 0; i < 4; ++i)
+	{
+		nodes.Add(new MockLinkNode(i));
+		if (i > 0)
+		{
+			nodes[i]->m_next = nodes[i - 1];
+		}
+	}
+	uint32 found = 0;
+
+	//every other call exits early at the last hop
+	const auto regular_exec_time = MeasureExecutionTime(coroutine_repetitions, [&]()
+	{
+		found += RegularFlowNextOfNext(nodes[3]) != nullptr;
+		found += RegularFlowNextOfNext(nodes[2]) != nullptr;
+	});
+	const auto coroutine_exec_time = MeasureExecutionTime(coroutine_repetitions, [&]()
+	{
+		found += CoroutineNextOfNext(nodes[3]).IsSet();
+		found += CoroutineNextOfNext(nodes[2]).IsSet();
+	});
+	const auto map_exec_time = MeasureExecutionTime(coroutine_repetitions, [&]()
+	{
+		found += TOptionalPtr<MockLinkNode>(nodes[3]).Map(&MockLinkNode::m_next).Map(&MockLinkNode::GetNext).Map(&MockLinkNode::m_next).IsSet();
+		found += TOptionalPtr<MockLinkNode>(nodes[2]).Map(&MockLinkNode::m_next).Map(&MockLinkNode::GetNext).Map(&MockLinkNode::m_next).IsSet();
+	});
+
+	TestEqual("", found, 3 * coroutine_repetitions);
+	AddInfo(FString::Printf(TEXT("Execution time for regular approach: %f ns"), regular_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for coroutine approach: %f ns"), coroutine_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for Map approach: %f ns"), map_exec_time));
+
+	for (const auto node : nodes)
+	{
+		delete node;
+	}
+}
+#endif
+
+const static int32 async_chains = 10000;
+const static int32 async_assets = 100;
+
+void CompareAsyncChainMemory()
+{
+	TOptionalPtrAsyncLoader<FOptionalPtrMockLoader> loader;
+	TArray<UMockUObject*> objects;
+	for (int32 i = 0; i < async_assets; ++i)
+	{
+		const FSoftObjectPath path(FString::Printf(TEXT("/Game/Mock/Asset%d.Asset%d"), i, i));
+		UMockUObject* root = NewObject<UMockUObject>();
+		root->m_soft_link = TSoftObjectPtr<UMockUObject>(path);
+		UMockUObject* asset = NewObject<UMockUObject>();
+		loader.GetLoader().Assets.Add(path, asset);
+		objects.Add(root);
+		objects.Add(asset);
+	}
+	int32 found = 0;
+
+	//chains of the same root load the same asset, so only one load per asset is requested
+	const uint64 used_memory = FPlatformMemory::GetStats().UsedPhysical;
+	const auto issue_exec_time = MeasureExecutionTime(1, [&]()
+	{
+		for (int32 i = 0; i < async_chains; ++i)
+		{
+			TOptionalPtr<UMockUObject>(objects[i % async_assets * 2])
+				.MapAsync(&UMockUObject::m_soft_link, loader)
+				.Map(&MockObject::m_field)
+				.Then([&found](TOptionalPtr<SimpleObject> obj)
+				{
+					found += obj.IsSet();
+				});
+		}
+	});
+	const uint64 pending_memory = FPlatformMemory::GetStats().UsedPhysical - used_memory;
+
+	const auto complete_exec_time = MeasureExecutionTime(1, [&]()
+	{
+		loader.GetLoader().Tick();
+	});
+
+	TestEqual("", found, async_chains);
+	TestEqual("", loader.GetLoader().NumRequests, async_assets);
+	AddInfo(FString::Printf(TEXT("Execution time for issuing the chains: %f ns"), issue_exec_time));
+	AddInfo(FString::Printf(TEXT("Execution time for completing the chains: %f ns"), complete_exec_time));
+	AddInfo(FString::Printf(TEXT("Memory per pending chain: %f B"), static_cast<double>(pending_memory) / async_chains));
+
+	for (const auto obj : objects)
+	{
+		obj->Destroy();
+	}
+}
+END_DEFINE_SPEC(FOptionalPtrPerformanceSpec)
+
+void FOptionalPtrPerformanceSpec::Define()
+{
+	Describe("Map", [this]()
+	{
+		Describe("when given a wrapped UObject pointer", [this]()
+		{
+			It(FString::Printf(TEXT("should log the performance for 1 call with validation over %u repetitions"),
+				num_of_repetitions), [this]()
+			{
+				CompareExecutionTimes<1>();
+			});
+			It(FString::Printf(TEXT("should log the performance for 2 calls with validation over %u repetitions"),
+				num_of_repetitions), [this]()
+			{
+				CompareExecutionTimes<2>();
+			});
+			It(FString::Printf(TEXT("should log the performance for 3 calls with validation over %u repetitions"),
+				num_of_repetitions), [this]()
+			{
+				CompareExecutionTimes<3>();
+			});
+			It(FString::Printf(TEXT("should log the performance for 4 calls with validation over %u repetitions"),
+				num_of_repetitions), [this]()
+			{
+				CompareExecutionTimes<4>();
+			});
+		});
+		Describe("when given a wrapped non-UObject pointer", [this]()
+		{
+			It(FString::Printf(TEXT("should log the performance for 1 call with validation over %u repetitions"),
+				num_of_repetitions), [this]()
+			{
+				CompareExecutionTimes<1, false>();
+			});
+			It(FString::Printf(TEXT("should log the performance for 2 calls with validation over %u repetitions"),
+				num_of_repetitions), [this]()
+			{
+				CompareExecutionTimes<2, false>();
+			});
+			It(FString::Printf(TEXT("should log the performance for 3 calls with validation over %u repetitions"),
+				num_of_repetitions), [this]()
+			{
+				CompareExecutionTimes<3, false>();
+			});
+			It(FString::Printf(TEXT("should log the performance for 4 calls with validation over %u repetitions"),
+				num_of_repetitions), [this]()
+			{
+				CompareExecutionTimes<4, false>();
+			});
+		});
+	});
+	Describe("Walk", [this]()
+	{
+		Describe("when given a wrapped non-UObject pointer", [this]()
+		{
+			It(FString::Printf(TEXT("should log the performance for walking %d deep linked list over %u repetitions"),
+				walk_chain_length, walk_repetitions), [this]()
+			{
+				CompareWalkExecutionTimes();
+			});
+		});
+	});
+	Describe("MapFind", [this]()
+	{
+		It(FString::Printf(TEXT("should log the performance for looking up the same key in %d objects over %u repetitions"),
+			map_find_objects, map_find_repetitions), [this]()
+		{
+			CompareMapFindExecutionTimes();
+		});
+	});
+	Describe("AncestorCache", [this]()
+	{
+		It(FString::Printf(TEXT("should log the performance for %d nodes %d levels deep scene graph over %u repetitions"),
+			scene_graph_levels * scene_graph_nodes_per_level, scene_graph_levels, ancestor_lookup_repetitions), [this]()
+		{
+			CompareAncestorLookupExecutionTimes(16 * 1024 * 1024);
+		});
+		It(FString::Printf(TEXT("should log the performance for %d nodes %d levels deep scene graph with cache fitting quarter of the nodes over %u repetitions"),
+			scene_graph_levels * scene_graph_nodes_per_level, scene_graph_levels, ancestor_lookup_repetitions), [this]()
+		{
+			CompareAncestorLookupExecutionTimes(scene_graph_levels * scene_graph_nodes_per_level / 4 * TOptionalPtrAncestorCache<MockLinkNode>::BytesPerEntry);
+		});
+	});
+	Describe("Chain", [this]()
+	{
+		It(FString::Printf(TEXT("should log the performance for 4 hops long chain over %u repetitions"),
+			chain_repetitions), [this]()
+		{
+			CompareChainExecutionTimes();
+		});
+	});
+	Describe("PathResolver", [this]()
+	{
+		It(FString::Printf(TEXT("should log the performance for resolving 4 names long path over %u repetitions"),
+			path_resolve_repetitions), [this]()
+		{
+			ComparePathResolveExecutionTimes();
+		});
+	});
+	Describe("WeakPtr", [this]()
+	{
+		It(FString::Printf(TEXT("should log the performance for 3 hops through weak fields over %u repetitions"),
+			weak_map_repetitions), [this]()
+		{
+			CompareWeakMapExecutionTimes();
+		});
+	});
+	Describe("SharedPtr", [this]()
+	{
+		It(FString::Printf(TEXT("should log the performance for 3 hops through shared fields on %d threads over %u repetitions"),
+			shared_map_threads, shared_map_repetitions), [this]()
+		{
+			CompareSharedMapExecutionTimes();
+		});
+	});
+#if defined(__cpp_impl_coroutine)
+	Describe("Coroutine", [this]()
+	{
+		It(FString::Printf(TEXT("should log the performance for 3 hops with early exits over %u repetitions"),
+			coroutine_repetitions), [this]()
+		{
+			CompareCoroutineExecutionTimes();
+		});
+	});
+#endif
+	Describe("Scaling", [this]()
+	{
+		It(FString::Printf(TEXT("should log the performance for 1 to %d threads with %d chains each"), scaling_max_threads, scaling_chains_per_thread),
+			[this]()
+		{
+			CompareScalingExecutionTimes();
+		});
+	});
+	Describe("MapSnapshot", [this]()
+	{
+		It(FString::Printf(TEXT("should log the performance for 1 writer and %d readers with %d reads each"), seq_lock_readers, seq_lock_reads_per_thread),
+			[this]()
+		{
+			CompareSeqLockExecutionTimes();
+		});
+	});
+	Describe("MapAtomic", [this]()
+	{
+		It(FString::Printf(TEXT("should log the performance for %d reads"), atomic_reads), [this]()
+		{
+			CompareAtomicExecutionTimes();
+		});
+	});
+	Describe("Snapshot", [this]()
+	{
+		It(FString::Printf(TEXT("should log the performance of building snapshot of %d roots"), snapshot_roots), [this]()
+		{
+			CompareSnapshotBuildTimes();
+		});
+		for (int32 num_threads = 1; num_threads <= snapshot_threads; num_threads *= 4)
+		{
+			It(FString::Printf(TEXT("should log the performance for %d readers with %d reads each"), num_threads, snapshot_reads_per_thread),
+				[this, num_threads]()
+			{
+				CompareSnapshotReadTimes(num_threads);
+			});
+		}
+	});
+	Describe("HazardDomain", [this]()
+	{
+		It(FString::Printf(TEXT("should log the performance for %d reads"), hazard_reads), [this]()
+		{
+			CompareHazardExecutionTimes();
+		});
+		It(FString::Printf(TEXT("should log the reclamation of %d objects with stalled reader"), hazard_retired_objects), [this]()
+		{
+			CompareStalledReclamation();
+		});
+	});
+	Describe("EpochDomain", [this]()
+	{
+		for (int32 num_threads = 1; num_threads <= epoch_threads; num_threads *= 4)
+		{
+			It(FString::Printf(TEXT("should log the performance for %d threads with %d reads each"), num_threads, epoch_reads_per_thread),
+				[this, num_threads]()
+			{
+				CompareEpochExecutionTimes(num_threads);
+			});
+		}
+	});
+	Describe("Binding", [this]()
+	{
+		It(FString::Printf(TEXT("should log the performance for %d bindings over %d frames"), num_bindings, binding_frames), [this]()
+		{
+			CompareBindingExecutionTimes(&MockVersionedNode::GetNext, TEXT("getter"));
+			CompareBindingExecutionTimes(&MockVersionedNode::FindNext, TEXT("lookup"));
+		});
+	});
+	Describe("TimeSlicer", [this]()
+	{
+		It(FString::Printf(TEXT("should log the performance for %d elements"), time_sliced_elements), [this]()
+		{
+			CompareTimeSlicedExecutionTimes();
+		});
+	});
+	Describe("IfPresentAll", [this]()
+	{
+		for (int32 num_objects = 1000; num_objects <= parallel_max_objects; num_objects *= 10)
+		{
+			It(FString::Printf(TEXT("should log the performance for %d objects"), num_objects), [this, num_objects]()
+			{
+				CompareParallelExecutionTimes(num_objects);
+			});
+		}
+	});
+	Describe("RequestQueue", [this]()
+	{
+		It(FString::Printf(TEXT("should log the performance for %d threads with %d requests each"),
+			request_threads, requests_per_thread), [this]()
+		{
+			CompareRequestQueueExecutionTimes();
+		});
+	});
+	Describe("IfPresentDeferred", [this]()
+	{
+		It(FString::Printf(TEXT("should log the performance for %d calls on scattered objects over %u repetitions"),
+			deferred_calls, deferred_repetitions), [this]()
+		{
+			CompareDeferredExecutionTimes();
+		});
+	});
+	Describe("GetResult", [this]()
+	{
+		It(FString::Printf(TEXT("should log the performance for 4 calls on UObject over %u repetitions"),
+			num_of_repetitions), [this]()
+		{
+			CompareResultExecutionTimes<UMockUObject>();
+		});
+		It(FString::Printf(TEXT("should log the performance for 4 calls on non-UObject over %u repetitions"),
+			num_of_repetitions), [this]()
+		{
+			CompareResultExecutionTimes<MockNonUObject>();
+		});
+	});
+	Describe("MapAsync", [this]()
+	{
+		It(FString::Printf(TEXT("should log the memory for %d pending chains loading %d assets"),
+			async_chains, async_assets), [this]()
+		{
+			CompareAsyncChainMemory();
+		});
+	});
 }
\ No newline at end of file
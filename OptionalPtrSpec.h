@@ -1,131 +1,762 @@
-﻿#pragma once
-
-#include "CoreMinimal.h"
-#include "OptionalPtrSpec.generated.h"
-
-class MockUtils;
-
-enum class MethodEnum
-{
-	Method,
-	MethodConst,
-	ConstMethod,
-	ConstMethodConst,
-	ConstPointerMethod,
-	ConstPointerMethodConst,
-	OverloadedMethod,
-	Default
-};
-
-class SimpleObject
-{
-public:
-	const MethodEnum func_name;
-	
-	SimpleObject() : func_name( MethodEnum::Default ) {}
-
-	SimpleObject(const MethodEnum& func_name) : func_name{ func_name } {}
-
-	bool operator==(const SimpleObject& rhs) const
-	{
-		return func_name == rhs.func_name;
-	}
-	bool operator!=(const SimpleObject& rhs) const
-	{
-		return !operator==(rhs);
-	}
-};
-
-class KEATON_API MockObject
-{
-	mutable TArray<SimpleObject*> allocated;
-
-	SimpleObject* Create(MethodEnum method_enum = MethodEnum::Default) const
-	{
-		auto simple_object = new SimpleObject(method_enum);
-		allocated.Add(simple_object);
-		return simple_object;
-	}
-public:
-	virtual ~MockObject()
-	{
-		for (const auto elem : allocated)
-		{
-			delete elem;
-		}
-	}
-
-	virtual void Destroy() = 0;
-	
-	SimpleObject* Method() { return Create(MethodEnum::Method); }
-	SimpleObject* MethodConst() const { return Create(MethodEnum::MethodConst); }
-	const SimpleObject* ConstMethod() { return Create(MethodEnum::ConstMethod); }
-	const SimpleObject* ConstMethodConst() const { return Create(MethodEnum::ConstMethodConst); }
-	SimpleObject* const ConstPointerMethod() { return Create(MethodEnum::ConstPointerMethod); }
-	SimpleObject* const ConstPointerMethodConst() const { return Create(MethodEnum::ConstPointerMethodConst); }
-
-	SimpleObject* MethodWithParamCopy(SimpleObject) { return Create(); }
-	SimpleObject* MethodWithParamPointer(SimpleObject*) { return Create(); }
-	SimpleObject* MethodWithConstParamPointer(const SimpleObject*) { return Create(); }
-	SimpleObject* MethodWithConstParamRef(const SimpleObject&) { return Create(); }
-	SimpleObject* MethodWithParamRef(SimpleObject&) { return Create(); }
-	SimpleObject* MethodWithParamRValue(SimpleObject&&) { return Create(); }
-	SimpleObject* MethodWithMultipleParams(SimpleObject, int, float) { return Create(); }
-
-	SimpleObject* OverloadedMethod() { return Create(MethodEnum::OverloadedMethod); }
-	SimpleObject* OverloadedMethod(bool& executed)
-	{
-		executed = true;
-		return Create(MethodEnum::OverloadedMethod);
-	}
-
-	void MethodConstWithParamRef(bool& method_executed) const { method_executed = true; }
-	void Method2WithParamRef(bool& method_executed) { method_executed = true; }
-
-	static SimpleObject* StaticFunction(MockObject*) { return new SimpleObject(); }
-	static SimpleObject* StaticFunctionWithParamCopy(MockObject*, SimpleObject) { return new SimpleObject(); }
-	static SimpleObject* StaticFunctionWithConstParamRef(MockObject*, const SimpleObject&) { return new SimpleObject(); }
-
-	static SimpleObject* OverloadedStaticFunction(MockObject*) { return new SimpleObject(); }
-	static SimpleObject* OverloadedStaticFunction(MockObject*, bool& executed)
-	{
-		executed = true;
-		return new SimpleObject();
-	}
-
-	SimpleObject* m_field = Create();
-	const SimpleObject* m_const_field = Create();
-	SimpleObject* const m_field_const = Create();
-};
-
-UCLASS()
-class KEATON_API UMockUObject : public UObject, public MockObject
-{
-	class MockUtils;
-	
-	GENERATED_BODY()
-public:
-	UMockUObject* GetRandomObject(UMockUObject* obj1, UMockUObject* obj2)
-	{
-		return FMath::RandBool() ? obj1 : obj2;
-	}
-
-	virtual void Destroy() override
-	{
-		this->ConditionalBeginDestroy();
-	}
-};
-
-class KEATON_API MockNonUObject : public MockObject
-{
-public:
-	MockNonUObject* GetRandomObject(MockNonUObject* obj1, MockNonUObject* obj2)
-	{
-		return FMath::RandBool() ? obj1 : obj2;
-	}
-	
-	virtual void Destroy() override
-	{
-		delete this;
-	}
+﻿#pragma once
+
+#include <atomic>
+#include <memory>
+#include <new>
+
+#include "CoreMinimal.h"
+#include "OptionalPtr.h"
+#include "OptionalPtrHazard.h"
+#include "OptionalPtrPathResolver.h"
+#include "OptionalPtrSpec.generated.h"
+
+class MockUtils;
+
+enum class MethodEnum
+{
+	Method,
+	MethodConst,
+	ConstMethod,
+	ConstMethodConst,
+	ConstPointerMethod,
+	ConstPointerMethodConst,
+	OverloadedMethod,
+	Default
+};
+
+class SimpleObject
+{
+public:
+	const MethodEnum func_name;
+	
+	SimpleObject() : func_name( MethodEnum::Default ) {}
+
+	SimpleObject(const MethodEnum& func_name) : func_name{ func_name } {}
+
+	bool operator==(const SimpleObject& rhs) const
+	{
+		return func_name == rhs.func_name;
+	}
+	bool operator!=(const SimpleObject& rhs) const
+	{
+		return !operator==(rhs);
+	}
+};
+
+/**
+ * Pointer counting how many times it was resolved
+ * @tparam bValidatedPtr whether the resolved object is already validated, like the one of weak pointer
+ */
+template<typename ObjectType, bool bValidatedPtr>
+class MockCountingPtr
+{
+public:
+	static int32 NumResolves;
+
+	ObjectType* m_obj = nullptr;
+
+	ObjectType* Get() const
+	{
+		++NumResolves;
+		return m_obj;
+	}
+};
+
+template<typename ObjectType, bool bValidatedPtr>
+int32 MockCountingPtr<ObjectType, bValidatedPtr>::NumResolves = 0;
+
+template<typename Type, bool bValidatedPtr>
+struct TOptionalPtrResolver<MockCountingPtr<Type, bValidatedPtr>>
+{
+	using ObjectType = Type;
+	static constexpr bool bValidated = bValidatedPtr;
+	static constexpr bool bBorrowed = false;
+
+	static Type* Resolve(const MockCountingPtr<Type, bValidatedPtr>& ptr)
+	{
+		return ptr.Get();
+	}
+};
+
+/** Stand-in for TObjectPtr of editor builds */
+template<typename ObjectType>
+using MockObjectPtr = MockCountingPtr<ObjectType, false>;
+
+/** Stand-in for weak pointers */
+template<typename ObjectType>
+using MockWeakPtr = MockCountingPtr<ObjectType, true>;
+
+/**
+ * Allocator of the objects created by the mocks. Each thread allocates from its own arena, so the mocks can be used by
+ * multiple threads at once, and the arenas of different threads don't share cache lines. All the objects are freed
+ * together when the allocator is destroyed.
+ */
+template<typename ObjectType>
+class TMockArenaAllocator
+{
+	static constexpr int32 ChunkSize = 64;
+
+	struct FChunk
+	{
+		alignas(ObjectType) uint8 Storage[ChunkSize][sizeof(ObjectType)];
+	};
+
+	struct alignas(64) FArena
+	{
+		uint32 ThreadId;
+		FArena* Next;
+		TArray<FChunk*> Chunks;
+		int32 NumInLastChunk = ChunkSize;
+	};
+
+public:
+	TMockArenaAllocator() = default;
+	TMockArenaAllocator(const TMockArenaAllocator&) = delete;
+	TMockArenaAllocator& operator=(const TMockArenaAllocator&) = delete;
+
+	~TMockArenaAllocator()
+	{
+		for (FArena* arena = m_arenas.load(std::memory_order_acquire); arena != nullptr; )
+		{
+			for (int32 i = 0; i < arena->Chunks.Num(); ++i)
+			{
+				const int32 num_objects = i == arena->Chunks.Num() - 1 ? arena->NumInLastChunk : ChunkSize;
+				for (int32 j = 0; j < num_objects; ++j)
+				{
+					reinterpret_cast<ObjectType*>(arena->Chunks[i]->Storage[j])->~ObjectType();
+				}
+				delete arena->Chunks[i];
+			}
+			FArena* const next = arena->Next;
+			delete arena;
+			arena = next;
+		}
+	}
+
+	template<typename... Args>
+	ObjectType* Allocate(Args&&... args)
+	{
+		FArena& arena = GetArena();
+		if (arena.NumInLastChunk == ChunkSize)
+		{
+			arena.Chunks.Add(new FChunk());
+			arena.NumInLastChunk = 0;
+		}
+		return new (arena.Chunks.Last()->Storage[arena.NumInLastChunk++]) ObjectType(std::forward<Args>(args)...);
+	}
+
+private:
+	const uint64 m_id = NextId();
+	std::atomic<FArena*> m_arenas{nullptr};
+
+	static uint64 NextId()
+	{
+		static std::atomic<uint64> next_id{0};
+		return ++next_id;
+	}
+
+	FArena& GetArena()
+	{
+		//the arena of the allocator used last by the thread is cached, the ids are never reused unlike the addresses
+		static thread_local uint64 cached_id = 0;
+		static thread_local FArena* cached_arena = nullptr;
+		if (cached_id == m_id)
+			return *cached_arena;
+
+		const uint32 thread_id = FPlatformTLS::GetCurrentThreadId();
+		FArena* arena = m_arenas.load(std::memory_order_acquire);
+		while (arena != nullptr && arena->ThreadId != thread_id)
+		{
+			arena = arena->Next;
+		}
+		if (arena == nullptr)
+		{
+			arena = new FArena{thread_id, m_arenas.load(std::memory_order_relaxed)};
+			while (!m_arenas.compare_exchange_weak(arena->Next, arena, std::memory_order_release, std::memory_order_relaxed)) {}
+		}
+		cached_id = m_id;
+		cached_arena = arena;
+		return *arena;
+	}
+};
+
+class KEATON_API MockObject
+{
+	mutable TMockArenaAllocator<SimpleObject> allocator;
+
+	SimpleObject* Create(MethodEnum method_enum = MethodEnum::Default) const
+	{
+		return allocator.Allocate(method_enum);
+	}
+public:
+	MockObject()
+	{
+		m_entries.Add(TEXT("Method"), Create(MethodEnum::Method));
+		m_entries.Add(TEXT("Default"), Create());
+		m_value_entries.Add(TEXT("Method"), SimpleObject(MethodEnum::Method));
+		m_named_entries.Add(FOptionalPtrName(TEXT("Method")), Create(MethodEnum::Method));
+		m_named_entries.Add(FOptionalPtrName(TEXT("Default")), Create());
+	}
+
+	virtual ~MockObject() = default;
+
+	virtual void Destroy() = 0;
+	
+	SimpleObject* Method() { return Create(MethodEnum::Method); }
+	SimpleObject* MethodConst() const { return Create(MethodEnum::MethodConst); }
+	const SimpleObject* ConstMethod() { return Create(MethodEnum::ConstMethod); }
+	const SimpleObject* ConstMethodConst() const { return Create(MethodEnum::ConstMethodConst); }
+	SimpleObject* const ConstPointerMethod() { return Create(MethodEnum::ConstPointerMethod); }
+	SimpleObject* const ConstPointerMethodConst() const { return Create(MethodEnum::ConstPointerMethodConst); }
+
+	SimpleObject* MethodWithParamCopy(SimpleObject) { return Create(); }
+	SimpleObject* MethodWithParamPointer(SimpleObject*) { return Create(); }
+	SimpleObject* MethodWithConstParamPointer(const SimpleObject*) { return Create(); }
+	SimpleObject* MethodWithConstParamRef(const SimpleObject&) { return Create(); }
+	SimpleObject* MethodWithParamRef(SimpleObject&) { return Create(); }
+	SimpleObject* MethodWithParamRValue(SimpleObject&&) { return Create(); }
+	SimpleObject* MethodWithMultipleParams(SimpleObject, int, float) { return Create(); }
+
+	SimpleObject* OverloadedMethod() { return Create(MethodEnum::OverloadedMethod); }
+	SimpleObject* OverloadedMethod(bool& executed)
+	{
+		executed = true;
+		return Create(MethodEnum::OverloadedMethod);
+	}
+
+	void MethodConstWithParamRef(bool& method_executed) const { method_executed = true; }
+	void Method2WithParamRef(bool& method_executed) { method_executed = true; }
+	void MethodWithParamPointerCounter(int32* num_calls) { ++*num_calls; }
+
+	static SimpleObject* StaticFunction(MockObject*) { return new SimpleObject(); }
+	static SimpleObject* StaticFunctionWithParamCopy(MockObject*, SimpleObject) { return new SimpleObject(); }
+	static SimpleObject* StaticFunctionWithConstParamRef(MockObject*, const SimpleObject&) { return new SimpleObject(); }
+
+	static SimpleObject* OverloadedStaticFunction(MockObject*) { return new SimpleObject(); }
+	static SimpleObject* OverloadedStaticFunction(MockObject*, bool& executed)
+	{
+		executed = true;
+		return new SimpleObject();
+	}
+
+	SimpleObject* m_field = Create();
+	const SimpleObject* m_const_field = Create();
+	SimpleObject* const m_field_const = Create();
+
+	TArray<SimpleObject*> m_items = {Create(MethodEnum::Method), nullptr};
+	TArray<SimpleObject> m_values = {SimpleObject(MethodEnum::Method)};
+	TMap<FString, SimpleObject*> m_entries;
+	TMap<FString, SimpleObject> m_value_entries;
+	TMap<FOptionalPtrName, SimpleObject*> m_named_entries;
+
+	const TArray<SimpleObject*>& GetItems() const { return m_items; }
+	const TMap<FString, SimpleObject*>& GetEntries() const { return m_entries; }
+};
+
+UCLASS()
+class KEATON_API UMockUObject : public UObject, public MockObject
+{
+	class MockUtils;
+	
+	GENERATED_BODY()
+public:
+	TWeakObjectPtr<UMockUObject> m_weak_link;
+	MockObjectPtr<UMockUObject> m_handle_link;
+	TSoftObjectPtr<UMockUObject> m_soft_link;
+#if ENGINE_MAJOR_VERSION >= 5
+	TObjectPtr<UMockUObject> m_object_link;
+#endif
+
+	const TWeakObjectPtr<UMockUObject>& GetWeakLink() const { return m_weak_link; }
+	const MockObjectPtr<UMockUObject>& GetHandleLink() const { return m_handle_link; }
+
+	UMockUObject* GetRandomObject(UMockUObject* obj1, UMockUObject* obj2)
+	{
+		return FMath::RandBool() ? obj1 : obj2;
+	}
+
+	virtual void Destroy() override
+	{
+		this->ConditionalBeginDestroy();
+	}
+};
+
+class KEATON_API MockNonUObject : public MockObject
+{
+public:
+	MockNonUObject* GetRandomObject(MockNonUObject* obj1, MockNonUObject* obj2)
+	{
+		return FMath::RandBool() ? obj1 : obj2;
+	}
+	
+	virtual void Destroy() override
+	{
+		delete this;
+	}
+};
+
+UCLASS()
+class KEATON_API UMockAncestorUObject : public UMockUObject
+{
+	GENERATED_BODY()
+};
+
+UCLASS()
+class KEATON_API UMockVersionedUObject : public UMockUObject
+{
+	GENERATED_BODY()
+
+public:
+	/** Outer never changes after construction */
+	uint32 GetOptionalPtrVersion() const { return 0; }
+};
+
+/**
+ * Loader completing requested loads after the given number of ticks, assets are registered by their paths
+ */
+struct FOptionalPtrMockLoader
+{
+	struct FRequest
+	{
+		FSoftObjectPath Path;
+		int32 RemainingTicks;
+		TFunction<void()> OnLoaded;
+	};
+
+	TMap<FSoftObjectPath, UObject*> Assets;
+	TArray<FRequest> Requests;
+	int32 Latency = 1;
+	int32 NumRequests = 0;
+
+	template<typename FuncType>
+	void RequestLoad(const FSoftObjectPath& path, FuncType&& on_loaded)
+	{
+		++NumRequests;
+		Requests.Add(FRequest{path, Latency, std::forward<FuncType>(on_loaded)});
+	}
+
+	UObject* Resolve(const FSoftObjectPath& path) const
+	{
+		UObject* const* asset = Assets.Find(path);
+		return asset != nullptr ? *asset : nullptr;
+	}
+
+	void Tick()
+	{
+		TArray<TFunction<void()>> loaded;
+		for (int32 i = Requests.Num() - 1; i >= 0; --i)
+		{
+			if (--Requests[i].RemainingTicks <= 0)
+			{
+				loaded.Add(MoveTemp(Requests[i].OnLoaded));
+				Requests.RemoveAtSwap(i);
+			}
+		}
+		for (TFunction<void()>& on_loaded : loaded)
+		{
+			on_loaded();
+		}
+	}
+};
+
+/**
+ * Shared pointer counting how many times its reference count would change
+ */
+template<typename ObjectType>
+class MockSharedPtr
+{
+public:
+	static int32 NumRefCountChanges;
+
+	ObjectType* m_obj = nullptr;
+
+	MockSharedPtr() = default;
+	MockSharedPtr(const MockSharedPtr& other) : m_obj{other.m_obj} { ++NumRefCountChanges; }
+	~MockSharedPtr() { NumRefCountChanges += m_obj != nullptr; }
+
+	MockSharedPtr& operator=(const MockSharedPtr& other)
+	{
+		NumRefCountChanges += 2;
+		m_obj = other.m_obj;
+		return *this;
+	}
+};
+
+template<typename ObjectType>
+int32 MockSharedPtr<ObjectType>::NumRefCountChanges = 0;
+
+template<typename Type>
+struct TOptionalPtrResolver<MockSharedPtr<Type>>
+{
+	using ObjectType = Type;
+	static constexpr bool bValidated = false;
+	static constexpr bool bBorrowed = true;
+
+	static Type* Resolve(const MockSharedPtr<Type>& ptr)
+	{
+		return ptr.m_obj;
+	}
+};
+
+class KEATON_API MockLinkNode
+{
+public:
+	MockLinkNode* m_next = nullptr;
+	std::weak_ptr<MockLinkNode> m_weak_next;
+	MockWeakPtr<MockLinkNode> m_counted_next;
+	TSharedPtr<MockLinkNode, ESPMode::ThreadSafe> m_shared_next;
+	std::shared_ptr<MockLinkNode> m_std_shared_next;
+	TUniquePtr<MockLinkNode> m_unique_next;
+	MockSharedPtr<MockLinkNode> m_counted_shared_next;
+	int32 m_value = 0;
+	TArray<int32> m_log;
+	mutable int32 m_num_next_calls = 0;
+
+	MockLinkNode(int32 value = 0) : m_value{value} {}
+	virtual ~MockLinkNode() = default;
+
+	MockLinkNode* GetNext() const { return m_next; }
+	MockLinkNode* GetCountingNext() const { ++m_num_next_calls; return m_next; }
+	const MockWeakPtr<MockLinkNode>& GetCountedNext() const { return m_counted_next; }
+	const TSharedPtr<MockLinkNode, ESPMode::ThreadSafe>& GetSharedNext() const { return m_shared_next; }
+	const MockSharedPtr<MockLinkNode>& GetCountedSharedNext() const { return m_counted_shared_next; }
+	bool HasValue(int32 value) const { return m_value == value; }
+	void AddValue(int32 delta) { m_value += delta; }
+	void LogValue(TArray<int32>* log) const { log->Add(m_value); }
+	void LogValueToNext() const { m_next->m_log.Add(m_value); }
+};
+
+class KEATON_API MockAncestorLinkNode : public MockLinkNode
+{
+public:
+	using MockLinkNode::MockLinkNode;
+};
+
+/**
+ * Validity policy rejecting nodes with negative value, stands in for the policies checking more than nullptr
+ */
+struct FMockNonNegativePolicy
+{
+	using NextPolicy = FMockNonNegativePolicy;
+
+	static bool IsValidObj(const MockLinkNode* node)
+	{
+		return node != nullptr && node->m_value >= 0;
+	}
+};
+
+/**
+ * Node reclaimed by FOptionalPtrEpochDomain through m_next or by FOptionalPtrHazardDomain through m_hazard_next
+ */
+class KEATON_API MockReclaimedNode
+{
+public:
+	std::atomic<MockReclaimedNode*> m_next{nullptr};
+	TOptionalPtrHazardPtr<MockReclaimedNode> m_hazard_next;
+	int32 m_value = 1;
+	std::atomic<int32>* m_num_destroyed = nullptr;
+
+	~MockReclaimedNode()
+	{
+		m_value = INDEX_NONE;
+		if (m_num_destroyed != nullptr)
+			++*m_num_destroyed;
+	}
+
+	MockReclaimedNode* GetNext() const { return m_next.load(std::memory_order_acquire); }
+	const TOptionalPtrHazardPtr<MockReclaimedNode>& GetHazardNext() const { return m_hazard_next; }
+};
+
+class KEATON_API MockAtomicNode
+{
+public:
+	std::atomic<MockAtomicNode*> m_next{nullptr};
+	TAtomic<MockAtomicNode*> m_unreal_next{nullptr};
+	MockAtomicNode* m_raw_next = nullptr;
+	int32 m_value = 0;
+};
+
+class KEATON_API MockKinematicObject
+{
+public:
+	MockKinematicObject* m_next = nullptr;
+	FOptionalPtrSeqLock m_seq_lock;
+	FCriticalSection m_mutex;
+	double m_position = 0.0;
+	double m_velocity = 0.0;
+	int64 m_timestamp = 0;
+
+	void Write(int64 timestamp)
+	{
+		FOptionalPtrSeqLockWriteScope scope(m_seq_lock);
+		m_position = static_cast<double>(timestamp);
+		m_velocity = static_cast<double>(timestamp);
+		m_timestamp = timestamp;
+	}
+};
+
+class KEATON_API MockVersionedNode
+{
+public:
+	MockVersionedNode* GetNext() const { return m_next; }
+	uint32 GetOptionalPtrVersion() const { return m_version; }
+	void SetNext(MockVersionedNode* next) { m_next = next; ++m_version; }
+	void AddChild(MockVersionedNode* child) { m_children.Add(child); ++m_version; }
+
+	/** Stands in for lookups like FindComponentByClass */
+	MockVersionedNode* FindNext() const
+	{
+		for (MockVersionedNode* child : m_children)
+		{
+			if (child == m_next)
+				return child;
+		}
+		return nullptr;
+	}
+
+private:
+	MockVersionedNode* m_next = nullptr;
+	TArray<MockVersionedNode*> m_children;
+	uint32 m_version = 0;
+};
+
+struct FMockReflectedType;
+
+/** Reflected member of the mock types, stands in for FProperty and UFunction */
+struct FMockReflectedMember
+{
+	FString Name;
+	int32 ValueSize;
+	/** Returns the object the member points to, nullptr for values */
+	void* (*LoadObject)(void*);
+	/** Returns address of the value, nullptr for objects */
+	void* (*ValueAddress)(void*);
+	/** Type of the object the member points to, nullptr for values */
+	const FMockReflectedType* Type;
+	const void* ValueTypeKey;
+};
+
+/** Reflected type of the mock objects, stands in for UClass */
+struct FMockReflectedType
+{
+	TArray<FMockReflectedMember> Members;
+};
+
+class KEATON_API MockReflectedObject
+{
+public:
+	virtual ~MockReflectedObject() = default;
+	virtual const FMockReflectedType& GetReflectedType() const = 0;
+};
+
+/** Reflection policy of TOptionalPtrPathResolver over the mock reflected types, members are found by name like FindPropertyByName does */
+struct FOptionalPtrMockReflection
+{
+	using ObjectType = MockReflectedObject;
+
+	static const void* GetType(const MockReflectedObject* obj)
+	{
+		return &obj->GetReflectedType();
+	}
+
+	static bool IsValidObj(const void* obj)
+	{
+		return obj != nullptr;
+	}
+
+	template<typename ValueType>
+	static const void* GetValueTypeKey()
+	{
+		static const uint8 value_type_key = 0;
+		return &value_type_key;
+	}
+
+	static bool CompileStep(const void* type, const FString& name, FOptionalPtrPathStep& out_step, const void*& out_next_type)
+	{
+		for (const FMockReflectedMember& member : static_cast<const FMockReflectedType*>(type)->Members)
+		{
+			if (member.Name == name)
+			{
+				out_step.Member = &member;
+				out_step.ValueSize = member.ValueSize;
+				out_step.ValueTypeKey = member.ValueTypeKey;
+				out_next_type = member.Type;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	static void* LoadObject(void* obj, const FOptionalPtrPathStep& step)
+	{
+		return static_cast<const FMockReflectedMember*>(step.Member)->LoadObject(obj);
+	}
+
+	static void LoadValue(void* obj, const FOptionalPtrPathStep& step, void* out_value)
+	{
+		FMemory::Memcpy(out_value, static_cast<const FMockReflectedMember*>(step.Member)->ValueAddress(obj), step.ValueSize);
+	}
+
+	template<typename CastType>
+	static CastType* CastObj(void* obj)
+	{
+		return dynamic_cast<CastType*>(static_cast<MockReflectedObject*>(obj));
+	}
+
+	/** Reflects the value field, member pointers are used as offsetof isn't defined for the polymorphic mocks */
+	template<typename ClassType, typename FieldType, FieldType ClassType::*Member>
+	static FMockReflectedMember Value(const FString& name)
+	{
+		return FMockReflectedMember{name, sizeof(FieldType), nullptr, [](void* obj) -> void*
+		{
+			return &(static_cast<ClassType*>(static_cast<MockReflectedObject*>(obj))->*Member);
+		}, nullptr, GetValueTypeKey<FieldType>()};
+	}
+
+	/** Reflects the object field */
+	template<typename ClassType, typename FieldType, FieldType* ClassType::*Member>
+	static FMockReflectedMember Object(const FString& name)
+	{
+		return FMockReflectedMember{name, sizeof(FieldType*), [](void* obj) -> void*
+		{
+			return static_cast<MockReflectedObject*>(static_cast<ClassType*>(static_cast<MockReflectedObject*>(obj))->*Member);
+		}, nullptr, &FieldType::StaticType(), nullptr};
+	}
+
+	/** Reflects the getter returning object */
+	template<typename ClassType, typename ResultType, ResultType* (ClassType::*Function)() const>
+	static FMockReflectedMember Getter(const FString& name)
+	{
+		return FMockReflectedMember{name, sizeof(ResultType*), [](void* obj) -> void*
+		{
+			return static_cast<MockReflectedObject*>((static_cast<ClassType*>(static_cast<MockReflectedObject*>(obj))->*Function)());
+		}, nullptr, &ResultType::StaticType(), nullptr};
+	}
+};
+
+class KEATON_API MockHealthComponent : public MockReflectedObject
+{
+public:
+	float m_health = 100.f;
+
+	static const FMockReflectedType& StaticType()
+	{
+		static const FMockReflectedType type{{
+			FOptionalPtrMockReflection::Value<MockHealthComponent, float, &MockHealthComponent::m_health>(TEXT("Health"))
+		}};
+		return type;
+	}
+
+	virtual const FMockReflectedType& GetReflectedType() const override { return StaticType(); }
+};
+
+class KEATON_API MockPawn : public MockReflectedObject
+{
+public:
+	MockHealthComponent* m_health_component = nullptr;
+
+	MockHealthComponent* GetHealthComponent() const { return m_health_component; }
+
+	static const FMockReflectedType& StaticType()
+	{
+		static const FMockReflectedType type{{
+			FOptionalPtrMockReflection::Getter<MockPawn, MockHealthComponent, &MockPawn::GetHealthComponent>(TEXT("HealthComponent"))
+		}};
+		return type;
+	}
+
+	virtual const FMockReflectedType& GetReflectedType() const override { return StaticType(); }
+};
+
+/** Subclass with a member its declared type doesn't reflect, stands in for pawn subclasses like ACharacter */
+class KEATON_API MockArmoredPawn : public MockPawn
+{
+public:
+	int32 m_armor = 50;
+
+	static const FMockReflectedType& StaticType()
+	{
+		static const FMockReflectedType type{{
+			FOptionalPtrMockReflection::Getter<MockPawn, MockHealthComponent, &MockPawn::GetHealthComponent>(TEXT("HealthComponent")),
+			FOptionalPtrMockReflection::Value<MockArmoredPawn, int32, &MockArmoredPawn::m_armor>(TEXT("Armor"))
+		}};
+		return type;
+	}
+
+	virtual const FMockReflectedType& GetReflectedType() const override { return StaticType(); }
+};
+
+class KEATON_API MockPlayerController : public MockReflectedObject
+{
+public:
+	MockPawn* m_pawn = nullptr;
+
+	static const FMockReflectedType& StaticType()
+	{
+		static const FMockReflectedType type{{
+			FOptionalPtrMockReflection::Object<MockPlayerController, MockPawn, &MockPlayerController::m_pawn>(TEXT("Pawn"))
+		}};
+		return type;
+	}
+
+	virtual const FMockReflectedType& GetReflectedType() const override { return StaticType(); }
+};
+
+class KEATON_API MockWorld : public MockReflectedObject
+{
+public:
+	MockPlayerController* m_first_player_controller = nullptr;
+	int32 m_num_players = 1;
+
+	MockPlayerController* GetFirstPlayerController() const { return m_first_player_controller; }
+
+	static const FMockReflectedType& StaticType()
+	{
+		static const FMockReflectedType type{{
+			FOptionalPtrMockReflection::Getter<MockWorld, MockPlayerController, &MockWorld::GetFirstPlayerController>(TEXT("FirstPlayerController")),
+			FOptionalPtrMockReflection::Value<MockWorld, int32, &MockWorld::m_num_players>(TEXT("NumPlayers"))
+		}};
+		return type;
+	}
+
+	virtual const FMockReflectedType& GetReflectedType() const override { return StaticType(); }
+};
+
+UCLASS()
+class KEATON_API UMockHealthComponent : public UObject
+{
+	GENERATED_BODY()
+public:
+	UPROPERTY()
+	float Health = 100.f;
+};
+
+UCLASS()
+class KEATON_API UMockPawn : public UObject
+{
+	GENERATED_BODY()
+};
+
+UCLASS()
+class KEATON_API UMockCharacter : public UMockPawn
+{
+	GENERATED_BODY()
+public:
+	UPROPERTY()
+	UMockHealthComponent* HealthComponent = nullptr;
+
+	UPROPERTY()
+	int32 Armor = 50;
+};
+
+UCLASS()
+class KEATON_API UMockPlayerController : public UObject
+{
+	GENERATED_BODY()
+public:
+	UPROPERTY()
+	UMockPawn* Pawn = nullptr;
+
+	UFUNCTION()
+	UMockPawn* GetControlledPawn() const { return Pawn; }
 };
\ No newline at end of file
@@ -0,0 +1,373 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+
+#include "CoreMinimal.h"
+
+//statistics of the chains per call site, compiled out unless enabled, e.g. by PublicDefinitions in Build.cs
+#ifndef OPTIONAL_PTR_STATS
+	#define OPTIONAL_PTR_STATS 0
+#endif
+
+#if OPTIONAL_PTR_STATS
+	#define OPTIONAL_PTR_STATS_ONLY(...) __VA_ARGS__
+#else
+	#define OPTIONAL_PTR_STATS_ONLY(...)
+#endif
+
+#if OPTIONAL_PTR_STATS
+
+#if defined(__has_include)
+	#if __has_include(<source_location>)
+		#include <source_location>
+	#endif
+#endif
+
+#if defined(__cpp_lib_source_location)
+using FOptionalPtrSourceLocation = std::source_location;
+#else
+/**
+ * Call site of the chain root before C++20, filled in by the builtins std::source_location is implemented with
+ */
+struct FOptionalPtrSourceLocation
+{
+	static FOptionalPtrSourceLocation current(const ANSICHAR* file = __builtin_FILE(), const ANSICHAR* function = __builtin_FUNCTION(),
+		uint32 line = __builtin_LINE())
+	{
+		return FOptionalPtrSourceLocation{file, function, line};
+	}
+
+	const ANSICHAR* file_name() const { return File; }
+	const ANSICHAR* function_name() const { return Function; }
+	uint32 line() const { return Line; }
+	uint32 column() const { return 0; }
+
+	const ANSICHAR* File;
+	const ANSICHAR* Function;
+	uint32 Line;
+};
+#endif
+
+/** Number of failure depths counted separately, failures at deeper steps are counted together in the last one */
+static constexpr int32 OptionalPtrStatsDepths = 16;
+
+/**
+ * Counters of chains started at one call site by one thread. Only the owning thread writes them, so they are
+ * incremented by a relaxed load and store, which compiles to plain instructions, and read by FOptionalPtrStats::Collect.
+ */
+struct FOptionalPtrStatsCounters
+{
+	const ANSICHAR* File;
+	const ANSICHAR* Function;
+	uint32 Line;
+	uint32 Column;
+	std::atomic<uint64> NumEvaluations{0};
+	std::atomic<uint64> NumSteps{0};
+	std::atomic<uint64> NumFailures{0};
+	std::atomic<uint64> FailuresAtDepth[OptionalPtrStatsDepths] = {};
+	FOptionalPtrStatsCounters* Next = nullptr;
+
+	FORCEINLINE static void Increment(std::atomic<uint64>& counter)
+	{
+		counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @param depth index of the step which didn't return valid object, 0 for the object the chain started with
+	 */
+	FORCEINLINE void AddFailure(uint8 depth)
+	{
+		Increment(NumFailures);
+		Increment(FailuresAtDepth[FMath::Min<int32>(depth, OptionalPtrStatsDepths - 1)]);
+	}
+};
+
+/**
+ * Statistics of the chains started at one call site, merged from all the threads
+ */
+struct FOptionalPtrSiteStats
+{
+	const ANSICHAR* File = nullptr;
+	const ANSICHAR* Function = nullptr;
+	uint32 Line = 0;
+	uint32 Column = 0;
+	/** Number of chains started at the site */
+	uint64 NumEvaluations = 0;
+	/** Number of steps which returned an object, the cost of the chains */
+	uint64 NumSteps = 0;
+	/** Number of chains which ended with invalid object */
+	uint64 NumFailures = 0;
+	/** Number of failures per index of the failed step, the last one counts all the deeper ones */
+	uint64 FailuresAtDepth[OptionalPtrStatsDepths] = {};
+
+	/**
+	 * @return ratio of the chains which failed, in range [0, 1]
+	 */
+	double GetFailureRate() const
+	{
+		return NumEvaluations > 0 ? static_cast<double>(NumFailures) / NumEvaluations : 0.0;
+	}
+};
+
+/**
+ * Order of the sites returned by FOptionalPtrStats
+ */
+enum class EOptionalPtrStatsSort : uint8
+{
+	/** Highest ratio of failed chains first, candidates for coroutines or early return macros */
+	FailureRate,
+	/** Most steps taken first */
+	TotalCost
+};
+
+/**
+ * Statistics of TOptionalPtr chains per call site of the chain root, enabled by OPTIONAL_PTR_STATS. Each thread counts
+ * into its own counters, which are merged only when the statistics are collected, so the chains never write shared
+ * memory. A failure is counted once the chain uses the invalid object, e.g. by its next step or Get.
+ */
+class FOptionalPtrStats
+{
+	//each thread gets its own record, aligned to keep the records of different threads on different cache lines
+	struct alignas(64) FRecord
+	{
+		/** Counters of all the sites, new ones are pushed by the owning thread and read by Collect */
+		std::atomic<FOptionalPtrStatsCounters*> Sites{nullptr};
+		std::atomic<bool> bInUse{true};
+		FRecord* Next = nullptr;
+		/** Open addressing table of the sites used only by the owning thread */
+		TArray<FOptionalPtrStatsCounters*> Table;
+		int32 NumSites = 0;
+		/** Site found last, chains are often started at the same site in a loop */
+		FOptionalPtrStatsCounters* LastSite = nullptr;
+	};
+
+	//releases the record when the thread exits, the next thread reusing it keeps adding to its counters
+	struct FThreadRecord
+	{
+		FRecord* Record = nullptr;
+
+		~FThreadRecord()
+		{
+			if (Record != nullptr)
+			{
+				Record->bInUse.store(false, std::memory_order_release);
+			}
+		}
+	};
+
+public:
+	/**
+	 * @brief Counts new chain started at the call site
+	 * @param location call site of the chain root
+	 * @return counters of the call site owned by the calling thread
+	 */
+	static FOptionalPtrStatsCounters* StartChain(const FOptionalPtrSourceLocation& location)
+	{
+		FOptionalPtrStatsCounters* const counters = Find(GetRecord(), location);
+		FOptionalPtrStatsCounters::Increment(counters->NumEvaluations);
+		return counters;
+	}
+
+	/**
+	 * @brief Merges the counters of all the threads, the chains running meanwhile are counted or not
+	 * @param sort order of the returned sites
+	 * @return statistics of all the call sites
+	 */
+	static TArray<FOptionalPtrSiteStats> Collect(EOptionalPtrStatsSort sort = EOptionalPtrStatsSort::FailureRate)
+	{
+		TArray<FOptionalPtrSiteStats> sites;
+		for (FRecord* record = GetRecords().load(std::memory_order_acquire); record != nullptr; record = record->Next)
+		{
+			for (FOptionalPtrStatsCounters* counters = record->Sites.load(std::memory_order_acquire); counters != nullptr; counters = counters->Next)
+			{
+				FOptionalPtrSiteStats site;
+				site.File = counters->File;
+				site.Function = counters->Function;
+				site.Line = counters->Line;
+				site.Column = counters->Column;
+				site.NumEvaluations = counters->NumEvaluations.load(std::memory_order_relaxed);
+				site.NumSteps = counters->NumSteps.load(std::memory_order_relaxed);
+				site.NumFailures = counters->NumFailures.load(std::memory_order_relaxed);
+				for (int32 depth = 0; depth < OptionalPtrStatsDepths; ++depth)
+				{
+					site.FailuresAtDepth[depth] = counters->FailuresAtDepth[depth].load(std::memory_order_relaxed);
+				}
+				sites.Add(site);
+			}
+		}
+
+		//the same site has different file name pointers in different translation units, so they are merged by the name
+		std::sort(sites.GetData(), sites.GetData() + sites.Num(), &IsSiteBefore);
+		int32 num_merged = 0;
+		for (int32 i = 0; i < sites.Num(); ++i)
+		{
+			if (num_merged > 0 && !IsSiteBefore(sites[num_merged - 1], sites[i]))
+			{
+				FOptionalPtrSiteStats& merged = sites[num_merged - 1];
+				merged.NumEvaluations += sites[i].NumEvaluations;
+				merged.NumSteps += sites[i].NumSteps;
+				merged.NumFailures += sites[i].NumFailures;
+				for (int32 depth = 0; depth < OptionalPtrStatsDepths; ++depth)
+				{
+					merged.FailuresAtDepth[depth] += sites[i].FailuresAtDepth[depth];
+				}
+			}
+			else
+			{
+				sites[num_merged++] = sites[i];
+			}
+		}
+		sites.SetNum(num_merged);
+
+		std::stable_sort(sites.GetData(), sites.GetData() + sites.Num(), [sort](const FOptionalPtrSiteStats& a, const FOptionalPtrSiteStats& b)
+		{
+			return sort == EOptionalPtrStatsSort::FailureRate ?
+				a.GetFailureRate() > b.GetFailureRate() :
+				a.NumSteps > b.NumSteps;
+		});
+		return sites;
+	}
+
+	/**
+	 * @brief Formats the statistics of the call sites, one line per site
+	 * @param sort order of the sites
+	 * @param max_sites maximum number of sites to format
+	 * @return formatted statistics, e.g. to log or to print to the console
+	 */
+	static FString Dump(EOptionalPtrStatsSort sort = EOptionalPtrStatsSort::FailureRate, int32 max_sites = 20)
+	{
+		const TArray<FOptionalPtrSiteStats> sites = Collect(sort);
+		FString dump;
+		for (int32 i = 0; i < sites.Num() && i < max_sites; ++i)
+		{
+			const FOptionalPtrSiteStats& site = sites[i];
+			FString depths;
+			for (int32 depth = 0; depth < OptionalPtrStatsDepths; ++depth)
+			{
+				if (site.FailuresAtDepth[depth] > 0)
+				{
+					depths += FString::Printf(TEXT(" %d%s:%llu"), depth, depth == OptionalPtrStatsDepths - 1 ? TEXT("+") : TEXT(""),
+						static_cast<unsigned long long>(site.FailuresAtDepth[depth]));
+				}
+			}
+			dump += FString::Printf(TEXT("%s:%u %s: %llu evaluations, %llu failures (%.2f %%), %llu steps, failed steps%s\n"),
+				ANSI_TO_TCHAR(site.File), site.Line, ANSI_TO_TCHAR(site.Function), static_cast<unsigned long long>(site.NumEvaluations),
+				static_cast<unsigned long long>(site.NumFailures), site.GetFailureRate() * 100.0, static_cast<unsigned long long>(site.NumSteps),
+				*depths);
+		}
+		return dump;
+	}
+
+private:
+	//records are never freed, released ones are reused by new threads
+	static std::atomic<FRecord*>& GetRecords()
+	{
+		static std::atomic<FRecord*> records{nullptr};
+		return records;
+	}
+
+	static bool IsSiteBefore(const FOptionalPtrSiteStats& a, const FOptionalPtrSiteStats& b)
+	{
+		const int32 file_order = FCStringAnsi::Strcmp(a.File, b.File);
+		if (file_order != 0)
+			return file_order < 0;
+		return a.Line != b.Line ? a.Line < b.Line : a.Column < b.Column;
+	}
+
+	FORCEINLINE static FRecord& GetRecord()
+	{
+		static thread_local FThreadRecord thread_record;
+		if (UNLIKELY(thread_record.Record == nullptr))
+		{
+			thread_record.Record = AcquireRecord();
+		}
+		return *thread_record.Record;
+	}
+
+	static FRecord* AcquireRecord()
+	{
+		for (FRecord* record = GetRecords().load(std::memory_order_acquire); record != nullptr; record = record->Next)
+		{
+			bool in_use = false;
+			if (!record->bInUse.load(std::memory_order_relaxed) && record->bInUse.compare_exchange_strong(in_use, true, std::memory_order_acquire))
+				return record;
+		}
+
+		FRecord* const record = new FRecord();
+		record->Table.SetNumZeroed(64);
+		FRecord* head = GetRecords().load(std::memory_order_relaxed);
+		do
+		{
+			record->Next = head;
+		}
+		while (!GetRecords().compare_exchange_weak(head, record, std::memory_order_release, std::memory_order_relaxed));
+		return record;
+	}
+
+	static uint32 HashSite(const ANSICHAR* file, uint32 line, uint32 column)
+	{
+		return HashCombine(PointerHash(file), HashCombine(line, column));
+	}
+
+	FORCEINLINE static FOptionalPtrStatsCounters* Find(FRecord& record, const FOptionalPtrSourceLocation& location)
+	{
+		const ANSICHAR* const file = location.file_name();
+		const uint32 line = location.line();
+		const uint32 column = location.column();
+		FOptionalPtrStatsCounters* const last_site = record.LastSite;
+		if (LIKELY(last_site != nullptr && last_site->Line == line && last_site->File == file && last_site->Column == column))
+			return last_site;
+
+		const int32 mask = record.Table.Num() - 1;
+		for (int32 i = HashSite(file, line, column) & mask; ; i = (i + 1) & mask)
+		{
+			FOptionalPtrStatsCounters* const counters = record.Table[i];
+			if (counters == nullptr)
+				return record.LastSite = Add(record, location);
+			if (counters->File == file && counters->Line == line && counters->Column == column)
+				return record.LastSite = counters;
+		}
+	}
+
+	static FOptionalPtrStatsCounters* Add(FRecord& record, const FOptionalPtrSourceLocation& location)
+	{
+		FOptionalPtrStatsCounters* const counters = new FOptionalPtrStatsCounters();
+		counters->File = location.file_name();
+		counters->Function = location.function_name();
+		counters->Line = location.line();
+		counters->Column = location.column();
+		counters->Next = record.Sites.load(std::memory_order_relaxed);
+		record.Sites.store(counters, std::memory_order_release);
+
+		//the table is kept at most half full
+		if (++record.NumSites * 2 > record.Table.Num())
+		{
+			TArray<FOptionalPtrStatsCounters*> table;
+			table.SetNumZeroed(record.Table.Num() * 2);
+			Swap(table, record.Table);
+			for (FOptionalPtrStatsCounters* site = record.Sites.load(std::memory_order_relaxed); site != nullptr; site = site->Next)
+			{
+				Insert(record, site);
+			}
+		}
+		else
+		{
+			Insert(record, counters);
+		}
+		return counters;
+	}
+
+	static void Insert(FRecord& record, FOptionalPtrStatsCounters* counters)
+	{
+		const int32 mask = record.Table.Num() - 1;
+		int32 i = HashSite(counters->File, counters->Line, counters->Column) & mask;
+		while (record.Table[i] != nullptr)
+		{
+			i = (i + 1) & mask;
+		}
+		record.Table[i] = counters;
+	}
+};
+
+#endif
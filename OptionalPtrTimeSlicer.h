@@ -0,0 +1,209 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OptionalPtr.h"
+#include "OptionalPtrChain.h"
+
+
+/**
+ * Statistics of the ticks of TOptionalPtrTimeSlicer
+ */
+struct FOptionalPtrTimeSliceStats
+{
+	/** Number of elements the chain was executed for */
+	int64 NumProcessed = 0;
+	/** Number of ticks which processed at least one element */
+	int32 NumTicks = 0;
+	/** Time spent by the ticks */
+	double TotalMicroseconds = 0.0;
+	/** Longest time a tick exceeded its budget by */
+	double WorstOverrunMicroseconds = 0.0;
+
+	/**
+	 * @return number of elements processed per millisecond of the ticks
+	 */
+	double GetElementsPerMillisecond() const
+	{
+		return TotalMicroseconds > 0.0 ? NumProcessed * 1000.0 / TotalMicroseconds : 0.0;
+	}
+};
+
+/**
+ * Executes the chain for all the roots of an array over multiple ticks, each limited by a time budget, e.g. to
+ * refresh bindings of thousands of widgets without a hitch. Each tick continues where the previous one stopped.
+ * The budget is checked after batches of elements sized by the measured cost of an element, so a tick can exceed
+ * it by about a batch.
+ * @tparam RootType type of the roots the chain starts from
+ * @tparam ResultType type of the object at the end of the chain
+ */
+template<typename RootType, typename ResultType>
+class TOptionalPtrTimeSlicer
+{
+public:
+	/**
+	 * @param chain chain to execute, has to outlive the slicer
+	 * @param roots roots to execute the chain for, has to outlive the slicer, can be changed between the ticks, dirty
+	 * elements removed from it are dropped
+	 * @param prioritize_dirty whether dirty elements are processed before the rest of the pass or after it
+	 */
+	TOptionalPtrTimeSlicer(const TOptionalPtrChain<RootType, ResultType>& chain, const TArray<RootType*>& roots, bool prioritize_dirty = true) :
+		m_chain{chain}, m_roots{roots}, m_prioritize_dirty{prioritize_dirty}, m_num_roots{roots.Num()} {}
+
+	/**
+	 * @brief Processes elements of the pass and the dirty elements until the budget runs out
+	 * @tparam FuncType type of callable taking index of the element and TOptionalPtr<ResultType> (auto-deduced)
+	 * @param budget_us time budget of the tick in microseconds
+	 * @param func callable receiving the result of the chain for each processed element
+	 * @return true if the pass is finished and there are no dirty elements left, false otherwise
+	 */
+	template<typename FuncType>
+	bool Tick(double budget_us, FuncType&& func)
+	{
+		DropRemovedDirty();
+		if (IsDone())
+			return true;
+
+		const double seconds_per_cycle = FPlatformTime::GetSecondsPerCycle64();
+		const uint64 budget = static_cast<uint64>(budget_us * 1e-6 / seconds_per_cycle);
+		const uint64 start = FPlatformTime::Cycles64();
+		uint64 elapsed = 0;
+		int32 num_processed = 0;
+		do
+		{
+			for (int32 i = 0; i < m_batch_size && !IsDone(); ++i)
+			{
+				const int32 index = NextIndex();
+				func(index, m_chain.Execute(m_roots[index]));
+				++num_processed;
+			}
+			elapsed = FPlatformTime::Cycles64() - start;
+		}
+		while (elapsed < budget && !IsDone());
+
+		//the next batches are sized to check the clock about BatchesPerTick times per budget
+		const double cycles_per_element = static_cast<double>(elapsed) / num_processed;
+		m_batch_size = FMath::Clamp(static_cast<int32>(budget / BatchesPerTick / FMath::Max(cycles_per_element, 1.0)), 1, MaxBatchSize);
+
+		const double elapsed_us = elapsed * seconds_per_cycle * 1e6;
+		m_stats.NumProcessed += num_processed;
+		++m_stats.NumTicks;
+		m_stats.TotalMicroseconds += elapsed_us;
+		m_stats.WorstOverrunMicroseconds = FMath::Max(m_stats.WorstOverrunMicroseconds, elapsed_us - budget_us);
+		return IsDone();
+	}
+
+	/**
+	 * @brief Queues the element to be processed again, before the rest of the pass if dirty elements are prioritized
+	 * @param index index of the element
+	 */
+	void MarkDirty(int32 index)
+	{
+		checkf(m_roots.IsValidIndex(index), TEXT("Index of the dirty element is out of bounds."));
+		DropRemovedDirty();
+		//the pass hasn't reached the element yet, so it doesn't have to be queued unless it's prioritized
+		if (!m_prioritize_dirty && index >= m_cursor)
+			return;
+
+		if (m_is_dirty.Num() <= index)
+		{
+			m_is_dirty.SetNumZeroed(m_roots.Num());
+		}
+		if (!m_is_dirty[index])
+		{
+			m_is_dirty[index] = true;
+			m_dirty.Add(index);
+		}
+	}
+
+	/**
+	 * @brief Starts a new pass over all the elements, the dirty elements stay queued
+	 */
+	void Restart()
+	{
+		m_cursor = 0;
+	}
+
+	/**
+	 * @return true if the pass is finished and there are no dirty elements left, false otherwise
+	 */
+	bool IsDone() const
+	{
+		return m_cursor >= m_roots.Num() && m_dirty_cursor >= m_dirty.Num();
+	}
+
+	/**
+	 * @return ratio of the elements processed by the current pass, in range [0, 1]
+	 */
+	float GetProgress() const
+	{
+		return m_roots.Num() > 0 ? FMath::Min(1.f, static_cast<float>(m_cursor) / m_roots.Num()) : 1.f;
+	}
+
+	/**
+	 * @return statistics of all the ticks so far
+	 */
+	const FOptionalPtrTimeSliceStats& GetStats() const
+	{
+		return m_stats;
+	}
+
+private:
+	static constexpr uint64 BatchesPerTick = 16;
+	static constexpr int32 MaxBatchSize = 4096;
+
+	const TOptionalPtrChain<RootType, ResultType>& m_chain;
+	const TArray<RootType*>& m_roots;
+	bool m_prioritize_dirty;
+	//number of the roots the dirty elements were checked against
+	int32 m_num_roots;
+	int32 m_cursor = 0;
+	int32 m_batch_size = 1;
+	//dirty elements in the order they were marked, processed from m_dirty_cursor
+	TArray<int32> m_dirty;
+	int32 m_dirty_cursor = 0;
+	TArray<bool> m_is_dirty;
+	FOptionalPtrTimeSliceStats m_stats;
+
+	void DropRemovedDirty()
+	{
+		const int32 num_roots = m_roots.Num();
+		if (num_roots >= m_num_roots)
+		{
+			m_num_roots = num_roots;
+			return;
+		}
+
+		m_num_roots = num_roots;
+		int32 num_kept = 0;
+		for (int32 i = m_dirty_cursor; i < m_dirty.Num(); ++i)
+		{
+			const int32 index = m_dirty[i];
+			if (index < num_roots)
+			{
+				m_dirty[num_kept++] = index;
+			}
+			else
+			{
+				m_is_dirty[index] = false;
+			}
+		}
+		m_dirty.SetNum(num_kept);
+		m_dirty_cursor = 0;
+	}
+
+	int32 NextIndex()
+	{
+		const bool dirty = m_dirty_cursor < m_dirty.Num() && (m_prioritize_dirty || m_cursor >= m_roots.Num());
+		if (!dirty)
+			return m_cursor++;
+
+		const int32 index = m_dirty[m_dirty_cursor++];
+		m_is_dirty[index] = false;
+		if (m_dirty_cursor == m_dirty.Num())
+		{
+			m_dirty.Reset();
+			m_dirty_cursor = 0;
+		}
+		return index;
+	}
+};
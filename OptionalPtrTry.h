@@ -0,0 +1,49 @@
+#pragma once
+
+#include <type_traits>
+
+#include "CoreMinimal.h"
+#include "OptionalPtr.h"
+
+
+/**
+ * @brief Unwraps the result of TOptionalPtr chain for OPT_TRY
+ * @param obj wrapped object
+ * @return wrapped object if set, nullptr otherwise
+ */
+template<typename ObjectType, typename PolicyType>
+FORCEINLINE ObjectType* GetValidOptionalPtr(TOptionalPtr<ObjectType, PolicyType> obj)
+{
+	return obj.IsSet() ? obj.Get() : nullptr;
+}
+
+/**
+ * @brief Resolves pointer for OPT_TRY, validated the same way as by TOptionalPtr
+ * @param ptr raw pointer or any pointer supported by TOptionalPtrResolver, e.g. TWeakObjectPtr
+ * @return resolved object if valid, nullptr otherwise
+ */
+template<typename PointerType, typename Resolver = TOptionalPtrResolver<PointerType>>
+FORCEINLINE typename Resolver::ObjectType* GetValidOptionalPtr(const PointerType& ptr
+	OPTIONAL_PTR_STATS_ONLY(, const FOptionalPtrSourceLocation& location = FOptionalPtrSourceLocation::current()))
+{
+	using PolicyType = std::conditional_t<Resolver::bValidated, TOptionalPtrResolvedPolicy<>, FOptionalPtrDefaultPolicy>;
+	return GetValidOptionalPtr(TOptionalPtr<typename Resolver::ObjectType, PolicyType>(Resolver::Resolve(ptr) OPTIONAL_PTR_STATS_ONLY(, location)));
+}
+
+/**
+ * Declares Var initialized by the object Expr evaluates to, i.e. pointer or TOptionalPtr, and returns Fallback from
+ * the enclosing function if the object is not valid. Leave Fallback empty in functions returning void.
+ *
+ * OPT_TRY_OR(Controller, World->GetFirstPlayerController(), false);
+ */
+#define OPT_TRY_OR(Var, Expr, Fallback) \
+	auto* Var = GetValidOptionalPtr(Expr); \
+	if (Var == nullptr) \
+		return Fallback
+
+/**
+ * Same as OPT_TRY_OR returning nullptr, for functions returning pointer or TOptionalPtr.
+ *
+ * OPT_TRY(Pawn, TOptionalPtr<UWorld>(World).Map(&UWorld::GetFirstPlayerController).Map(&APlayerController::GetPawn));
+ */
+#define OPT_TRY(Var, Expr) OPT_TRY_OR(Var, Expr, nullptr)